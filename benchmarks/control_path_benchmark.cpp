@@ -0,0 +1,461 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+/**
+ * Measures the control path from a host parameter change to the SSR without
+ * a SSR and without a DAW.
+ *
+ * Usage: control_path_benchmark [sources] [rate_in_hz] [seconds] [port]
+ *
+ * An in-process stand-in for the SSR listens on 127.0.0.1:port (4711 by
+ * default), sends a scene dump of the requested number of sources and
+ * receives the '\0' separated requests. The client is a headless Controller,
+ * created as a host would do it, with a config written to a temporary
+ * directory which SSREMOTE_VST is pointed at. Its timer runs on the message
+ * loop of the main thread. Once the dump is read, every source is bound to a
+ * slot and a second thread, standing in for the audio thread of the host,
+ * calls Controller::setParameter with a new X position of every slot
+ * rate_in_hz times a second, as a host would do when replaying automation.
+ *
+ * So the measured path is the one of the plug-in: Host_parameters, the send
+ * rate limiter (100 Hz and the default deadband), the Network_thread and the
+ * TCP_connection. The reported latency is the time from the parameter change
+ * until the stand-in has read the request carrying it; values held back by
+ * the rate limiter are sent by the timer and count with their waiting time.
+ * Changes which were suppressed or superseded before being sent are no
+ * latency samples. The CPU time is the time of the whole process (client and
+ * stand-in) divided by the number of requests.
+ */
+
+//C++ Libs
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+
+//Own Libs
+#include <src/controller.h>
+#include <src/parameter/parameter_bank.h>
+#include <src/scene/parameter_translation_functions.h>
+#include <src/utils/metrics.h>
+
+//JUCE Lib
+#include <JUCE/JuceHeader.h>
+
+namespace
+{
+
+  typedef std::chrono::steady_clock Benchmark_clock;
+
+  /**
+   * The number of distinct X positions an automation lane cycles through,
+   * the stand-in maps a received position back to its step.
+   */
+  const unsigned int step_count = 1000;
+
+  /**
+   * The scene range of the Controller.
+   */
+  const float scene_range = 20.0f;
+
+  long long now_in_nsec()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Benchmark_clock::now().time_since_epoch()).count();
+  }
+
+  double cpu_seconds()
+  {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+  }
+
+  /**
+   * The time every step of every source was changed, written by the
+   * automation loop and read by the stand-in.
+   */
+  class Change_log
+  {
+
+  public:
+
+    explicit Change_log(const unsigned int source_count)
+    : times(new std::atomic<long long>[source_count * step_count])
+    , source_count(source_count)
+    {
+      for (unsigned int index = 0; index < source_count * step_count; index++) {
+          times[index] = 0;
+      }
+    }
+
+    void record(const unsigned int source_id, const unsigned int step, const long long time_in_nsec)
+    {
+      times[(source_id - 1) * step_count + step].store(time_in_nsec, std::memory_order_release);
+    }
+
+    long long look_up(const unsigned int source_id, const unsigned int step) const
+    {
+      if (source_id == 0 || source_id > source_count || step >= step_count) {
+          return 0;
+      }
+
+      return times[(source_id - 1) * step_count + step].load(std::memory_order_acquire);
+    }
+
+  private:
+
+    std::unique_ptr<std::atomic<long long>[]> times;
+
+    const unsigned int source_count;
+
+  };
+
+  /**
+   * Stand-in for the SSR speaking its TCP protocol on the loopback device.
+   */
+  class Mock_ssr : public juce::Thread
+  {
+
+  public:
+
+    Mock_ssr(const int port, const unsigned int source_count, const Change_log& change_log)
+    : juce::Thread("Mock SSR")
+    , received_bytes(0)
+    , received_messages(0)
+    , received_records(0)
+    , unmatched_records(0)
+    , port(port)
+    , source_count(source_count)
+    , change_log(change_log)
+    , listener()
+    , latencies_in_nsec()
+    {
+      latencies_in_nsec.reserve(1 << 20);
+    }
+
+    ~Mock_ssr()
+    {
+      signalThreadShouldExit();
+      listener.close();
+      stopThread(2000);
+    }
+
+    bool listen()
+    {
+      return listener.createListener(port, "127.0.0.1");
+    }
+
+    void run() override
+    {
+      std::unique_ptr<juce::StreamingSocket> client(listener.waitForNextConnection());
+
+      if (client == nullptr) {
+          return;
+      }
+
+      const std::string dump = scene_dump();
+      client->write(dump.c_str(), static_cast<int>(dump.size() + 1));
+
+      std::vector<char> buffer(1 << 16);
+      std::string pending;
+
+      while (!threadShouldExit()) {
+
+          if (client->waitUntilReady(true, 50) != 1) {
+              continue;
+          }
+
+          const int read = client->read(buffer.data(), static_cast<int>(buffer.size()), false);
+
+          if (read <= 0) {
+              break;
+          }
+
+          const long long received_in_nsec = now_in_nsec();
+          received_bytes += read;
+          pending.append(buffer.data(), read);
+
+          std::size_t begin = 0;
+          std::size_t end = 0;
+
+          while ((end = pending.find('\0', begin)) != std::string::npos) {
+              receive(pending.data() + begin, received_in_nsec);
+              received_messages++;
+              begin = end + 1;
+          }
+
+          pending.erase(0, begin);
+      }
+    }
+
+    /**
+     * Only valid after the thread stopped.
+     */
+    std::vector<long long>& get_latencies()
+    {
+      return latencies_in_nsec;
+    }
+
+    std::atomic<unsigned long long> received_bytes;
+
+    std::atomic<unsigned long> received_messages;
+
+    std::atomic<unsigned long> received_records;
+
+    std::atomic<unsigned long> unmatched_records;
+
+  private:
+
+    std::string scene_dump() const
+    {
+      std::ostringstream dump;
+      dump << "<update>";
+
+      for (unsigned int id = 1; id <= source_count; id++) {
+          dump << "<source id='" << id << "' name='Source " << id << "' model='point' mute='false' volume='0'>"
+               << "<position x='0' y='0' fixed='false'/><port>system:capture_" << id << "</port></source>";
+      }
+
+      dump << "</update>";
+
+      return dump.str();
+    }
+
+    /**
+     * Matches every position of the request with the change it carries.
+     */
+    void receive(const char* message, const long long received_in_nsec)
+    {
+      static const char source_tag[] = "<source id=\"";
+      static const char x_attribute[] = "x=\"";
+
+      const char* record = message;
+
+      while ((record = std::strstr(record, source_tag)) != nullptr) {
+
+          record += sizeof(source_tag) - 1;
+          const unsigned int source_id = static_cast<unsigned int>(std::strtoul(record, nullptr, 10));
+          const char* next_record = std::strstr(record, source_tag);
+          const char* x = std::strstr(record, x_attribute);
+
+          if (x == nullptr || (next_record != nullptr && x > next_record)) {
+              continue;
+          }
+
+          received_records++;
+
+          const float x_position = std::strtof(x + sizeof(x_attribute) - 1, nullptr);
+          const float continuous = SSR::translations::X_position::to_continuous(x_position, scene_range);
+          const unsigned int step = static_cast<unsigned int>(std::lround(continuous * (step_count - 1)));
+          const long long changed_in_nsec = change_log.look_up(source_id, step);
+
+          if (changed_in_nsec == 0) {
+              unmatched_records++;
+          } else {
+              latencies_in_nsec.push_back(received_in_nsec - changed_in_nsec);
+          }
+      }
+    }
+
+    const int port;
+
+    const unsigned int source_count;
+
+    const Change_log& change_log;
+
+    juce::StreamingSocket listener;
+
+    std::vector<long long> latencies_in_nsec;
+
+  };
+
+  /**
+   * Writes a config connecting to the stand-in and points SSREMOTE_VST at
+   * it, so the Controller finds it.
+   */
+  bool write_config(const int port)
+  {
+    const juce::File directory = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("ssremote_control_path_benchmark");
+
+    if (!directory.createDirectory()) {
+        return false;
+    }
+
+    std::ostringstream config;
+    config << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+           << "<config><network><host>127.0.0.1</host><port>" << port << "</port><timeout>1000</timeout>"
+           << "<max_update_rate>100</max_update_rate></network></config>\n";
+
+    if (!directory.getChildFile("ssremote_config.xml").replaceWithText(config.str())) {
+        return false;
+    }
+
+    return setenv("SSREMOTE_VST", directory.getFullPathName().toRawUTF8(), 1) == 0;
+  }
+
+  double percentile_in_usec(const std::vector<long long>& sorted, const double fraction)
+  {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+
+    const std::size_t index = std::min(sorted.size() - 1, static_cast<std::size_t>(fraction * sorted.size()));
+
+    return sorted[index] / 1e3;
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  const unsigned int source_count = (argc > 1) ? static_cast<unsigned int>(std::atoi(argv[1])) : 32;
+  const unsigned int rate_in_hz = (argc > 2) ? static_cast<unsigned int>(std::atoi(argv[2])) : 100;
+  const double seconds = (argc > 3) ? std::atof(argv[3]) : 10.0;
+  const int port = (argc > 4) ? std::atoi(argv[4]) : 4711;
+
+  if (source_count == 0 || source_count > SSR::Parameter_bank::slot_count || rate_in_hz == 0 || seconds <= 0.0) {
+      std::fprintf(stderr, "usage: %s [sources 1..%zu] [rate_in_hz] [seconds] [port]\n", argv[0], SSR::Parameter_bank::slot_count);
+      return 1;
+  }
+
+  juce::ScopedJuceInitialiser_GUI juce_initialiser;
+  juce::MessageManager* message_manager = juce::MessageManager::getInstance();
+
+  if (!write_config(port)) {
+      std::fprintf(stderr, "cannot write the config\n");
+      return 1;
+  }
+
+  Change_log change_log(source_count);
+  Mock_ssr mock_ssr(port, source_count, change_log);
+
+  if (!mock_ssr.listen()) {
+      std::fprintf(stderr, "cannot listen on 127.0.0.1:%d\n", port);
+      return 1;
+  }
+
+  mock_ssr.startThread();
+
+  std::unique_ptr<Controller> controller(new Controller());
+
+  // The timer of the Controller reads the scene dump.
+  const auto connect_deadline = Benchmark_clock::now() + std::chrono::seconds(5);
+
+  while ((controller->get_connection_state() != SSR::Connection_state::live || controller->get_source_ids_and_names()->size() < source_count)
+         && Benchmark_clock::now() < connect_deadline) {
+      message_manager->runDispatchLoopUntil(10);
+  }
+
+  std::shared_ptr< std::vector< std::pair<unsigned int, std::string> > > ids_and_names = controller->get_source_ids_and_names();
+
+  if (controller->get_connection_state() != SSR::Connection_state::live || ids_and_names->size() < source_count) {
+      std::fprintf(stderr, "no connection to the stand-in\n");
+      return 1;
+  }
+
+  std::vector<unsigned int> source_ids;
+
+  for (unsigned int slot = 0; slot < source_count; slot++) {
+      source_ids.push_back((*ids_and_names)[slot].first);
+      controller->bind_slot_to_source(slot, source_ids.back());
+  }
+
+  std::printf("%u sources x %u Hz for %.1f s on 127.0.0.1:%d\n", source_count, rate_in_hz, seconds, port);
+
+  const SSR::Parameter_bank parameter_bank;
+  const unsigned long pass_count = static_cast<unsigned long>(seconds * rate_in_hz);
+  const auto pass_interval = std::chrono::nanoseconds(1000000000LL / rate_in_hz);
+  std::atomic<bool> automation_done(false);
+  unsigned long changes = 0;
+
+  const double cpu_before = cpu_seconds();
+  const auto start = Benchmark_clock::now();
+
+  // The host calls setParameter on its audio thread.
+  std::thread automation([&]() {
+    for (unsigned long pass = 0; pass < pass_count; pass++) {
+
+        std::this_thread::sleep_until(start + pass * pass_interval);
+
+        const unsigned int step = static_cast<unsigned int>(pass % step_count);
+        const float continuous = static_cast<float>(step) / (step_count - 1);
+
+        for (unsigned int slot = 0; slot < source_count; slot++) {
+            change_log.record(source_ids[slot], step, now_in_nsec());
+            controller->setParameter(parameter_bank.get_index(slot, SSR::Source::x_position_idx), continuous);
+            changes++;
+        }
+
+    }
+
+    automation_done = true;
+  });
+
+  while (!automation_done) {
+      message_manager->runDispatchLoopUntil(10);
+  }
+
+  automation.join();
+
+  // Give the held back values and the last requests time to arrive.
+  message_manager->runDispatchLoopUntil(200);
+
+  const double elapsed = std::chrono::duration<double>(Benchmark_clock::now() - start).count();
+  const double cpu = cpu_seconds() - cpu_before;
+
+  const SSR::Metrics& metrics = SSR::Metrics::get_instance();
+  const unsigned long suppressed_by_rate = controller->get_updates_suppressed_by_rate();
+  const unsigned long suppressed_by_deadband = controller->get_updates_suppressed_by_deadband();
+  const std::string probe_report = controller->get_latency_probe().get_report();
+
+  controller = nullptr;
+  mock_ssr.stopThread(2000);
+
+  std::vector<long long>& latencies = mock_ssr.get_latencies();
+  std::sort(latencies.begin(), latencies.end());
+
+  const unsigned long messages = mock_ssr.received_messages;
+  const unsigned long records = mock_ssr.received_records;
+  const unsigned long long bytes = mock_ssr.received_bytes;
+
+  std::printf("changes   %10lu (%.0f/s), %llu sent from the host, suppressed %lu by rate and %lu by deadband\n",
+              changes, changes / elapsed, metrics.get(SSR::Metrics::outbound_updates), suppressed_by_rate, suppressed_by_deadband);
+  std::printf("          dropped %llu, coalesced %llu\n", metrics.get(SSR::Metrics::dropped_updates), metrics.get(SSR::Metrics::coalesced_updates));
+  std::printf("requests  %10lu (%.0f/s), %lu positions, %lu unmatched\n", messages, messages / elapsed, records, static_cast<unsigned long>(mock_ssr.unmatched_records));
+  std::printf("latency   p50 %.1f us, p99 %.1f us, p999 %.1f us, max %.1f us\n",
+              percentile_in_usec(latencies, 0.5),
+              percentile_in_usec(latencies, 0.99),
+              percentile_in_usec(latencies, 0.999),
+              latencies.empty() ? 0.0 : latencies.back() / 1e3);
+  std::printf("bytes     %.1f per position, %.1f per request\n",
+              records ? static_cast<double>(bytes) / records : 0.0,
+              messages ? static_cast<double>(bytes) / messages : 0.0);
+  std::printf("cpu       %.2f us per request, %.2f us per change (%.1f%% of one core)\n",
+              messages ? cpu * 1e6 / messages : 0.0,
+              changes ? cpu * 1e6 / changes : 0.0,
+              cpu * 100.0 / elapsed);
+  std::printf("\nlatency probe of the network thread\n%s", probe_report.c_str());
+  std::printf("\nmetrics\n%s", metrics.get_text().c_str());
+
+  return 0;
+}
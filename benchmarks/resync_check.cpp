@@ -0,0 +1,413 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+/**
+ * Checks that changes made while the SSR is unreachable survive the resync.
+ *
+ * Usage: resync_check [port]
+ *
+ * Build and run it with:
+ *
+ *   make resync-check
+ *
+ * An in-process stand-in for the SSR listens on 127.0.0.1:port (4712 by
+ * default), sends its scene on every connection, applies the received
+ * positions to its scene and echoes them back as the SSR does. The client is
+ * the chain the Controller uses: Scene, Network_thread and TCP_connection.
+ *
+ * 1. The client connects and takes over the scene of the stand-in (sources
+ *    1 and 2 at the origin).
+ * 2. The stand-in goes away. While it is unreachable, source 1 is moved in
+ *    the local scene, and source 2 is deleted on the stand-in (as another
+ *    client would do).
+ * 3. The stand-in comes back and sends its (older) scene again, followed
+ *    by a scene volume update every millisecond, so the client never sees a
+ *    quiet poll (as with other clients automating the scene).
+ *
+ * Afterwards both sides have to agree: source 1 at the position set offline
+ * and no source 2. The exit code is 0 if they do, 1 otherwise.
+ */
+
+//C++ Libs
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//Own Libs
+#include <src/scene/scene.h>
+#include <src/utils/network_thread.h>
+#include <src/utils/tcp_connection.h>
+
+//JUCE Lib
+#include <JUCE/JuceHeader.h>
+
+namespace
+{
+
+  typedef std::chrono::steady_clock Check_clock;
+
+  const float scene_range = 10.0f;
+
+  const float offline_x = 1.5f;
+
+  const float offline_y = -2.0f;
+
+  /**
+   * Stand-in for the SSR serving one connection per run.
+   */
+  class Mock_ssr : public juce::Thread
+  {
+
+  public:
+
+    explicit Mock_ssr(const int port)
+    : juce::Thread("Mock SSR")
+    , port(port)
+    , chatty(false)
+    , listener()
+    , lock()
+    , positions()
+    {
+      positions[1] = std::make_pair(0.0f, 0.0f);
+      positions[2] = std::make_pair(0.0f, 0.0f);
+    }
+
+    ~Mock_ssr()
+    {
+      go_away();
+    }
+
+    bool listen()
+    {
+      return listener.createListener(port, "127.0.0.1");
+    }
+
+    /**
+     * Closes the listener and the current connection, connecting fails from
+     * now on.
+     */
+    void go_away()
+    {
+      signalThreadShouldExit();
+      listener.close();
+      stopThread(2000);
+    }
+
+    /**
+     * Makes the stand-in send a scene volume update every millisecond.
+     */
+    void set_chatty(const bool chatty)
+    {
+      this->chatty = chatty;
+    }
+
+    void delete_source(const unsigned int id)
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      positions.erase(id);
+    }
+
+    bool get_position(const unsigned int id, float& x, float& y)
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      auto found = positions.find(id);
+
+      if (found == positions.end()) {
+          return false;
+      }
+
+      x = found->second.first;
+      y = found->second.second;
+
+      return true;
+    }
+
+    void run() override
+    {
+      std::unique_ptr<juce::StreamingSocket> client(listener.waitForNextConnection());
+
+      if (client == nullptr) {
+          return;
+      }
+
+      send(*client, scene_dump());
+
+      std::vector<char> buffer(1 << 16);
+      std::string pending;
+
+      while (!threadShouldExit()) {
+
+          if (chatty) {
+              send(*client, "<update><scene volume='0'/></update>");
+          }
+
+          if (client->waitUntilReady(true, chatty ? 1 : 20) != 1) {
+              continue;
+          }
+
+          const int read = client->read(buffer.data(), static_cast<int>(buffer.size()), false);
+
+          if (read <= 0) {
+              break;
+          }
+
+          pending.append(buffer.data(), read);
+
+          std::size_t begin = 0;
+          std::size_t end = 0;
+
+          while ((end = pending.find('\0', begin)) != std::string::npos) {
+              receive(*client, pending.data() + begin);
+              begin = end + 1;
+          }
+
+          pending.erase(0, begin);
+      }
+    }
+
+  private:
+
+    static void send(juce::StreamingSocket& client, const std::string& message)
+    {
+      client.write(message.c_str(), static_cast<int>(message.size() + 1));
+    }
+
+    std::string scene_dump()
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      std::ostringstream dump;
+      dump << "<update>";
+
+      for (const auto& source : positions) {
+          dump << "<source id='" << source.first << "' name='Source " << source.first << "' model='point' mute='false' volume='0'>"
+               << "<position x='" << source.second.first << "' y='" << source.second.second << "' fixed='false'/>"
+               << "<port>system:capture_" << source.first << "</port></source>";
+      }
+
+      dump << "</update>";
+
+      return dump.str();
+    }
+
+    /**
+     * Applies the positions of the request and echoes them back.
+     */
+    void receive(juce::StreamingSocket& client, const char* message)
+    {
+      static const char source_tag[] = "<source id=\"";
+      static const char x_attribute[] = "x=\"";
+      static const char y_attribute[] = "y=\"";
+
+      const char* record = message;
+
+      while ((record = std::strstr(record, source_tag)) != nullptr) {
+
+          record += sizeof(source_tag) - 1;
+          const unsigned int id = static_cast<unsigned int>(std::strtoul(record, nullptr, 10));
+          const char* next_record = std::strstr(record, source_tag);
+          const char* x = std::strstr(record, x_attribute);
+          const char* y = std::strstr(record, y_attribute);
+
+          if (x == nullptr || y == nullptr || (next_record != nullptr && (x > next_record || y > next_record))) {
+              continue;
+          }
+
+          const float x_position = std::strtof(x + sizeof(x_attribute) - 1, nullptr);
+          const float y_position = std::strtof(y + sizeof(y_attribute) - 1, nullptr);
+
+          {
+            std::lock_guard<std::mutex> guard(lock);
+
+            if (positions.find(id) == positions.end()) {
+                continue;
+            }
+
+            positions[id] = std::make_pair(x_position, y_position);
+          }
+
+          std::ostringstream echo;
+          echo << "<update><source id='" << id << "'><position x='" << x_position << "' y='" << y_position << "'/></source></update>";
+          send(client, echo.str());
+      }
+    }
+
+    const int port;
+
+    std::atomic<bool> chatty;
+
+    juce::StreamingSocket listener;
+
+    std::mutex lock;
+
+    std::map<unsigned int, std::pair<float, float> > positions;
+
+  };
+
+  /**
+   * Applies the records the network thread received, as
+   * Controller::read_ssr_incoming_message does.
+   */
+  void read_incoming(SSR::Network_thread& network_thread, SSR::Scene& scene, SSR::Inbound_coalescer& inbound_updates)
+  {
+    if (!network_thread.take_updates(inbound_updates)) {
+        return;
+    }
+
+    if (inbound_updates.is_sync_finished()) {
+        scene.retain_sources(inbound_updates.get_synced_source_ids());
+    }
+
+    scene.apply_updates(inbound_updates.get_updates(), inbound_updates.get_texts());
+  }
+
+  /**
+   * Keeps applying incoming records until the condition holds or the
+   * timeout elapsed.
+   */
+  bool wait_for(SSR::Network_thread& network_thread, SSR::Scene& scene, SSR::Inbound_coalescer& inbound_updates,
+                const std::function<bool()>& condition, const int timeout_in_msec)
+  {
+    const auto deadline = Check_clock::now() + std::chrono::milliseconds(timeout_in_msec);
+
+    while (Check_clock::now() < deadline) {
+
+        read_incoming(network_thread, scene, inbound_updates);
+
+        if (condition()) {
+            return true;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return false;
+  }
+
+  bool check(const bool passed, const char* what)
+  {
+    std::printf("%s  %s\n", passed ? "ok  " : "FAIL", what);
+    return passed;
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  const int port = (argc > 1) ? std::atoi(argv[1]) : 4712;
+
+  Mock_ssr mock_ssr(port);
+
+  if (!mock_ssr.listen()) {
+      std::fprintf(stderr, "cannot listen on 127.0.0.1:%d\n", port);
+      return 1;
+  }
+
+  mock_ssr.startThread();
+
+  SSR::Scene scene(scene_range);
+  SSR::Inbound_coalescer inbound_updates;
+  std::unique_ptr<SSR::Network_thread> network_thread(new SSR::Network_thread());
+
+  network_thread->set_connection(std::unique_ptr<SSR::IConnection>(new SSR::TCP_connection("127.0.0.1", port, 1000, '\0')));
+
+  SSR::Network_thread& client = *network_thread;
+
+  const bool connected = wait_for(client, scene, inbound_updates, [&client, &scene]() {
+    return client.get_state() == SSR::Connection_state::live && scene.get_source(1) != nullptr && scene.get_source(2) != nullptr;
+  }, 5000);
+
+  if (!check(connected, "took over the scene of the stand-in")) {
+      return 1;
+  }
+
+  // 2. The stand-in goes away, the client notices and keeps reconnecting.
+  mock_ssr.go_away();
+
+  const bool offline = wait_for(client, scene, inbound_updates, [&client]() {
+    return client.get_state() != SSR::Connection_state::live && client.get_state() != SSR::Connection_state::syncing;
+  }, 5000);
+
+  if (!check(offline, "noticed that the stand-in went away")) {
+      return 1;
+  }
+
+  // Controller::setParameter and Controller::update_ssr_of_source
+  scene.set_position_of_source(1, offline_x, offline_y);
+
+  SSR::Outbound_update update;
+  update.changed = SSR::Update_specificator(SSR::Update_specificator::position);
+  update.source_id = 1;
+  update.x_position = offline_x;
+  update.y_position = offline_y;
+  client.push_update(update);
+
+  mock_ssr.delete_source(2);
+
+  // 3. The stand-in comes back with its older scene and keeps sending.
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  mock_ssr.set_chatty(true);
+
+  if (!mock_ssr.listen()) {
+      std::fprintf(stderr, "cannot listen on 127.0.0.1:%d again\n", port);
+      return 1;
+  }
+
+  mock_ssr.startThread();
+
+  const bool resynced = wait_for(client, scene, inbound_updates, [&client]() {
+    return client.get_state() == SSR::Connection_state::live;
+  }, 5000);
+
+  if (!check(resynced, "resynchronised with the stand-in")) {
+      return 1;
+  }
+
+  float ssr_x = 0.0f;
+  float ssr_y = 0.0f;
+
+  // The offline change is flushed and echoed after the sync.
+  wait_for(client, scene, inbound_updates, [&mock_ssr, &ssr_x, &ssr_y]() {
+    return mock_ssr.get_position(1, ssr_x, ssr_y) && ssr_x == offline_x && ssr_y == offline_y;
+  }, 2000);
+
+  // Let the echo arrive and be applied, if it were.
+  wait_for(client, scene, inbound_updates, []() { return false; }, 200);
+
+  network_thread.reset();
+  mock_ssr.go_away();
+
+  const SSR::Source* local = scene.get_source(1);
+  const float local_x = (local != nullptr) ? local->get_x_position().get_discrete_value() : 0.0f;
+  const float local_y = (local != nullptr) ? local->get_y_position().get_discrete_value() : 0.0f;
+
+  std::printf("source 1: local (%g, %g), SSR (%g, %g)\n", local_x, local_y, ssr_x, ssr_y);
+
+  bool passed = true;
+
+  passed &= check(std::fabs(ssr_x - offline_x) < 1e-4f && std::fabs(ssr_y - offline_y) < 1e-4f, "the SSR has the offline change");
+  passed &= check(std::fabs(local_x - offline_x) < 1e-4f && std::fabs(local_y - offline_y) < 1e-4f, "the local scene kept the offline change");
+  passed &= check(scene.get_source(2) == nullptr, "the source deleted on the SSR is gone locally");
+
+  return passed ? 0 : 1;
+}
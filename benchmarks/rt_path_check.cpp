@@ -0,0 +1,171 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+/**
+ * Drives the Controller headless with synthetic automation and fails if the
+ * real-time path allocated, locked or blocked.
+ *
+ * Usage: rt_path_check [sources] [seconds] [sample_rate] [block_size]
+ *
+ * Build and run it with the real-time guard:
+ *
+ *   make SSR_RT_GUARD=1 rt-check
+ *
+ * The Controller is created as a host would do it, the given number of
+ * sources is created and bound to the automation slots. Every block, each
+ * parameter of the bank gets a new value of a slow sine (one phase per
+ * parameter) and processBlock() runs with a playing play head, so the
+ * trajectory engine is evaluated as well. No SSR is needed, the network
+ * thread keeps reconnecting in the background.
+ *
+ * The guard report with the backtraces is written when the program exits.
+ * The exit code is 0 if no call was recorded inside Controller::setParameter
+ * or Controller::processBlock, 1 otherwise, and 2 if the program was built
+ * without SSR_RT_GUARD.
+ */
+
+//C++ Libs
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+
+//Own Libs
+#include <src/controller.h>
+#include <src/parameter/parameter_bank.h>
+#include <src/utils/rt_guard.h>
+
+//JUCE Lib
+#include <JUCE/JuceHeader.h>
+
+namespace
+{
+
+  /**
+   * A play head which is always playing and advanced by the driver.
+   */
+  class Synthetic_play_head : public juce::AudioPlayHead
+  {
+
+  public:
+
+    explicit Synthetic_play_head(const double sample_rate)
+    : sample_rate(sample_rate)
+    , position_in_samples(0)
+    {
+
+    }
+
+    bool getCurrentPosition(CurrentPositionInfo& result) override
+    {
+      result.resetToDefault();
+      result.isPlaying = true;
+      result.timeInSamples = position_in_samples;
+      result.timeInSeconds = position_in_samples / sample_rate;
+
+      return true;
+    }
+
+    void advance(const int samples)
+    {
+      position_in_samples += samples;
+    }
+
+  private:
+
+    const double sample_rate;
+
+    juce::int64 position_in_samples;
+
+  };
+
+}
+
+int main(int argc, char* argv[])
+{
+  const unsigned int source_count = (argc > 1) ? static_cast<unsigned int>(std::atoi(argv[1])) : 16;
+  const double seconds = (argc > 2) ? std::atof(argv[2]) : 5.0;
+  const double sample_rate = (argc > 3) ? std::atof(argv[3]) : 48000.0;
+  const int block_size = (argc > 4) ? std::atoi(argv[4]) : 256;
+
+  if (source_count == 0 || source_count > SSR::Parameter_bank::slot_count || seconds <= 0.0 || sample_rate <= 0.0 || block_size <= 0) {
+      std::fprintf(stderr, "usage: %s [sources 1..%zu] [seconds] [sample_rate] [block_size]\n", argv[0], SSR::Parameter_bank::slot_count);
+      return 1;
+  }
+
+#ifndef SSR_RT_GUARD
+  std::fprintf(stderr, "%s was built without SSR_RT_GUARD, nothing would be recorded (make SSR_RT_GUARD=1 rt-check)\n", argv[0]);
+  return 2;
+#endif
+
+  juce::ScopedJuceInitialiser_GUI juce_initialiser;
+
+  std::unique_ptr<Controller> controller(new Controller());
+  Synthetic_play_head play_head(sample_rate);
+
+  controller->setPlayHead(&play_head);
+  controller->prepareToPlay(sample_rate, block_size);
+
+  for (unsigned int source = 0; source < source_count; source++) {
+      controller->new_source();
+  }
+
+  std::shared_ptr< std::vector< std::pair<unsigned int, std::string> > > ids_and_names = controller->get_source_ids_and_names();
+
+  for (std::size_t slot = 0; slot < ids_and_names->size() && slot < SSR::Parameter_bank::slot_count; slot++) {
+      controller->bind_slot_to_source(slot, (*ids_and_names)[slot].first);
+  }
+
+  if (!ids_and_names->empty()) {
+      controller->select_source(ids_and_names->front().first);
+  }
+
+  // Everything the blocks need is allocated before the first block.
+  juce::AudioSampleBuffer buffer(2, block_size);
+  juce::MidiBuffer midi_messages;
+  buffer.clear();
+
+  const int parameter_count = controller->getNumParameters();
+  const long block_count = static_cast<long>(seconds * sample_rate / block_size);
+  const auto block_interval = std::chrono::nanoseconds(static_cast<long long>(1e9 * block_size / sample_rate));
+
+  std::printf("%u sources, %d parameters, %ld blocks of %d samples at %.0f Hz\n", source_count, parameter_count, block_count, block_size, sample_rate);
+
+  auto next_block = std::chrono::steady_clock::now();
+
+  for (long block = 0; block < block_count; block++) {
+
+      const double time_in_seconds = block * static_cast<double>(block_size) / sample_rate;
+
+      for (int index = 0; index < parameter_count; index++) {
+          const double phase = 2.0 * M_PI * (0.25 * time_in_seconds + static_cast<double>(index) / parameter_count);
+          controller->setParameter(index, static_cast<float>(0.5 + 0.5 * std::sin(phase)));
+      }
+
+      controller->processBlock(buffer, midi_messages);
+      play_head.advance(block_size);
+
+      next_block += block_interval;
+      std::this_thread::sleep_until(next_block);
+  }
+
+  controller->releaseResources();
+  controller = nullptr;
+
+  const std::size_t violations = SSR::Rt_guard::get_violation_count();
+
+  std::printf("%zu calls inside real-time scopes\n", violations);
+
+  return (violations == 0) ? 0 : 1;
+}
@@ -0,0 +1,318 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+/**
+ * Compares the pull parser (SSR::Update_parser) with the JUCE XmlDocument
+ * DOM path which was used by SSR::Scene before.
+ *
+ * Usage: update_parser_benchmark [capture_file] [rounds]
+ *
+ * The capture file contains the messages of the SSR as received on the TCP
+ * socket, i.e. separated by '\0' (e.g. recorded with
+ * "nc localhost 4711 > capture.bin"). Without capture file a synthetic stream
+ * (initial scene dump of 32 sources followed by position and volume updates)
+ * is used.
+ */
+
+//C++ Libs
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//Own Libs
+#include <src/scene/scene.h>
+#include <src/scene/update_parser.h>
+
+//JUCE Lib
+#include <JUCE/JuceHeader.h>
+
+namespace
+{
+
+  std::atomic<unsigned long> allocation_count(0);
+
+}
+
+void* operator new(std::size_t size)
+{
+  allocation_count++;
+
+  if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+      return memory;
+  }
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+  std::free(memory);
+}
+
+namespace
+{
+
+  typedef std::vector<std::string> Stream;
+
+  Stream load_capture(const char* path)
+  {
+    std::ifstream file(path, std::ios::binary);
+    const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    Stream stream;
+    std::size_t begin = 0;
+
+    for (std::size_t index = 0; index < content.size(); index++) {
+
+        if (content[index] == '\0') {
+
+            if (index > begin) {
+                stream.push_back(content.substr(begin, index - begin));
+            }
+
+            begin = index + 1;
+        }
+
+    }
+
+    return stream;
+  }
+
+  Stream synthetic_stream()
+  {
+    const unsigned int source_count = 32;
+    Stream stream;
+
+    std::ostringstream dump;
+    dump << "<update>";
+
+    for (unsigned int id = 1; id <= source_count; id++) {
+        dump << "<source id='" << id << "' name='Source " << id << " &amp; friends' model='point' mute='false' volume='-"
+             << id % 12 << ".5' properties_file='/usr/share/ssr/prop_" << id << ".xml'>"
+             << "<position x='" << id * 0.125f << "' y='-" << id * 0.25f << "' fixed='false'/>"
+             << "<orientation azimuth='" << id * 11 % 360 << "'/>"
+             << "<port>system:capture_" << id << "</port></source>";
+    }
+
+    dump << "</update>";
+    stream.push_back(dump.str());
+
+    for (unsigned int index = 0; index < 20000; index++) {
+
+        std::ostringstream message;
+        const unsigned int id = index % source_count + 1;
+
+        if (index % 50 == 0) {
+            message << "<update><reference><position x='0' y='0'/><orientation azimuth='90'/></reference></update>";
+        } else if (index % 7 == 0) {
+            message << "<update><source id='" << id << "' volume='-" << index % 40 << ".25'/></update>";
+        } else {
+            message << "<update><source id='" << id << "'><position x='" << (index % 1000) * 0.00123f
+                    << "' y='" << (index % 777) * -0.00456f << "'/></source></update>";
+        }
+
+        stream.push_back(message.str());
+    }
+
+    return stream;
+  }
+
+  /**
+   * The former Scene::manipulate_source working on the DOM.
+   */
+  void apply_element(SSR::Source& source, juce::XmlElement* element)
+  {
+    if (element->hasAttribute("volume")) {
+        source.set_discrete_gain(static_cast<float>(element->getDoubleAttribute("volume")), false);
+    }
+
+    if (element->hasAttribute("name")) {
+        source.set_name(element->getStringAttribute("name").toStdString());
+    }
+
+    if (element->hasAttribute("mute")) {
+        source.set_discrete_mute(element->getBoolAttribute("mute"));
+    }
+
+    if (element->hasAttribute("model")) {
+        source.set_discrete_model_point(element->getStringAttribute("model").toStdString() == "point");
+    }
+
+    if (element->hasAttribute("properties_file")) {
+        source.set_properties_file(element->getStringAttribute("properties_file").toStdString());
+    }
+
+    forEachXmlChildElement(*element, f) {
+
+      if (f->hasTagName("position")) {
+
+          if (f->hasAttribute("x")) {
+              source.set_x_position_discrete(static_cast<float>(f->getDoubleAttribute("x")));
+          }
+
+          if (f->hasAttribute("y")) {
+              source.set_y_position_discrete(static_cast<float>(f->getDoubleAttribute("y")));
+          }
+
+          source.set_discrete_fixed(f->getBoolAttribute("fixed"));
+
+      } else if (f->hasTagName("orientation")) {
+
+          if (f->hasAttribute("azimuth")) {
+              source.set_discrete_orientation(static_cast<float>(f->getDoubleAttribute("azimuth")));
+          }
+
+      } else if (f->hasTagName("port")) {
+          source.set_jackport(f->getAllSubText().toStdString());
+      }
+
+    }
+  }
+
+  /**
+   * The former Scene::interpret_xml_message.
+   */
+  void interpret_with_dom(std::vector<SSR::Source>& sources, const std::string& message)
+  {
+    juce::XmlDocument xml_document(message);
+    std::unique_ptr<juce::XmlElement> main_element(xml_document.getDocumentElement());
+
+    if (main_element == nullptr || !main_element->hasTagName("update")) {
+        return;
+    }
+
+    forEachXmlChildElement(*main_element, e) {
+
+      if (e->hasTagName("source") && e->hasAttribute("id")) {
+
+          const unsigned int id = static_cast<unsigned int>(e->getIntAttribute("id"));
+
+          for (SSR::Source& source : sources) {
+
+              if (source.get_id() == id) {
+                  apply_element(source, e);
+                  break;
+              }
+
+          }
+
+      }
+
+    }
+  }
+
+  struct Measurement
+  {
+    double seconds;
+    unsigned long allocations;
+  };
+
+  template<typename Function>
+  Measurement measure(const Stream& stream, const unsigned int rounds, Function function)
+  {
+    // One warm up round so the reused buffers reach their final size.
+    for (const std::string& message : stream) {
+        function(message);
+    }
+
+    const unsigned long allocations_before = allocation_count;
+    const auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int round = 0; round < rounds; round++) {
+
+        for (const std::string& message : stream) {
+            function(message);
+        }
+
+    }
+
+    const auto stop = std::chrono::steady_clock::now();
+
+    Measurement result;
+    result.seconds = std::chrono::duration<double>(stop - start).count();
+    result.allocations = allocation_count - allocations_before;
+    return result;
+  }
+
+  void print(const char* name, const Measurement& result, const std::size_t messages, const std::size_t bytes)
+  {
+    std::printf("%-22s %10.1f ns/msg %10.1f MB/s %10.2f allocs/msg\n",
+                name,
+                result.seconds * 1e9 / messages,
+                bytes / result.seconds / 1e6,
+                static_cast<double>(result.allocations) / messages);
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  const Stream stream = (argc > 1) ? load_capture(argv[1]) : synthetic_stream();
+  const unsigned int rounds = (argc > 2) ? static_cast<unsigned int>(std::atoi(argv[2])) : 20;
+
+  if (stream.empty() || rounds == 0) {
+      std::fprintf(stderr, "usage: %s [capture_file] [rounds]\n", argv[0]);
+      return 1;
+  }
+
+  std::size_t bytes_per_round = 0;
+
+  for (const std::string& message : stream) {
+      bytes_per_round += message.size();
+  }
+
+  const std::size_t messages = stream.size() * rounds;
+  const std::size_t bytes = bytes_per_round * rounds;
+
+  std::printf("%zu messages, %zu bytes, %u rounds\n", stream.size(), bytes_per_round, rounds);
+
+  // Both scene paths start from the sources the first message creates.
+  SSR::Scene scene(10.0f);
+  scene.interpret_xml_message(stream.front());
+
+  std::vector<SSR::Source> dom_sources;
+
+  for (const auto& id_and_name : *scene.get_source_ids_and_names()) {
+      dom_sources.push_back(SSR::Source(id_and_name.first, id_and_name.second, 10.0f));
+  }
+
+  SSR::Update_parser parser;
+  std::vector<SSR::Source_update> updates;
+  std::size_t parsed_records = 0;
+
+  const Measurement dom = measure(stream, rounds, [&dom_sources](const std::string& message) {
+    interpret_with_dom(dom_sources, message);
+  });
+
+  const Measurement parse_only = measure(stream, rounds, [&parser, &updates, &parsed_records](const std::string& message) {
+    parser.parse(message.data(), message.size(), updates);
+    parsed_records += updates.size();
+  });
+
+  const Measurement pull = measure(stream, rounds, [&scene](const std::string& message) {
+    scene.interpret_xml_message(message.data(), message.size());
+  });
+
+  print("DOM (XmlDocument)", dom, messages, bytes);
+  print("Update_parser only", parse_only, messages, bytes);
+  print("Update_parser + Scene", pull, messages, bytes);
+  std::printf("speedup %.2fx (%zu source records)\n", dom.seconds / pull.seconds, parsed_records);
+
+  return 0;
+}
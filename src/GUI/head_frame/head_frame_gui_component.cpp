@@ -16,6 +16,7 @@
 //Own Libs
 #include <src/GUI/head_frame/head_frame_gui_component.h>
 #include <src/GUI/head_frame/network_gui_component.h>
+#include <src/GUI/head_frame/latency_gui_component.h>
 #include <src/config/ssr_colour.h>
 #include <src/controller.h>
 #include <src/GUI/gui_components_configurator.h>
@@ -23,11 +24,15 @@
 SSR::Head_frame_GUI_component::Head_frame_GUI_component(Controller* controller)
 : AudioProcessorEditor(controller)
 , network_component(new SSR::Network_gui_component(controller))
+, latency_component(new SSR::Latency_gui_component(controller))
 , new_source_button(new juce::TextButton("new_source_button"))
 {
   addAndMakeVisible(*network_component);
   network_component->setBounds(35, 41, network_component->getWidth(), network_component->getHeight());
 
+  addAndMakeVisible(*latency_component);
+  latency_component->setBounds(215, 41, latency_component->getWidth(), latency_component->getHeight());
+
   addAndMakeVisible(*new_source_button);
   new_source_button->setBounds(744, 41, 138, 26);
 
@@ -52,6 +57,12 @@ void SSR::Head_frame_GUI_component::paint(juce::Graphics& graphics)
 
   graphics.setColour(SSR::colour::get_colour(colours::background_grey));
   graphics.fillRoundedRectangle(10, 28, 180, 50, 10.0f);
+
+  graphics.setColour(SSR::colour::get_colour(colours::frame_colour));
+  graphics.drawRoundedRectangle(205, 28, 520, 50, 10.0f, 2.0f);
+
+  graphics.setColour(SSR::colour::get_colour(colours::background_grey));
+  graphics.fillRoundedRectangle(205, 28, 520, 50, 10.0f);
 }
 
 void SSR::Head_frame_GUI_component::buttonClicked(juce::Button* buttonThatWasClicked)
@@ -70,9 +81,9 @@ bool SSR::Head_frame_GUI_component::get_connected() const
   return network_component->get_connected();
 }
 
-void SSR::Head_frame_GUI_component::set_connected(const bool new_state)
+void SSR::Head_frame_GUI_component::set_connection_state(const SSR::Connection_state new_state)
 {
-  network_component->set_connected(new_state);
+  network_component->set_connection_state(new_state);
 }
 
 void SSR::Head_frame_GUI_component::configure_new_source_button()
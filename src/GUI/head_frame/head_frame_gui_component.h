@@ -21,13 +21,15 @@
 
 //Own Libs
 #include <src/GUI/head_frame/network_gui_component.h>
+#include <src/GUI/head_frame/latency_gui_component.h>
 #include <src/controller.h>
 
 namespace SSR
 {
   /**
   * This class represents the head frame GUI component including the
-  * 'Network GUI component' and a 'New Source Button'.
+  * 'Network GUI component', the 'Latency GUI component' and a 'New Source
+  * Button'.
   */
   class Head_frame_GUI_component
   : public juce::AudioProcessorEditor
@@ -36,8 +38,8 @@ namespace SSR
 
   public:
     /**
-     * Constructor instantiates and configures the 'New Source' button and the
-     * 'Network Component'.
+     * Constructor instantiates and configures the 'New Source' button, the
+     * 'Network Component' and the 'Latency Component'.
      *
      * Sets the size of the frame to 900x100 pixels.
      * 
@@ -92,13 +94,11 @@ namespace SSR
     bool get_connected() const;
 
     /**
-     * Sets the network GUI component to show whether its connected or not.
+     * Sets the network GUI component to show the state of the connection.
      *
-     * @param   new_state       The new state on which the network GUI
-     *                          component shall be set: true means connected,
-     *                          false means not.
+     * @param   new_state       The state of the connection to the SSR.
      */
-    void set_connected(const bool new_state);
+    void set_connection_state(const SSR::Connection_state new_state);
 
   private:
 
@@ -113,6 +113,11 @@ namespace SSR
     */
     std::unique_ptr<SSR::Network_gui_component> network_component;
 
+    /**
+    * The latency GUI component.
+    */
+    std::unique_ptr<SSR::Latency_gui_component> latency_component;
+
     /**
     * The new source button.
     */
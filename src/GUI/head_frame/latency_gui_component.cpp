@@ -0,0 +1,116 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//JUCE Lib
+#include <JUCE/JuceHeader.h>
+
+//C++ Libs
+#include <memory>
+#include <sstream>
+#include <string>
+
+//Own Libs
+#include <src/GUI/head_frame/latency_gui_component.h>
+#include <src/GUI/gui_components_configurator.h>
+#include <src/config/ssr_colour.h>
+#include <src/controller.h>
+#include <src/utils/latency_probe.h>
+#include <src/utils/logger.h>
+#include <src/utils/metrics.h>
+
+SSR::Latency_gui_component::Latency_gui_component(Controller* controller)
+: AudioProcessorEditor(controller)
+, plugin_label(new juce::Label("plugin_latency_label"))
+, network_label(new juce::Label("network_latency_label"))
+, ssr_label(new juce::Label("ssr_latency_label"))
+, report_button(new juce::TextButton("latency_report_button"))
+{
+  addAndMakeVisible(*plugin_label);
+  plugin_label->setBounds(0, 0, 140, 26);
+
+  addAndMakeVisible(*network_label);
+  network_label->setBounds(140, 0, 140, 26);
+
+  addAndMakeVisible(*ssr_label);
+  ssr_label->setBounds(280, 0, 140, 26);
+
+  addAndMakeVisible(*report_button);
+  report_button->setBounds(425, 0, 75, 25);
+
+  configure_stage_label(*plugin_label);
+  configure_stage_label(*network_label);
+  configure_stage_label(*ssr_label);
+
+  SSR::configure_text_button(*report_button, "Report");
+  report_button->addListener(this);
+
+  setSize(500, 26);
+
+  timerCallback();
+  startTimer(refresh_interval_in_msec);
+}
+
+SSR::Latency_gui_component::~Latency_gui_component()
+{
+  stopTimer();
+  removeAllChildren();
+}
+
+void SSR::Latency_gui_component::buttonClicked(juce::Button* buttonThatWasClicked)
+{
+  if (buttonThatWasClicked == report_button.get()) {
+
+      const std::string report = getProcessor()->get_latency_probe().get_report() + "\n" + SSR::Metrics::get_instance().get_text();
+
+      // One log record per line, the whole report exceeds a record.
+      std::istringstream lines(report);
+      std::string line;
+
+      SSR::Logger::get_instance()->log(SSR::Logger::Level::info, "Latency report and metrics", true);
+
+      while (std::getline(lines, line)) {
+
+          if (!line.empty() && line[0] != '#') {
+              SSR::Logger::get_instance()->log(SSR::Logger::Level::info, line, true);
+          }
+
+      }
+
+      juce::SystemClipboard::copyTextToClipboard(juce::String(report));
+  }
+}
+
+//============================================================================
+// PRIVATE
+
+void SSR::Latency_gui_component::timerCallback()
+{
+  const SSR::Latency_probe& probe = getProcessor()->get_latency_probe();
+
+  plugin_label->setText(stage_text("Plugin", probe.get_plugin().get_percentile(50.0), probe.get_plugin().get_percentile(99.0)), juce::dontSendNotification);
+  network_label->setText(stage_text("Network", probe.get_network().get_percentile(50.0), probe.get_network().get_percentile(99.0)), juce::dontSendNotification);
+  ssr_label->setText(stage_text("SSR", probe.get_ssr_percentile(50.0), probe.get_ssr_percentile(99.0)), juce::dontSendNotification);
+}
+
+void SSR::Latency_gui_component::configure_stage_label(juce::Label& label)
+{
+  label.setFont(juce::Font(13.0f));
+  label.setJustificationType(juce::Justification::centredLeft);
+  label.setEditable(false, false, false);
+  label.setColour(juce::Label::textColourId, SSR::colour::get_colour(SSR::colour::Colours::black));
+  label.setTooltip("Median / 99th percentile in milliseconds");
+}
+
+juce::String SSR::Latency_gui_component::stage_text(const juce::String& name, const unsigned long long median_in_usec, const unsigned long long p99_in_usec)
+{
+  return name + " " + juce::String(median_in_usec / 1000.0, 1) + " / " + juce::String(p99_in_usec / 1000.0, 1);
+}
@@ -0,0 +1,134 @@
+#ifndef LATENCY_GUI_COMPONENT_H
+#define LATENCY_GUI_COMPONENT_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <memory>
+
+//JUCE Lib
+#include <JUCE/JuceHeader.h>
+
+//Own Libs
+#include <src/controller.h>
+#include <src/utils/latency_histogram.h>
+
+namespace SSR
+{
+
+  /**
+   * This class represents the Latency GUI Component, a diagnostics panel
+   * showing the median and the 99th percentile of the time changes wait in
+   * the plugin, of the network round trip and of the time the SSR needs to
+   * echo them (see Latency_probe).
+   *
+   * The 'Report' button writes the full report with all percentiles per kind
+   * of change, followed by the current Metrics, to the log file and copies
+   * it to the clipboard.
+   *
+   * The values are refreshed twice a second while the component is shown.
+   */
+  class Latency_gui_component
+      : public juce::AudioProcessorEditor,
+        public juce::Button::Listener,
+        private juce::Timer
+  {
+
+  public:
+
+    /**
+     * Constructor instantiating and configuring the labels and the report
+     * button.
+     *
+     * Sets the size of the frame to 500x26 pixels.
+     *
+     * @param   controller      Controller needed to r/w data.
+     */
+    Latency_gui_component(Controller* controller);
+
+    /**
+     * Destructor.
+     */
+    ~Latency_gui_component();
+
+    /**
+     * This method returns the processor to do stuff with it.
+     *
+     * @return   the processor which is the controller of this software.
+     **/
+    Controller* getProcessor() const {
+      return static_cast<Controller*>(getAudioProcessor());
+    }
+
+    /**
+     * JUCE Doc.: Called when a button is clicked.
+     *
+     * @see http://www.juce.com/api/classButton_1_1Listener.html#a81499cef24b7189cd0d1581fd9dc9e14
+     *
+     * If the button that was clicked is the report_button, the report of the
+     * latency probe and the metrics are logged and copied to the clipboard.
+     *
+     * @param           buttonThatWasClicked            The button that was clicked.
+     */
+    void buttonClicked(juce::Button* buttonThatWasClicked) override;
+
+  private:
+
+    /**
+     * Refreshes the labels from the latency probe.
+     */
+    void timerCallback() override;
+
+    /**
+     * Configures the transferred label to show the values of a stage.
+     */
+    void configure_stage_label(juce::Label& label);
+
+    /**
+     * Returns the text of a stage label: its name, the median and the 99th
+     * percentile in milliseconds.
+     */
+    static juce::String stage_text(const juce::String& name, const unsigned long long median_in_usec, const unsigned long long p99_in_usec);
+
+  private:
+
+    /**
+     * Interval in milliseconds in which the labels are refreshed.
+     */
+    static const int refresh_interval_in_msec = 500;
+
+    /**
+     * Shows the time changes wait in the plugin.
+     */
+    std::unique_ptr<juce::Label> plugin_label;
+
+    /**
+     * Shows the round trip of the network.
+     */
+    std::unique_ptr<juce::Label> network_label;
+
+    /**
+     * Shows the time the SSR needs to echo a change.
+     */
+    std::unique_ptr<juce::Label> ssr_label;
+
+    /**
+     * The report button.
+     */
+    std::unique_ptr<juce::TextButton> report_button;
+
+  };
+
+}
+
+#endif
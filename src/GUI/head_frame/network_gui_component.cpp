@@ -24,11 +24,12 @@
 SSR::Network_gui_component::Network_gui_component(Controller* controller)
 : AudioProcessorEditor(controller)
 , connected_button(new juce::TextButton("connected_button"))
+, state(SSR::Connection_state::disconnected)
 , is_connected(false)
 {
   addAndMakeVisible(*connected_button);
 
-  SSR::configure_text_button(*connected_button, "Connected");
+  SSR::configure_text_button(*connected_button, SSR::to_string(state));
   connected_button->addListener(this);
   connected_button->setBounds(0, 0, 138, 25);
 
@@ -40,10 +41,15 @@ SSR::Network_gui_component::~Network_gui_component()
   removeAllChildren();
 }
 
-void SSR::Network_gui_component::set_connected(const bool connected)
+void SSR::Network_gui_component::set_connection_state(const SSR::Connection_state new_state)
 {
-  is_connected = connected;
+  is_connected = new_state == SSR::Connection_state::syncing || new_state == SSR::Connection_state::live;
   connected_button->setToggleState(is_connected, juce::dontSendNotification);
+
+  if (new_state != state) {
+      state = new_state;
+      connected_button->setButtonText(SSR::to_string(state));
+  }
 }
 
 bool SSR::Network_gui_component::get_connected() const
@@ -57,13 +63,11 @@ void SSR::Network_gui_component::buttonClicked(Button* button)
   if (button == connected_button.get()) {
       Controller* processor = getProcessor();
 
-      if (!is_connected) {
+      if (processor->get_connection_state() == SSR::Connection_state::disconnected) {
           processor->connect();
       }
 
-      is_connected = processor->is_connected_to_ssr();
-
-      connected_button->setToggleState(is_connected, juce::dontSendNotification);
+      set_connection_state(processor->get_connection_state());
   }
 
 }
@@ -21,6 +21,7 @@
 
 //Own Libs
 #include <src/controller.h>
+#include <src/utils/connection_state.h>
 
 namespace SSR
 {
@@ -71,11 +72,12 @@ namespace SSR
     }
 
     /**
-     * Setter for the connected_button.
+     * Shows the transferred connection state on the connected_button: the
+     * button is toggled while syncing or live, its text names the state.
      *
-     * @param   connected       True means connected, false not.
+     * @param   state           The state of the connection to the SSR.
      */
-    void set_connected(const bool connected);
+    void set_connection_state(const SSR::Connection_state state);
 
     /**
      * Returns the current status of the connected_button, true means connected,
@@ -110,6 +112,11 @@ namespace SSR
      */
     std::unique_ptr<juce::TextButton> connected_button;
 
+    /**
+     * The connection state currently shown.
+     */
+    SSR::Connection_state state;
+
     /**
      * GUI status whether the Plugin is connected to the SSR (true) or not (false).
      */
@@ -24,13 +24,16 @@
 //Own Libs
 #include <src/utils/jack_client.h>
 #include <src/utils/helper.h>
-#include <src/parameter/parameter.h>
+#include <src/parameter/static_parameter.h>
 #include <src/GUI/source_frame/source_frame_gui_component.h>
 #include <src/GUI/head_frame/head_frame_gui_component.h>
 #include <src/config/ssr_colour.h>
+#include <src/utils/metrics.h>
 
 Main_GUI_component::Main_GUI_component(Controller* controller) 
 : AudioProcessorEditor(controller)
+, last_refresh_in_msec(0)
+, pad_sources()
 , head_frame(new SSR::Head_frame_GUI_component(controller))
 , source_frame(new SSR::Source_frame_gui_component(controller))
 {
@@ -43,19 +46,22 @@ Main_GUI_component::Main_GUI_component(Controller* controller)
   head_frame->setBounds                 (0,             0,        head_frame->getWidth(),                 head_frame->getHeight());
   source_frame->setBounds               (0,             100,      source_frame->getWidth(),               source_frame->getHeight());
 
-  //TODO: Think about that...
-  head_frame->set_connected(processor->is_connected_to_ssr());
-
   //All addAndMakeVisible objects have to be initialised before here!!
   setSize(900, 600);
 
   processor->read_ssr_incoming_message();
+  processor->ui_take_changes();
+  refresh(SSR::Scene::all_changed);
 
-  startTimer(10);//starts timer with interval of 50mS
+  processor->ui_set_updater(this);
 }
 
 Main_GUI_component::~Main_GUI_component()
 {
+  getProcessor()->ui_set_updater(nullptr);
+  cancelPendingUpdate();
+  stopTimer();
+
   removeAllChildren();
   source_frame      = nullptr;
   head_frame        = nullptr;
@@ -68,27 +74,97 @@ void Main_GUI_component::paint(Graphics& graphics)
   graphics.setColour(SSR::colour::get_colour(SSR::colour::Colours::black));
 }
 
+void Main_GUI_component::handleAsyncUpdate()
+{
+  const juce::uint32 elapsed_in_msec = juce::Time::getMillisecondCounter() - last_refresh_in_msec;
+
+  // Changes arriving faster than the frame rate wait for the next frame.
+  if (elapsed_in_msec < frame_interval_in_msec) {
+
+      if (!isTimerRunning()) {
+          startTimer(static_cast<int>(frame_interval_in_msec - elapsed_in_msec));
+      }
+
+      return;
+  }
+
+  refresh(getProcessor()->ui_take_changes());
+}
+
 void Main_GUI_component::timerCallback()
 {
+  stopTimer();
+  refresh(getProcessor()->ui_take_changes());
+}
+
+//==============================================================================
+void Main_GUI_component::refresh(unsigned int changes)
+{
+  typedef SSR::Scene change;
 
   Controller* processor = getProcessor();
+  SSR::Metrics& metrics = SSR::Metrics::get_instance();
 
-  if (processor->read_ssr_incoming_message() && processor->ui_needs_update()) {
+  const unsigned long long start_in_usec = SSR::Metrics::now_in_usec();
+  last_refresh_in_msec = juce::Time::getMillisecondCounter();
 
-      SSR::Source source = processor->get_source();
+  head_frame->set_connection_state(processor->get_connection_state());
 
-      head_frame->set_connected(processor->is_connected_to_ssr());
+  if (changes & change::selection_changed) {
+      changes |= change::all_changed;
+  }
+
+  // A refilled jackport dropdown has lost its selection.
+  if (source_frame->update_jackport_dropdown()) {
+      changes |= change::jackport_changed;
+  }
+
+  if (changes == 0) {
+      metrics.add_duration(SSR::Metrics::gui_refresh_time_in_usec, SSR::Metrics::gui_refreshes, start_in_usec);
+      return;
+  }
 
-      source_frame->move_source(source.get_x_position().get_discrete_value(), source.get_y_position().get_discrete_value());
+  if (changes & (change::scene_positions_changed | change::source_list_changed)) {
+
+      const unsigned int selected_id = processor->get_source().get_id();
+      pad_sources.clear();
+
+      processor->for_each_source([this, selected_id](const SSR::Source& source) {
+        SSR::Pad_source pad_source;
+        pad_source.x = source.get_x_position().get_discrete_value();
+        pad_source.y = source.get_y_position().get_discrete_value();
+        pad_source.selected = source.get_id() == selected_id;
+        pad_sources.push_back(pad_source);
+      });
+
+      source_frame->set_sources(pad_sources);
+  }
+
+  SSR::Source source = processor->get_source();
+
+  if (changes & change::position_changed) {
       source_frame->set_x_axis_slider_value(source.get_x_position().get_discrete_value());
       source_frame->set_y_axis_slider_value(source.get_y_position().get_discrete_value());
+  }
 
+  if (changes & change::name_changed) {
       source_frame->set_name_text_editor_text(juce::String(source.get_name()));
+  }
 
+  if (changes & change::gain_changed) {
       //Be carefull: When setting the new value, the parameter_source_gain has first to be converted from linear to dB!
       source_frame->set_gain_slider_value(SSR::helper::linear_to_dB(source.get_gain().get_discrete_value()));
+  }
+
+  if (changes & change::mute_changed) {
       source_frame->set_mute_button_toggle_state(source.get_mute().get_discrete_value());
+  }
+
+  if (changes & change::fixed_changed) {
       source_frame->set_fixed_button_toggle_state(source.get_fixed().get_discrete_value());
+  }
+
+  if (changes & change::model_changed) {
 
       bool model_point = source.get_model_point().get_discrete_value();
 
@@ -98,13 +174,16 @@ void Main_GUI_component::timerCallback()
           source_frame->set_model_selected_id(2);
       }
 
+  }
+
+  if (changes & change::jackport_changed) {
       const std::string entry = source.get_jackport();
       source_frame->set_jackport_selected_entry(entry);
+  }
 
+  if (changes & change::source_list_changed) {
       source_frame->reload_source_dropdown();
-
-      processor->ui_clear_update_flag();
-
   }
 
+  metrics.add_duration(SSR::Metrics::gui_refresh_time_in_usec, SSR::Metrics::gui_refreshes, start_in_usec);
 }
@@ -23,6 +23,7 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <vector>
 
 //JUCE Lib
 #include <JUCE/JuceHeader.h>
@@ -37,17 +38,23 @@
 * The 'Source' part includes the source selection GUI element, all the source
 * properties (Name, Jackport, Model, Properties File, Azimuth, Mute, Fixed and
 * Gain) and also a pad representing the sources spatial position.
+*
+* The GUI does not poll. The controller triggers its AsyncUpdater when the
+* scene or the connection changed, and the GUI then updates only the widgets
+* named by the change mask of the scene, at most max_frame_rate times per
+* second. A closed or idle editor costs no CPU time.
 **/
 class Main_GUI_component
     : public AudioProcessorEditor
-    , public Timer
+    , public AsyncUpdater
+    , private Timer
 {
     
 public:
 
   /**
-   * Constructor creating a window with the size of 900 to 600 pixels
-   * and starting an updating timer with 10 ms for the updating interval.
+   * Constructor creating a window with the size of 900 to 600 pixels and
+   * registering it as the updater of the controller.
    *
    * @param      controller             The controller of this application.
    */
@@ -59,16 +66,13 @@ public:
   ~Main_GUI_component();
 
   /**
-   * Inherited from the JUCE Timer Class.
-   *
-   * Like the JUCE documentation say: "The user-defined callback routine that
-   * actually gets called periodically."
+   * Inherited from the JUCE AsyncUpdater Class.
    *
-   * Currently, this method calls the processors method to read the incoming
-   * messages and then sets all the UI elements to the new values held by the
-   * processor if there have been any changes.
+   * Called on the message thread after the controller reported changes.
+   * Refreshes the widgets right away, or starts the timer if the last
+   * refresh is less than one frame ago.
    **/
-  virtual void timerCallback() override;
+  virtual void handleAsyncUpdate() override;
 
   /**
    * This method returns the processor to do stuff with it.
@@ -92,6 +96,44 @@ public:
   virtual void paint(juce::Graphics& graphics) override;
 
 private:
+
+    /**
+     * The maximum number of refreshes per second.
+     */
+    static const juce::uint32 max_frame_rate = 30;
+
+    /**
+     * The minimum time in milliseconds between two refreshes.
+     */
+    static const juce::uint32 frame_interval_in_msec = 1000 / max_frame_rate;
+
+    /**
+     * Inherited from the JUCE Timer Class.
+     *
+     * Runs once per deferred frame: stops itself and refreshes the widgets.
+     **/
+    virtual void timerCallback() override;
+
+    /**
+     * Sets the widgets named by the transferred change mask to the values of
+     * the selected source, moves the sources on the pad and updates the
+     * connection state.
+     *
+     * @param           changes         A combination of SSR::Scene::Change
+     *                                  bits.
+     */
+    void refresh(unsigned int changes);
+
+    /**
+     * Time in milliseconds (juce::Time::getMillisecondCounter) of the last
+     * refresh.
+     */
+    juce::uint32 last_refresh_in_msec;
+
+    /**
+     * The sources shown on the pad, reused between refreshes.
+     */
+    std::vector<SSR::Pad_source> pad_sources;
     
     /**
      * This is the head frame of the GUI. Representing all GUI elements
@@ -56,9 +56,9 @@ void SSR::Source_frame_gui_component::paint(juce::Graphics& graphics)
   graphics.fillRoundedRectangle(10, 10, getWidth() - 20, getHeight() - 20, 10.0f);
 }
 
-void SSR::Source_frame_gui_component::move_source(const float discrete_x_position, const float discrete_y_position)
+void SSR::Source_frame_gui_component::set_sources(const std::vector<SSR::Pad_source>& sources)
 {
-  source_pad_and_controls->move_source(discrete_x_position, discrete_y_position);
+  source_pad_and_controls->set_sources(sources);
 }
 
 void SSR::Source_frame_gui_component::set_x_axis_slider_value(const double value)
@@ -86,6 +86,11 @@ void SSR::Source_frame_gui_component::set_jackport_selected_entry(const std::str
   source_parameters->set_jackport_selected_entry(entry);
 }
 
+bool SSR::Source_frame_gui_component::update_jackport_dropdown()
+{
+  return source_parameters->update_jackport_dropdown();
+}
+
 void SSR::Source_frame_gui_component::set_mute_button_toggle_state(const bool state)
 {
   source_parameters->set_mute_button_toggle_state(state);
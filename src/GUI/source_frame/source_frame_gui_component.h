@@ -86,18 +86,13 @@ namespace SSR
     void paint(juce::Graphics& graphics) override;
 
     /**
-     * Moves the source to the transferred X (discrete_x_position) and
-     * Y (discrete_y_position) position.
+     * Moves the sources on the pad to the transferred positions.
      *
      * @see source_pad_and_controls_gui_component.h
      *
-     * @param   discrete_x_position     The discrete X position to which the
-     *                                  source shall be moved.
-     *
-     * @param   discrete_y_position     The discrete Y position to which the
-     *                                  source shall be moved.
+     * @param   sources                 The sources of the scene.
      */
-    void move_source(const float discrete_x_position, const float discrete_y_position);
+    void set_sources(const std::vector<SSR::Pad_source>& sources);
 
     /**
      * Sets the current value of the x_axis_slider slider to the transferred
@@ -153,6 +148,15 @@ namespace SSR
      */
     void set_jackport_selected_entry(const std::string& entry);
 
+    /**
+     * Refills the jackport_dropdown if the Jack ports changed.
+     *
+     * @see source_parameters_gui_component.h
+     *
+     * @return  true if the jackport_dropdown has been refilled.
+     */
+    bool update_jackport_dropdown();
+
     /**
      * Sets the mute button toggle state to the transferred state.
      *
@@ -17,12 +17,21 @@
 
 SSR::Source_gui_component::Source_gui_component()
 : radius(20.0f)
+, ring_colour(SSR::colour::Colours::purple)
 {
   setSize(40.0f, 40.0f);
 }
 
 SSR::Source_gui_component::Source_gui_component(const unsigned int width_and_height)
 : radius(width_and_height / 2.0f)
+, ring_colour(SSR::colour::Colours::purple)
+{
+  setSize(width_and_height, width_and_height);
+}
+
+SSR::Source_gui_component::Source_gui_component(const unsigned int width_and_height, const SSR::colour::Colours ring_colour)
+: radius(width_and_height / 2.0f)
+, ring_colour(ring_colour)
 {
   setSize(width_and_height, width_and_height);
 }
@@ -47,6 +56,6 @@ void SSR::Source_gui_component::draw_background(juce::Graphics& graphics)
   graphics.setColour(SSR::colour::get_colour(SSR::colour::Colours::white));
   graphics.fillEllipse(0.0f, 0.0f, getWidth(), getHeight());
 
-  graphics.setColour(SSR::colour::get_colour(SSR::colour::Colours::purple));
+  graphics.setColour(SSR::colour::get_colour(ring_colour));
   graphics.drawEllipse(2.0f, 2.0f, getWidth() - 4.0f, getHeight() - 4.0f, 3.0f);
 }
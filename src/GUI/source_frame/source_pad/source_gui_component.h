@@ -19,6 +19,9 @@
 //C++ Libs
 #include <memory>
 
+//Own Libs
+#include <src/config/ssr_colour.h>
+
 namespace SSR
 {
 
@@ -49,6 +52,17 @@ namespace SSR
      */
     Source_gui_component(const unsigned int width_and_height);
 
+    /**
+     * Constructor initialising the radius with width_and_height / 2 and the
+     * colour of the ring with the transferred ring_colour.
+     *
+     * @param   width_and_height        The width and height of the GUI
+     *                                  component.
+     *
+     * @param   ring_colour             The colour of the ring.
+     */
+    Source_gui_component(const unsigned int width_and_height, const SSR::colour::Colours ring_colour);
+
     /**
      * Destructor.
      */
@@ -87,6 +101,11 @@ namespace SSR
      */
     float radius;
 
+    /**
+     * Colour of the ring of the circle.
+     */
+    SSR::colour::Colours ring_colour;
+
   };
 
 
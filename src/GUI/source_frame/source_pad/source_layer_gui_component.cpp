@@ -0,0 +1,141 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/GUI/source_frame/source_pad/source_layer_gui_component.h>
+
+//C++ Libs
+#include <algorithm>
+
+//Own Libs
+#include <src/GUI/source_frame/source_pad/source_gui_component.h>
+#include <src/config/ssr_colour.h>
+
+SSR::Source_layer_gui_component::Source_layer_gui_component(int width, int height)
+: Component("GUI_component_source_layer")
+, selected_source_sprite()
+, source_sprite()
+, placed_sources()
+, range(1.0)
+{
+  SSR::Source_gui_component selected_source(selected_source_size, SSR::colour::Colours::purple);
+  selected_source_sprite = selected_source.createComponentSnapshot(selected_source.getLocalBounds());
+
+  SSR::Source_gui_component source(source_size, SSR::colour::Colours::blue);
+  source_sprite = source.createComponentSnapshot(source.getLocalBounds());
+
+  setInterceptsMouseClicks(false, false);
+  setOpaque(false);
+  setSize(width, height);
+}
+
+SSR::Source_layer_gui_component::~Source_layer_gui_component()
+{
+
+}
+
+void SSR::Source_layer_gui_component::set_sources(const std::vector<SSR::Pad_source>& sources, const double new_range)
+{
+  range = new_range;
+
+  // Sources which were removed leave their area behind.
+  for (std::size_t index = sources.size(); index < placed_sources.size(); index++) {
+      repaint(placed_sources[index].bounds);
+  }
+
+  placed_sources.resize(sources.size());
+
+  for (std::size_t index = 0; index < sources.size(); index++) {
+
+      Placed_source& placed = placed_sources[index];
+      const juce::Rectangle<int> bounds = place(sources[index], range);
+
+      if (bounds != placed.bounds || sources[index].selected != placed.source.selected) {
+          repaint(placed.bounds);
+          repaint(bounds);
+      }
+
+      placed.source = sources[index];
+      placed.bounds = bounds;
+  }
+}
+
+void SSR::Source_layer_gui_component::update_range(const double new_range)
+{
+  range = new_range;
+  place_all(range);
+}
+
+void SSR::Source_layer_gui_component::paint(juce::Graphics& graphics)
+{
+  const juce::Rectangle<int> clip = graphics.getClipBounds();
+  const Placed_source* selected = nullptr;
+
+  for (const Placed_source& placed : placed_sources) {
+
+      if (placed.source.selected) {
+          selected = &placed;
+      } else if (placed.bounds.intersects(clip)) {
+          graphics.drawImageAt(source_sprite, placed.bounds.getX(), placed.bounds.getY());
+      }
+
+  }
+
+  if (selected != nullptr && selected->bounds.intersects(clip)) {
+      graphics.drawImageAt(selected_source_sprite, selected->bounds.getX(), selected->bounds.getY());
+  }
+}
+
+/**
+ * PRIVATE
+ */
+
+juce::Rectangle<int> SSR::Source_layer_gui_component::place(const SSR::Pad_source& source, const double range) const
+{
+  const int size = source.selected ? selected_source_size : source_size;
+  const float radius = size / 2.0f;
+
+  float x = compute_continuous_position(true, source.x, range) * getWidth() - radius;
+  x = std::max(0.0f, std::min(x, static_cast<float>(getWidth() - size)));
+
+  float y = compute_continuous_position(false, source.y, range) * getHeight() - radius;
+  y = std::max(0.0f, std::min(y, static_cast<float>(getHeight() - size)));
+
+  return juce::Rectangle<int>(static_cast<int>(x), static_cast<int>(y), size, size);
+}
+
+void SSR::Source_layer_gui_component::place_all(const double range)
+{
+  for (Placed_source& placed : placed_sources) {
+      placed.bounds = place(placed.source, range);
+  }
+
+  repaint();
+}
+
+float SSR::Source_layer_gui_component::compute_continuous_position(const bool x_axis, float discrete_position, const double range)
+{
+  discrete_position = x_axis ? discrete_position : discrete_position * -1.0f;
+
+  float relative_position = 0.0f;
+  float lower_bound = range / -2.0f;
+  float upper_bound = range / 2.0f;
+
+  if (discrete_position <= lower_bound) {
+      relative_position = 0.0f;
+  } else if (discrete_position >= upper_bound) {
+      relative_position = 1.0f;
+  } else {
+      relative_position = (0.5 / upper_bound) * discrete_position + 0.5;
+  }
+
+  return relative_position;
+}
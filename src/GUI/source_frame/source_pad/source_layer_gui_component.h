@@ -0,0 +1,180 @@
+#ifndef SOURCE_LAYER_GUI_COMPONENT_H
+#define SOURCE_LAYER_GUI_COMPONENT_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//JUCE Lib
+#include <JUCE/JuceHeader.h>
+
+//C++ Libs
+#include <vector>
+
+namespace SSR
+{
+
+  /**
+   * The position of one source shown on the source pad.
+   */
+  struct Pad_source
+  {
+
+    /**
+     * The discrete X position.
+     */
+    float x;
+
+    /**
+     * The discrete Y position.
+     */
+    float y;
+
+    /**
+     * True if the source is the selected one.
+     */
+    bool selected;
+
+  };
+
+  /**
+   * This class represents the layer of the source pad showing all sources of
+   * the scene.
+   *
+   * The sources are not components of their own. Every source is drawn as
+   * one of two sprites (selected or not) which are rendered from a
+   * Source_gui_component once. When the sources move, only the rectangles
+   * they left and entered are repainted, so hundreds of moving sources do not
+   * repaint the whole pad. The layer is transparent and does not take mouse
+   * clicks.
+   */
+  class Source_layer_gui_component
+      : public juce::Component
+  {
+
+  public:
+
+    /**
+     * Constructor rendering the sprites and setting the size of this GUI
+     * component to the transferred width and height.
+     *
+     * @param   width           The width in pixels.
+     *
+     * @param   height          The height in pixels.
+     */
+    Source_layer_gui_component(int width, int height);
+
+    /**
+     * Destructor.
+     */
+    ~Source_layer_gui_component();
+
+    /**
+     * Sets the sources shown and repaints the areas of the sources which
+     * moved, appeared or disappeared.
+     *
+     * @param   sources         The sources of the scene.
+     *
+     * @param   range           The range of the grid.
+     */
+    void set_sources(const std::vector<SSR::Pad_source>& sources, const double range);
+
+    /**
+     * Places the sources for the transferred range of the grid (this is not
+     * changing the positions of the sources just their visual
+     * representation).
+     *
+     * @param   range           The new range of the grid.
+     */
+    void update_range(const double range);
+
+    /**
+     * Draws the sprites of the sources inside the clip region, the selected
+     * source on top.
+     *
+     * @param   graphics        The graphics context that must be used to do
+     *                          the drawing operations.
+     */
+    void paint(juce::Graphics& graphics) override;
+
+  private:
+
+    /**
+     * A source as placed on the layer.
+     */
+    struct Placed_source
+    {
+      SSR::Pad_source source;
+      juce::Rectangle<int> bounds;
+    };
+
+    /**
+     * Computes the bounds of the sprite of the transferred source for the
+     * transferred range. Sources outside of the range are placed at the
+     * border.
+     */
+    juce::Rectangle<int> place(const SSR::Pad_source& source, const double range) const;
+
+    /**
+     * Places all sources again and repaints the areas which changed.
+     */
+    void place_all(const double range);
+
+    /**
+     * Computes the continuous position (from 0.0 to 1.0) of the transferred
+     * discrete_position for the transferred range. The Y axis is flipped.
+     *
+     * @param   x_axis                  True for the X axis, false for the Y
+     *                                  axis.
+     *
+     * @param   discrete_position       The discrete position of the source.
+     *
+     * @param   range                   The range of the grid.
+     */
+    static float compute_continuous_position(const bool x_axis, float discrete_position, const double range);
+
+  private:
+
+    /**
+     * The diameter in pixels of the selected source.
+     */
+    static const int selected_source_size = 40;
+
+    /**
+     * The diameter in pixels of the other sources.
+     */
+    static const int source_size = 30;
+
+    /**
+     * The sprite of the selected source.
+     */
+    juce::Image selected_source_sprite;
+
+    /**
+     * The sprite of the other sources.
+     */
+    juce::Image source_sprite;
+
+    /**
+     * The sources as currently shown.
+     */
+    std::vector<Placed_source> placed_sources;
+
+    /**
+     * The range the sources are placed for.
+     */
+    double range;
+
+  };
+
+}
+
+#endif
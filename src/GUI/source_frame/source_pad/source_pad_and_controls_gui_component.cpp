@@ -61,9 +61,9 @@ SSR::Source_pad_and_controls_gui_component::~Source_pad_and_controls_gui_compone
   removeAllChildren();
 }
 
-void SSR::Source_pad_and_controls_gui_component::move_source(const float discrete_x_position, const float discrete_y_position)
+void SSR::Source_pad_and_controls_gui_component::set_sources(const std::vector<SSR::Pad_source>& sources)
 {
-  pad->move_source(discrete_x_position, discrete_y_position, zoom->get_current_range());
+  pad->set_sources(sources, zoom->get_current_range());
 }
 
 void SSR::Source_pad_and_controls_gui_component::sliderValueChanged(juce::Slider* sliderThatWasMoved)
@@ -18,6 +18,7 @@
 
 //C++ Libs
 #include <memory>
+#include <vector>
 
 //Own Libs
 #include <src/GUI/source_frame/source_pad/source_pad_gui_component.h>
@@ -57,16 +58,11 @@ namespace SSR
     ~Source_pad_and_controls_gui_component();
 
     /**
-     * Moves the source to the transferred X (discrete_x_position) and
-     * Y (discrete_y_position) position.
+     * Moves the sources on the pad to the transferred positions.
      *
-     * @param   discrete_x_position     The discrete X position to which the
-     *                                  source shall be moved.
-     *
-     * @param   discrete_y_position     The discrete Y position to which the
-     *                                  source shall be moved.
+     * @param   sources                 The sources of the scene.
      */
-    void move_source(const float discrete_x_position, const float discrete_y_position);
+    void set_sources(const std::vector<SSR::Pad_source>& sources);
 
     /**
      * This method returns the processor to do stuff with it.
@@ -18,10 +18,11 @@
 
 //C++ Libs
 #include <memory>
+#include <vector>
 
 //Own Libs
 #include <src/GUI/source_frame/source_pad/grid_gui_component.h>
-#include <src/GUI/source_frame/source_pad/source_gui_component.h>
+#include <src/GUI/source_frame/source_pad/source_layer_gui_component.h>
 #include <src/GUI/source_frame/source_pad/scale_reference_gui_component.h>
 
 namespace SSR
@@ -29,8 +30,12 @@ namespace SSR
 
   /**
    * This class represents the 'Source pad GUI component' including a grid,
-   * the source that moves on the grid and a scale reference to visualize
-   * the scale of the grid.
+   * the sources of the scene that move on the grid and a scale reference to
+   * visualize the scale of the grid.
+   *
+   * The grid and the scale reference are buffered to images, so repainting
+   * the area of a moving source only copies their cached pixels. The grid is
+   * rendered once, the scale reference whenever the range changes.
    */
   class Source_pad_gui_component
       : public juce::Component
@@ -57,23 +62,18 @@ namespace SSR
     ~Source_pad_gui_component();
 
     /**
-     * Moves the sources X and Y position to the transferred discrete_x_position
-     * and discrete_y_position.
+     * Moves the sources to the transferred positions.
      *
-     * @param   discrete_x_position     The discrete X position the source shall
-     *                                  be moved to.
-     *
-     * @param   discrete_y_position     The discrete Y position the source shall
-     *                                  be moved to.
+     * @param   sources                 The sources of the scene.
      *
      * @param   range                   The range of the grid.
      */
-    void move_source(const float discrete_x_position, const float discrete_y_position, const double range);
+    void set_sources(const std::vector<SSR::Pad_source>& sources, const double range);
 
     /**
-     * Updates the range of the grid and computes the new position the source
-     * will be placed in the grid (this is not changing the position of the
-     * source just the visual representation).
+     * Updates the range of the grid and computes the new positions the
+     * sources will be placed in the grid (this is not changing the positions
+     * of the sources just the visual representation).
      *
      * @param   range                   The new range of the grid.
      */
@@ -90,59 +90,14 @@ namespace SSR
   private:
 
     /**
-     * Moves the source to the new X and Y position defined by the continuous
-     * values continuous_x_position and continuous_y_position.
-     *
-     * If the resulting discrete positions are less than 0.0 the new positions
-     * will be assigned to 0.0.
-     *
-     * @param   continuous_x_position   The new continuous X position the source
-     *                                  shall be moved to (from 0.0 to 1.0).
-     *
-     * @param   continuous_y_position   The new continuous Y position the source
-     *                                  shall be moved to (from 0.0 to 1.0).
-     */
-    void move_source_continuously(const float continuous_x_position, const float continuous_y_position);
-
-    /**
-     * Computes the continuous position of the source using the transferred
-     * discrete_position and the transferred range and returns the result.
-     *
-     * The transferred x_axis boolean value defines if the continuous position
-     * shall be computed for the X axis (true) or the Y axis (false).
-     *
-     * @param   x_axis                  Defines if the continuous position
-     *                                  shall be computed for the X axis (true)
-     *                                  or the Y axis (false).
-     *
-     * @param   discrete_position       The discrete position of the source.
-     *
-     * @param   range                   The range for which the continuous
-     *                                  position shall be computed.
-     */
-    float compute_continuous_position(const bool x_axis, float discrete_position, const double range);
-
-  private:
-
-    /**
-     * The current discrete X position of the source.
-     */
-    float current_discrete_x_position;
-
-    /**
-     * The current discrete Y position of the source.
-     */
-    float current_discrete_y_position;
-
-    /**
-     * The grid on which the source moves on.
+     * The grid on which the sources move on.
      */
     std::unique_ptr<SSR::Grid_gui_component> grid;
 
     /**
-     * The source.
+     * The sources.
      */
-    std::unique_ptr<SSR::Source_gui_component> source;
+    std::unique_ptr<SSR::Source_layer_gui_component> sources;
 
     /**
      * The scale reference.
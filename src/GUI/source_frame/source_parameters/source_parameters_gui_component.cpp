@@ -13,6 +13,7 @@
 #include <src/GUI/source_frame/source_parameters/source_parameters_gui_component.h>
 
 //C++ Libs
+#include <cstdio>
 #include <string>
 #include <map>
 #include <algorithm>
@@ -21,6 +22,8 @@
 #include <src/GUI/gui_components_configurator.h>
 #include <src/config/ssr_colour.h>
 #include <src/controller.h>
+#include <src/parameter/parameter_bank.h>
+#include <src/trajectory/trajectory.h>
 #include <src/utils/logger.h>
 
 SSR::Source_parameters_gui_component::Source_parameters_gui_component(Controller* controller)
@@ -40,10 +43,16 @@ SSR::Source_parameters_gui_component::Source_parameters_gui_component(Controller
 , gain_label(new juce::Label("gain_label", TRANS("Gain")))
 , model_label(new juce::Label("model_label", TRANS("Model")))
 , model_dropdown(new juce::ComboBox("model_dropdown"))
+, slot_label(new juce::Label("slot_label", TRANS("Slot")))
+, slot_dropdown(new juce::ComboBox("slot_dropdown"))
+, trajectory_label(new juce::Label("trajectory_label", TRANS("Path")))
+, trajectory_dropdown(new juce::ComboBox("trajectory_dropdown"))
+, keyframe_button(new juce::TextButton("keyframe_button"))
+, jackport_snapshot()
 {
   make_all_visible();
   configure_all_components();
-  reload_jackport_dropdown();
+  update_jackport_dropdown();
   set_bounds();
   setSize(450, 400);
 }
@@ -60,6 +69,8 @@ void SSR::Source_parameters_gui_component::buttonClicked(juce::Button* buttonTha
       getProcessor()->set_mute_discrete_of_selected_source(mute_button->getToggleState());
   } else if (buttonThatWasClicked == fixed_button.get()) {
       getProcessor()->set_fixed_discrete_of_selected_source(fixed_button->getToggleState());
+  } else if (buttonThatWasClicked == keyframe_button.get()) {
+      add_keyframe();
   }
 
 }
@@ -85,6 +96,20 @@ void SSR::Source_parameters_gui_component::comboBoxChanged(juce::ComboBox* combo
   } else if (comboBoxThatHasChanged == sources_dropdown.get()) {
       int id = sources_dropdown->getSelectedId();
       getProcessor()->select_source(id);
+      update_slot_dropdown();
+      update_trajectory_dropdown();
+  } else if (comboBoxThatHasChanged == slot_dropdown.get()) {
+      bind_selected_source_to_slot(slot_dropdown->getSelectedId());
+  } else if (comboBoxThatHasChanged == trajectory_dropdown.get()) {
+
+      const int item_id = trajectory_dropdown->getSelectedId();
+
+      if (item_id >= first_shape_item_id) {
+          getProcessor()->set_trajectory_shape_of_selected_source(static_cast<SSR::Trajectory::Shape>(item_id - first_shape_item_id));
+      } else {
+          getProcessor()->clear_trajectory_of_selected_source();
+      }
+
   }
 
 }
@@ -132,20 +157,16 @@ void SSR::Source_parameters_gui_component::set_jackport_selected_entry(const std
 
   if (entry != jackport_dropdown->getText()) {
 
-      bool entry_exists = false;
-
-      for (std::map<int, std::string>::iterator it = jackport_dropdown_menu_entries.begin(); it != jackport_dropdown_menu_entries.end(); ++it) {
-
-          if (it->second == entry) {
-              entry_exists = true;
-              jackport_dropdown->setSelectedId(it->first, juce::dontSendNotification);
-          }
+      const std::size_t index = jackport_snapshot->index_of(entry);
+      const bool entry_exists = (index != SSR::Jack_port_snapshot::npos);
 
+      if (entry_exists) {
+          jackport_dropdown->setSelectedId(first_jackport_item_id + static_cast<int>(index), juce::dontSendNotification);
       }
 
       if (!entry_exists) {
           std::string message = "jackport_dropdown_menu entry " + entry + " does not exist in dropdown menu!";
-          SSR::Logger::get_instance()->log(SSR::Logger::Level::ERROR, message, LOG_TO_FILE);
+          SSR::Logger::get_instance()->log(SSR::Logger::Level::error, message, LOG_TO_FILE);
       }
 
   }
@@ -167,24 +188,28 @@ void SSR::Source_parameters_gui_component::set_name_text_editor_text(const juce:
   set_text_editor_text(*name_text_editor, text, name_text_editor_is_changing);
 }
 
-void SSR::Source_parameters_gui_component::reload_jackport_dropdown()
+bool SSR::Source_parameters_gui_component::update_jackport_dropdown()
 {
-  //Fills the Dropdown with all jack ports
-  std::vector<std::string> all_jack_ports = getProcessor()->get_all_jack_ports(JackPortIsOutput);
+  std::shared_ptr<const SSR::Jack_port_snapshot> snapshot = getProcessor()->get_jack_ports();
 
-  //Clearing the jackport_dropdown and the map jackport_dropdown_menu_entries
+  if (jackport_snapshot && jackport_snapshot->get_version() == snapshot->get_version()) {
+      return false;
+  }
+
+  jackport_snapshot = snapshot;
   jackport_dropdown->clear(juce::dontSendNotification);
-  jackport_dropdown_menu_entries.clear();
 
-  int item_index = 10;
-  for (std::vector<std::string>::iterator it = all_jack_ports.begin(); it != all_jack_ports.end(); it++) {
+  const std::vector<std::string>& names = jackport_snapshot->get_names();
 
-      jackport_dropdown->addItem(String(*it), item_index);
-      jackport_dropdown_menu_entries.insert(std::pair<int, std::string>(item_index, *it));
-      item_index++;
+  if (names.empty()) {
+      jackport_dropdown->addItem("No Jackport available.", first_jackport_item_id);
+  }
 
+  for (std::size_t index = 0; index < names.size(); index++) {
+      jackport_dropdown->addItem(juce::String(names[index]), first_jackport_item_id + static_cast<int>(index));
   }
 
+  return true;
 }
 
 void SSR::Source_parameters_gui_component::reload_source_dropdown()
@@ -199,6 +224,39 @@ void SSR::Source_parameters_gui_component::reload_source_dropdown()
   });
 
   sources_dropdown->setSelectedId(controller->get_source().get_id(), juce::dontSendNotification);
+
+  update_slot_dropdown();
+  update_trajectory_dropdown();
+}
+
+void SSR::Source_parameters_gui_component::update_slot_dropdown()
+{
+  Controller* controller = getProcessor();
+  const unsigned int source_id = controller->get_source().get_id();
+
+  int item_id = no_slot_item_id;
+
+  for (std::size_t slot = 0; slot < SSR::Parameter_bank::slot_count; slot++) {
+
+      if (source_id != 0 && controller->get_source_id_of_slot(slot) == source_id) {
+          item_id = first_slot_item_id + static_cast<int>(slot);
+          break;
+      }
+
+  }
+
+  slot_dropdown->setSelectedId(item_id, juce::dontSendNotification);
+}
+
+void SSR::Source_parameters_gui_component::update_trajectory_dropdown()
+{
+  SSR::Trajectory::Shape shape;
+
+  if (getProcessor()->get_trajectory_shape_of_selected_source(shape)) {
+      trajectory_dropdown->setSelectedId(first_shape_item_id + static_cast<int>(shape), juce::dontSendNotification);
+  } else {
+      trajectory_dropdown->setSelectedId(no_trajectory_item_id, juce::dontSendNotification);
+  }
 }
 
 void SSR::Source_parameters_gui_component::make_all_visible()
@@ -217,6 +275,11 @@ void SSR::Source_parameters_gui_component::make_all_visible()
   addAndMakeVisible(*model_dropdown);
   addAndMakeVisible(*sources_dropdown);
   addAndMakeVisible(*gain_label);
+  addAndMakeVisible(*slot_label);
+  addAndMakeVisible(*slot_dropdown);
+  addAndMakeVisible(*trajectory_label);
+  addAndMakeVisible(*trajectory_dropdown);
+  addAndMakeVisible(*keyframe_button);
 }
 
 void SSR::Source_parameters_gui_component::configure_all_components()
@@ -245,6 +308,10 @@ void SSR::Source_parameters_gui_component::configure_text_buttons()
 
   SSR::configure_text_button(*mute_button, juce::String("Mute"));
   mute_button->addListener(this);
+
+  SSR::configure_text_button(*keyframe_button, juce::String("Key"));
+  keyframe_button->setClickingTogglesState(false);
+  keyframe_button->addListener(this);
 }
 
 void SSR::Source_parameters_gui_component::configure_labels()
@@ -257,6 +324,8 @@ void SSR::Source_parameters_gui_component::configure_labels()
   SSR::configure_label(*jackport_label,         background_colour);
   SSR::configure_label(*model_label,            background_colour);
   SSR::configure_label(*gain_label,             background_colour);
+  SSR::configure_label(*slot_label,             background_colour);
+  SSR::configure_label(*trajectory_label,       background_colour);
 }
 
 void SSR::Source_parameters_gui_component::configure_dropdowns()
@@ -276,6 +345,33 @@ void SSR::Source_parameters_gui_component::configure_dropdowns()
   sources_dropdown->addListener(this);
 
   sources_dropdown->setSelectedId(1, juce::dontSendNotification);
+
+  SSR::configure_dropdown(*slot_dropdown, juce::String("None"));
+  slot_dropdown->addItem("None", no_slot_item_id);
+
+  for (std::size_t slot = 0; slot < SSR::Parameter_bank::slot_count; slot++) {
+      char name[16];
+      std::snprintf(name, sizeof(name), "Slot %02u", static_cast<unsigned int>(slot + 1));
+      slot_dropdown->addItem(juce::String(name), first_slot_item_id + static_cast<int>(slot));
+  }
+
+  update_slot_dropdown();
+
+  slot_dropdown->addListener(this);
+
+  typedef SSR::Trajectory::Shape Shape;
+
+  SSR::configure_dropdown(*trajectory_dropdown, juce::String("None"));
+  trajectory_dropdown->addItem("None", no_trajectory_item_id);
+  trajectory_dropdown->addItem("Linear", first_shape_item_id + static_cast<int>(Shape::linear));
+  trajectory_dropdown->addItem("Catmull-Rom", first_shape_item_id + static_cast<int>(Shape::catmull_rom));
+  trajectory_dropdown->addItem("Bezier", first_shape_item_id + static_cast<int>(Shape::bezier));
+  trajectory_dropdown->addItem("Circle", first_shape_item_id + static_cast<int>(Shape::circle));
+  trajectory_dropdown->addItem("Figure eight", first_shape_item_id + static_cast<int>(Shape::figure_eight));
+
+  update_trajectory_dropdown();
+
+  trajectory_dropdown->addListener(this);
 }
 
 void SSR::Source_parameters_gui_component::configure_sliders()
@@ -292,6 +388,40 @@ void SSR::Source_parameters_gui_component::set_text_editor_text(juce::TextEditor
   }
 }
 
+void SSR::Source_parameters_gui_component::bind_selected_source_to_slot(const int item_id)
+{
+  Controller* controller = getProcessor();
+  const unsigned int source_id = controller->get_source().get_id();
+
+  if (source_id == 0) {
+      return;
+  }
+
+  for (std::size_t slot = 0; slot < SSR::Parameter_bank::slot_count; slot++) {
+
+      if (controller->get_source_id_of_slot(slot) == source_id) {
+          controller->bind_slot_to_source(slot, 0);
+      }
+
+  }
+
+  if (item_id >= first_slot_item_id) {
+      controller->bind_slot_to_source(static_cast<std::size_t>(item_id - first_slot_item_id), source_id);
+  }
+}
+
+void SSR::Source_parameters_gui_component::add_keyframe()
+{
+  int item_id = trajectory_dropdown->getSelectedId();
+
+  if (item_id < first_shape_item_id) {
+      item_id = first_shape_item_id + static_cast<int>(SSR::Trajectory::Shape::linear);
+      trajectory_dropdown->setSelectedId(item_id, juce::dontSendNotification);
+  }
+
+  getProcessor()->add_keyframe_to_selected_source(static_cast<SSR::Trajectory::Shape>(item_id - first_shape_item_id));
+}
+
 void SSR::Source_parameters_gui_component::set_bounds()
 {
   int middle_line = 120;
@@ -305,6 +435,15 @@ void SSR::Source_parameters_gui_component::set_bounds()
   sources_dropdown->setBounds(middle_line, 0, standard_width, standard_heigth);
   current_y += standard_heigth + gap_standard;
 
+  slot_label->setBounds(0, current_y, standard_label_width, standard_heigth);
+  slot_dropdown->setBounds(middle_line, current_y, standard_width, standard_heigth);
+  current_y += standard_heigth + gap_standard;
+
+  trajectory_label->setBounds(0, current_y, standard_label_width, standard_heigth);
+  trajectory_dropdown->setBounds(middle_line, current_y, standard_width, standard_heigth);
+  keyframe_button->setBounds(middle_line + standard_width + gap_standard, current_y, 80 - gap_standard, standard_heigth);
+  current_y += standard_heigth + gap_standard;
+
   name_label->setBounds(0, current_y, standard_label_width, standard_heigth);
   name_text_editor->setBounds(middle_line, current_y, standard_width, standard_heigth);
   current_y += standard_heigth + gap_standard;
@@ -19,7 +19,6 @@
 //Own Libs
 #include <memory>
 #include <string>
-#include <map>
 
 #include <src/controller.h>
 
@@ -37,6 +36,10 @@ namespace SSR
    * - Orientation (r)
    * - Gain (r/w)
    * - Source Dropdown (for choosing which source to manipulate) (r/w)
+   * - Slot Dropdown (for choosing the slot of the parameter bank the host
+   *   automates the source with) (r/w)
+   * - Path Dropdown and Key Button (for choosing the shape of the trajectory
+   *   of the source and recording its keyframes) (r/w)
    * - Jackport Dropdown (for chossing the jackport the source shall connect to) (r/w)
    * - Model (r/w)
    */
@@ -69,8 +72,8 @@ namespace SSR
      *
      * @see http://www.juce.com/api/classButton_1_1Listener.html#a81499cef24b7189cd0d1581fd9dc9e14
      *
-     * The controller will be noticed if the mute_button or fixed_button was
-     * clicked.
+     * The controller will be noticed if the mute_button, the fixed_button or
+     * the keyframe_button was clicked.
      *
      * @param           buttonThatWasClicked            The button that was clicked.
      */
@@ -99,8 +102,9 @@ namespace SSR
      * @see http://www.juce.com/api/classComboBox.html
      * @see http://www.juce.com/api/classFileBrowserComponent.html#a8e55a512b35b04dce0a9c16ef5028487
      *
-     * The controller will be noticed if the jackport_dropdown, the model_dropdown
-     * or the sources_dropwdown has been changed.
+     * The controller will be noticed if the jackport_dropdown, the model_dropdown,
+     * the sources_dropwdown, the slot_dropdown or the trajectory_dropdown has
+     * been changed.
      *
      * @param   comboBoxThatHasChanged          The combobox that has changed.
      */
@@ -207,26 +211,39 @@ namespace SSR
     void set_name_text_editor_text(const juce::String& text);
 
     /**
-     * Clears all the data of the jackport_dropdown and the
-     * jackport_dropdown_menu_entries and fills the jackport_dropdown and the
-     * jackport_dropdown_menu_entries with all available jackports.
+     * Refills the jackport_dropdown with the current snapshot of the Jack
+     * output ports if its version differs from the one the dropdown was
+     * filled with. If there are no ports, the only entry is
+     * "No Jackport available.".
      *
-     * For more information on which jackports are inserted and how, please
-     * read the documentation of Controller::get_all_jack_ports(...)
+     * The selection is lost when the dropdown is refilled, so the caller has
+     * to select the jackport of the selected source again.
      *
-     * The transferred jack flag to receiving all output jackports: JackPortIsOutput
+     * @return  true if the jackport_dropdown has been refilled.
      *
-     * @see controller.h
+     * @see Controller::get_jack_ports()
      */
-    void reload_jackport_dropdown();
+    bool update_jackport_dropdown();
 
     /**
      * Clears all the data of source_dropdown and fills it with the current
      * available sources and sets the selected source to the current selected
-     * source of the controller.
+     * source of the controller. Afterwards, the slot_dropdown is updated.
      */
     void reload_source_dropdown();
 
+    /**
+     * Selects the slot of the parameter bank the current selected source is
+     * bound to in the slot_dropdown, "None" if it is not bound to any slot.
+     */
+    void update_slot_dropdown();
+
+    /**
+     * Selects the shape of the trajectory of the current selected source in
+     * the trajectory_dropdown, "None" if it has no trajectory.
+     */
+    void update_trajectory_dropdown();
+
   private:
 
     /**
@@ -279,6 +296,22 @@ namespace SSR
      */
     void set_text_editor_text(juce::TextEditor& texteditor, const juce::String& text, bool is_changing);
 
+    /**
+     * Binds the slot of the transferred slot_dropdown item to the current
+     * selected source and unbinds every other slot bound to it, so the
+     * source is automated by a single slot. The "None" item only unbinds.
+     *
+     * @param   item_id         The item ID selected in the slot_dropdown.
+     */
+    void bind_selected_source_to_slot(const int item_id);
+
+    /**
+     * Records the position of the selected source as a keyframe of its
+     * trajectory, using the shape selected in the trajectory_dropdown (a
+     * linear path if "None" is selected).
+     */
+    void add_keyframe();
+
     /**
      * Sets the bounds of all GUI components of this class.
      */
@@ -357,9 +390,66 @@ namespace SSR
     std::unique_ptr<juce::TextButton> mute_button;
 
     /**
-     * This vector is needed to store all ids that have been put in
+     * The label for the slot dropdown.
+     */
+    std::unique_ptr<juce::Label> slot_label;
+
+    /**
+     * The dropdown binding the selected source to a slot of the parameter
+     * bank.
+     */
+    std::unique_ptr<juce::ComboBox> slot_dropdown;
+
+    /**
+     * The label for the trajectory dropdown.
+     */
+    std::unique_ptr<juce::Label> trajectory_label;
+
+    /**
+     * The dropdown choosing the shape of the trajectory of the selected
+     * source, "None" removes the trajectory and its keyframes.
+     */
+    std::unique_ptr<juce::ComboBox> trajectory_dropdown;
+
+    /**
+     * The button recording a keyframe of the trajectory at the play head
+     * position of the host.
+     */
+    std::unique_ptr<juce::TextButton> keyframe_button;
+
+    /**
+     * The snapshot of the Jack ports the jackport_dropdown is filled with.
+     * The item ID of a port is its index in the snapshot plus
+     * first_jackport_item_id.
+     **/
+    std::shared_ptr<const SSR::Jack_port_snapshot> jackport_snapshot;
+
+    /**
+     * The item ID of the first entry of the jackport_dropdown.
+     **/
+    static const int first_jackport_item_id = 10;
+
+    /**
+     * The item ID of the "None" entry of the slot_dropdown.
+     **/
+    static const int no_slot_item_id = 1;
+
+    /**
+     * The item ID of the first slot of the slot_dropdown. The item ID of a
+     * slot is its index plus first_slot_item_id.
+     **/
+    static const int first_slot_item_id = 10;
+
+    /**
+     * The item ID of the "None" entry of the trajectory_dropdown.
+     **/
+    static const int no_trajectory_item_id = 1;
+
+    /**
+     * The item ID of the first shape of the trajectory_dropdown. The item ID
+     * of a shape is its value plus first_shape_item_id.
      **/
-    std::map<int, std::string> jackport_dropdown_menu_entries;
+    static const int first_shape_item_id = 10;
 
     /**
      * Represents if the Source Name Text Editor UI element is currently
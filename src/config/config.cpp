@@ -27,6 +27,8 @@
 SSR::Config::Config(boost::filesystem::path& config_file)
 : config_file(config_file)
 , network_config(new SSR::Network_config())
+, metrics_file()
+, metrics_interval_in_sec(10)
 {
 
 }
@@ -50,8 +52,23 @@ void SSR::Config::load_config_xml_file()
 
         set_network_config(hostname, port, timeout);
 
+        const unsigned int max_update_rate = document.get("config.network.max_update_rate", 100u);
+
+        network_config->set_max_update_rate(max_update_rate);
+        network_config->set_position_max_update_rate(document.get("config.network.position_max_update_rate", max_update_rate));
+        network_config->set_gain_max_update_rate(document.get("config.network.gain_max_update_rate", max_update_rate));
+        network_config->set_position_deadband(document.get("config.network.position_deadband", 0.001f));
+        network_config->set_gain_deadband(document.get("config.network.gain_deadband", 0.05f));
+        network_config->set_position_relative_deadband(document.get("config.network.position_relative_deadband", 0.0f));
+        network_config->set_gain_relative_deadband(document.get("config.network.gain_relative_deadband", 0.0f));
+        network_config->set_transport(document.get("config.network.transport", std::string("tcp")));
+        network_config->set_socket_path(document.get("config.network.socket_path", std::string("/tmp/ssr.sock")));
+
+        metrics_file            = document.get("config.metrics.file", std::string(""));
+        metrics_interval_in_sec = document.get("config.metrics.interval", 10u);
+
     } catch (const boost::property_tree::xml_parser::xml_parser_error& e) {
-        SSR::Logger::get_instance()->log(SSR::Logger::Level::ERROR, e.what(), true);
+        SSR::Logger::get_instance()->log(SSR::Logger::Level::error, e.what(), true);
     }
 
 }
@@ -63,11 +80,22 @@ void SSR::Config::write_config_xml_file()
     document.put("config.network.host", network_config->get_hostname());
     document.put("config.network.port", network_config->get_port());
     document.put("config.network.timeout", network_config->get_timeout());
+    document.put("config.network.max_update_rate", network_config->get_max_update_rate());
+    document.put("config.network.position_deadband", network_config->get_position_deadband());
+    document.put("config.network.gain_deadband", network_config->get_gain_deadband());
+    document.put("config.network.position_max_update_rate", network_config->get_position_max_update_rate());
+    document.put("config.network.gain_max_update_rate", network_config->get_gain_max_update_rate());
+    document.put("config.network.position_relative_deadband", network_config->get_position_relative_deadband());
+    document.put("config.network.gain_relative_deadband", network_config->get_gain_relative_deadband());
+    document.put("config.network.transport", network_config->get_transport());
+    document.put("config.network.socket_path", network_config->get_socket_path());
+    document.put("config.metrics.file", metrics_file);
+    document.put("config.metrics.interval", metrics_interval_in_sec);
 
     try {
         boost::property_tree::write_xml(config_file.generic_string(), document);
     } catch (const boost::property_tree::xml_parser::xml_parser_error& e) {
-        SSR::Logger::get_instance()->log(SSR::Logger::Level::ERROR, e.what(), true);
+        SSR::Logger::get_instance()->log(SSR::Logger::Level::error, e.what(), true);
     }
 
 }
@@ -82,6 +110,16 @@ boost::filesystem::path SSR::Config::get_config_file_path() const
   return config_file;
 }
 
+std::string SSR::Config::get_metrics_file() const
+{
+    return metrics_file;
+}
+
+unsigned int SSR::Config::get_metrics_interval() const
+{
+    return metrics_interval_in_sec;
+}
+
 void SSR::Config::set_hostname(const std::string new_hostname)
 {
     network_config->set_hostname(new_hostname);
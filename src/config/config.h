@@ -94,6 +94,22 @@ namespace SSR
          */
         boost::filesystem::path get_config_file_path() const;
 
+        /**
+         * Getter for the file the metrics are exported to
+         * (config.metrics.file).
+         *
+         * @return the path of the metrics file, empty if the export is off.
+         */
+        std::string get_metrics_file() const;
+
+        /**
+         * Getter for the time between two metrics exports
+         * (config.metrics.interval).
+         *
+         * @return the export interval in seconds.
+         */
+        unsigned int get_metrics_interval() const;
+
         /**
          * Setter for the hostname.
          *
@@ -151,6 +167,16 @@ namespace SSR
          */
         std::unique_ptr<SSR::Network_config> network_config;
 
+        /**
+         * The file the metrics are exported to, empty if the export is off.
+         */
+        std::string metrics_file;
+
+        /**
+         * The time between two metrics exports in seconds.
+         */
+        unsigned int metrics_interval_in_sec;
+
         /**
          * The config file location including the direcotry and filename.
          */
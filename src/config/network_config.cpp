@@ -21,6 +21,15 @@ SSR::Network_config::Network_config()
         , port(4711)
         , timeout_in_ms(1000)
         , end_of_message('\0')
+        , max_update_rate_in_hz(100)
+        , position_deadband(0.001f)
+        , gain_deadband_in_db(0.05f)
+        , position_max_update_rate_in_hz(100)
+        , gain_max_update_rate_in_hz(100)
+        , position_relative_deadband(0.0f)
+        , gain_relative_deadband(0.0f)
+        , transport("tcp")
+        , socket_path("/tmp/ssr.sock")
 {
 
 }
@@ -30,6 +39,15 @@ SSR::Network_config::Network_config(std::string hostname, unsigned int port, uns
 , port(port)
 , timeout_in_ms(timeout_in_ms)
 , end_of_message(end_of_message)
+, max_update_rate_in_hz(100)
+, position_deadband(0.001f)
+, gain_deadband_in_db(0.05f)
+, position_max_update_rate_in_hz(100)
+, gain_max_update_rate_in_hz(100)
+, position_relative_deadband(0.0f)
+, gain_relative_deadband(0.0f)
+, transport("tcp")
+, socket_path("/tmp/ssr.sock")
 {
 
 }
@@ -59,6 +77,51 @@ void SSR::Network_config::set_end_of_message(char new_end_of_message)
     end_of_message = new_end_of_message;
 }
 
+void SSR::Network_config::set_max_update_rate(const unsigned int new_max_update_rate_in_hz)
+{
+    max_update_rate_in_hz = new_max_update_rate_in_hz;
+}
+
+void SSR::Network_config::set_position_deadband(const float new_position_deadband)
+{
+    position_deadband = new_position_deadband;
+}
+
+void SSR::Network_config::set_gain_deadband(const float new_gain_deadband_in_db)
+{
+    gain_deadband_in_db = new_gain_deadband_in_db;
+}
+
+void SSR::Network_config::set_position_max_update_rate(const unsigned int new_max_update_rate_in_hz)
+{
+    position_max_update_rate_in_hz = new_max_update_rate_in_hz;
+}
+
+void SSR::Network_config::set_gain_max_update_rate(const unsigned int new_max_update_rate_in_hz)
+{
+    gain_max_update_rate_in_hz = new_max_update_rate_in_hz;
+}
+
+void SSR::Network_config::set_position_relative_deadband(const float new_relative_deadband)
+{
+    position_relative_deadband = new_relative_deadband;
+}
+
+void SSR::Network_config::set_gain_relative_deadband(const float new_relative_deadband)
+{
+    gain_relative_deadband = new_relative_deadband;
+}
+
+void SSR::Network_config::set_transport(const std::string new_transport)
+{
+    transport = new_transport;
+}
+
+void SSR::Network_config::set_socket_path(const std::string new_socket_path)
+{
+    socket_path = new_socket_path;
+}
+
 std::string SSR::Network_config::get_hostname() const
 {
     return hostname;
@@ -79,6 +142,51 @@ char SSR::Network_config::get_end_of_message() const
     return end_of_message;
 }
 
+unsigned int SSR::Network_config::get_max_update_rate() const
+{
+    return max_update_rate_in_hz;
+}
+
+float SSR::Network_config::get_position_deadband() const
+{
+    return position_deadband;
+}
+
+float SSR::Network_config::get_gain_deadband() const
+{
+    return gain_deadband_in_db;
+}
+
+unsigned int SSR::Network_config::get_position_max_update_rate() const
+{
+    return position_max_update_rate_in_hz;
+}
+
+unsigned int SSR::Network_config::get_gain_max_update_rate() const
+{
+    return gain_max_update_rate_in_hz;
+}
+
+float SSR::Network_config::get_position_relative_deadband() const
+{
+    return position_relative_deadband;
+}
+
+float SSR::Network_config::get_gain_relative_deadband() const
+{
+    return gain_relative_deadband;
+}
+
+std::string SSR::Network_config::get_transport() const
+{
+    return transport;
+}
+
+std::string SSR::Network_config::get_socket_path() const
+{
+    return socket_path;
+}
+
 std::ostream& operator<<(std::ostream& stream, const SSR::Network_config& network_config)
 {
     std::stringstream ss;
@@ -87,5 +195,14 @@ std::ostream& operator<<(std::ostream& stream, const SSR::Network_config& networ
     ss << "Port: " << network_config.get_port() << std::endl;
     ss << "Timeout: " << network_config.get_timeout() << std::endl;
     ss << "End of Message: " << network_config.get_end_of_message() << std::endl;
+    ss << "Max Update Rate: " << network_config.get_max_update_rate() << std::endl;
+    ss << "Position Deadband: " << network_config.get_position_deadband() << std::endl;
+    ss << "Gain Deadband: " << network_config.get_gain_deadband() << std::endl;
+    ss << "Position Max Update Rate: " << network_config.get_position_max_update_rate() << std::endl;
+    ss << "Gain Max Update Rate: " << network_config.get_gain_max_update_rate() << std::endl;
+    ss << "Position Relative Deadband: " << network_config.get_position_relative_deadband() << std::endl;
+    ss << "Gain Relative Deadband: " << network_config.get_gain_relative_deadband() << std::endl;
+    ss << "Transport: " << network_config.get_transport() << std::endl;
+    ss << "Socket Path: " << network_config.get_socket_path() << std::endl;
     return stream << ss.str();
 }
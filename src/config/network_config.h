@@ -32,6 +32,15 @@ namespace SSR
     * - the character that determines the end of a message that is incoming
     *   from and outgoing to the SSR
     *
+    * And the send filter for continuous parameters:
+    *
+    * - the maximum rate in Hz at which one parameter is sent to the SSR,
+    *   separately for the source position and the source gain
+    * - the absolute deadband of the source position in meters and of the
+    *   source gain in dB
+    * - the relative deadband of the source position and of the source gain,
+    *   a fraction of the last sent value
+    *
     * @since 2015-08-03
     * @author Florian Willich
     */
@@ -47,6 +56,13 @@ namespace SSR
         * - port: 4711
         * - timeout_in_ms: 1000
         * - end_of_message: '\0'
+        * - max_update_rate_in_hz: 100
+        * - position_max_update_rate_in_hz: 100
+        * - gain_max_update_rate_in_hz: 100
+        * - position_deadband: 0.001
+        * - gain_deadband_in_db: 0.05
+        * - position_relative_deadband: 0
+        * - gain_relative_deadband: 0
         *
         * @author Florian Willich
         */
@@ -124,6 +140,87 @@ namespace SSR
         */
         void set_end_of_message(char new_end_of_message);
 
+        /**
+        * Setter for the maximum rate in Hz at which one continuous parameter
+        * is sent to the SSR.
+        *
+        * @param       new_max_update_rate_in_hz       The maximum rate, 0
+        *                                              disables the rate cap.
+        */
+        void set_max_update_rate(const unsigned int new_max_update_rate_in_hz);
+
+        /**
+        * Setter for the minimum change in meters of a source position before
+        * it is sent to the SSR.
+        *
+        * @param       new_position_deadband   The deadband in meters, 0
+        *                                      disables the deadband.
+        */
+        void set_position_deadband(const float new_position_deadband);
+
+        /**
+        * Setter for the minimum change in dB of a source gain before it is
+        * sent to the SSR.
+        *
+        * @param       new_gain_deadband_in_db The deadband in dB, 0 disables
+        *                                      the deadband.
+        */
+        void set_gain_deadband(const float new_gain_deadband_in_db);
+
+        /**
+        * Setter for the maximum rate in Hz at which the position of one
+        * source is sent to the SSR.
+        *
+        * @param       new_max_update_rate_in_hz       The maximum rate, 0
+        *                                              disables the rate cap.
+        */
+        void set_position_max_update_rate(const unsigned int new_max_update_rate_in_hz);
+
+        /**
+        * Setter for the maximum rate in Hz at which the gain of one source is
+        * sent to the SSR.
+        *
+        * @param       new_max_update_rate_in_hz       The maximum rate, 0
+        *                                              disables the rate cap.
+        */
+        void set_gain_max_update_rate(const unsigned int new_max_update_rate_in_hz);
+
+        /**
+        * Setter for the minimum change of a source position, as a fraction of
+        * the distance of the last sent position to the origin, before it is
+        * sent to the SSR.
+        *
+        * @param       new_relative_deadband   The fraction, 0 disables the
+        *                                      relative deadband.
+        */
+        void set_position_relative_deadband(const float new_relative_deadband);
+
+        /**
+        * Setter for the minimum change of a source gain, as a fraction of the
+        * last sent gain in dB, before it is sent to the SSR.
+        *
+        * @param       new_relative_deadband   The fraction, 0 disables the
+        *                                      relative deadband.
+        */
+        void set_gain_relative_deadband(const float new_relative_deadband);
+
+        /**
+        * Setter for the transport of the connection to the SSR: "tcp" for
+        * TCP/IP to hostname and port or "unix" for the Unix domain socket at
+        * the socket path.
+        *
+        * @param       new_transport           The new transport.
+        */
+        void set_transport(const std::string new_transport);
+
+        /**
+        * Setter for the path of the Unix domain socket, used if the transport
+        * is "unix".
+        *
+        * @param       new_socket_path         The new socket path.
+        */
+        void set_socket_path(const std::string new_socket_path);
+
         /**
         * Returns the hostname of the machine where the SSR is executed on.
         *
@@ -164,6 +261,74 @@ namespace SSR
         */
         char get_end_of_message() const;
 
+        /**
+        * Returns the maximum rate in Hz at which one continuous parameter is
+        * sent to the SSR.
+        *
+        * @return the maximum rate in Hz, 0 if the rate cap is disabled.
+        */
+        unsigned int get_max_update_rate() const;
+
+        /**
+        * Returns the minimum change in meters of a source position before it
+        * is sent to the SSR.
+        *
+        * @return the position deadband in meters.
+        */
+        float get_position_deadband() const;
+
+        /**
+        * Returns the minimum change in dB of a source gain before it is sent
+        * to the SSR.
+        *
+        * @return the gain deadband in dB.
+        */
+        float get_gain_deadband() const;
+
+        /**
+        * Returns the maximum rate in Hz at which the position of one source
+        * is sent to the SSR.
+        *
+        * @return the maximum rate in Hz, 0 if the rate cap is disabled.
+        */
+        unsigned int get_position_max_update_rate() const;
+
+        /**
+        * Returns the maximum rate in Hz at which the gain of one source is
+        * sent to the SSR.
+        *
+        * @return the maximum rate in Hz, 0 if the rate cap is disabled.
+        */
+        unsigned int get_gain_max_update_rate() const;
+
+        /**
+        * Returns the relative deadband of the source position.
+        *
+        * @return the fraction of the last sent position.
+        */
+        float get_position_relative_deadband() const;
+
+        /**
+        * Returns the relative deadband of the source gain.
+        *
+        * @return the fraction of the last sent gain in dB.
+        */
+        float get_gain_relative_deadband() const;
+
+        /**
+        * Returns the transport of the connection to the SSR.
+        *
+        * @return "tcp" or "unix".
+        */
+        std::string get_transport() const;
+
+        /**
+        * Returns the path of the Unix domain socket.
+        *
+        * @return the path of the Unix domain socket.
+        */
+        std::string get_socket_path() const;
+
     private:
         
         /**
@@ -188,6 +353,58 @@ namespace SSR
         */
         char end_of_message;
 
+        /**
+        * The maximum rate in Hz at which one continuous parameter is sent to
+        * the SSR.
+        */
+        unsigned int max_update_rate_in_hz;
+
+        /**
+        * The minimum change in meters of a source position before it is sent
+        * to the SSR.
+        */
+        float position_deadband;
+
+        /**
+        * The minimum change in dB of a source gain before it is sent to the
+        * SSR.
+        */
+        float gain_deadband_in_db;
+
+        /**
+        * The maximum rate in Hz at which the position of one source is sent
+        * to the SSR.
+        */
+        unsigned int position_max_update_rate_in_hz;
+
+        /**
+        * The maximum rate in Hz at which the gain of one source is sent to
+        * the SSR.
+        */
+        unsigned int gain_max_update_rate_in_hz;
+
+        /**
+        * The minimum change of a source position as a fraction of the last
+        * sent position.
+        */
+        float position_relative_deadband;
+
+        /**
+        * The minimum change of a source gain as a fraction of the last sent
+        * gain in dB.
+        */
+        float gain_relative_deadband;
+
+        /**
+        * The transport of the connection to the SSR, "tcp" or "unix".
+        */
+        std::string transport;
+
+        /**
+        * The path of the Unix domain socket.
+        */
+        std::string socket_path;
+
     };
 
 }
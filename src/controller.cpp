@@ -13,6 +13,7 @@
 #include <src/controller.h>
  
 //C++ Libs
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <cmath>
@@ -20,6 +21,8 @@
 #include <memory>
 #include <stdexcept>
 #include <map>
+#include <sstream>
+#include <utility>
 
 //JUCE Lib
 #include <JUCE/JuceHeader.h>
@@ -27,16 +30,31 @@
 //Own Libs
 #include <src/utils/jack_client.h>
 #include <src/utils/tcp_connection.h>
-#include <src/utils/ssr_requester.h>
+#include <src/utils/unix_connection.h>
+#include <src/utils/network_thread.h>
+#include <src/utils/startup_thread.h>
+#include <src/utils/connection_state.h>
+#include <src/utils/outbound_update.h>
+#include <src/utils/send_rate_limiter.h>
+#include <src/utils/host_clock.h>
+#include <src/utils/metrics.h>
+#include <src/utils/metrics_exporter.h>
+#include <src/parameter/parameter_bank.h>
+#include <src/parameter/host_parameters.h>
+#include <src/trajectory/trajectory.h>
+#include <src/trajectory/trajectory_engine.h>
+#include <src/utils/state_stream.h>
 #include <src/utils/helper.h>
 #include <src/utils/update_specificator.h>
 #include <src/config/config.h>
 #include <src/GUI/main_gui_component.h>
 #include <src/scene/scene.h>
 #include <src/scene/source.h>
+#include <src/scene/parameter_translation_functions.h>
 #include <src/controller.h>
 #include <src/utils/random_machine.h>
 #include <src/utils/logger.h>
+#include <src/utils/rt_guard.h>
 
 //Boost Libs
 #include <boost/filesystem.hpp>
@@ -63,40 +81,56 @@ AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 }
 
 Controller::Controller()
-  : ui_update_flag(true)
-  , tcp_connection(nullptr)
-  , message_to_ssr(new std::string(""))
-  , message_from_ssr(new std::string(""))
+  : ui_updater(nullptr)
+  , ui_connection_state(SSR::Connection_state::disconnected)
+  , ui_jack_ports_version(0)
+  , network_thread(new SSR::Network_thread())
+  , inbound_updates()
   , jack_client(new SSR::Jack_client())
-  , requester(new SSR::SSR_requester())
+  , send_rate_limiter(new SSR::Send_rate_limiter(2 * (SSR::Parameter_bank::selected_slot + 1)))
+  , parameter_bank(new SSR::Parameter_bank())
+  , host_parameters(new SSR::Host_parameters())
+  , trajectory_engine(new SSR::Trajectory_engine())
+  , host_clock(new SSR::Host_clock())
+  , play_head_time_in_seconds(0.0)
+  , trajectory_positions()
+  , recorded_keyframes()
   , config(nullptr)
+  , metrics_exporter(new SSR::Metrics_exporter())
   , scene(new SSR::Scene(20.0f))
+  , connect_lock()
+  , startup_thread(nullptr)
 {
-  SSR::Logger::get_instance()->log(SSR::Logger::Level::INFO, "Constructor of Controller was called!", false);
-  SSR::Logger::get_instance()->log(SSR::Logger::Level::INFO, "Build: 6", false);
+  SSR::Logger::get_instance()->log(SSR::Logger::Level::info, "Constructor of Controller was called!", false);
+  SSR::Logger::get_instance()->log(SSR::Logger::Level::info, "Build: 6", false);
 
   boost::filesystem::path config_file = get_config_file_path();
   config = std::unique_ptr<SSR::Config>(new SSR::Config(config_file));
-  config->load_config_xml_file();
 
-  connect();
+  // Loading the config, connecting and the JACK registration may take
+  // seconds, so they must not delay the host.
+  startup_thread = std::unique_ptr<SSR::Startup_thread>(new SSR::Startup_thread([this]() {
+    connect();
+    register_jack_client();
+  }));
 
-  const char* jack_client_name = JucePlugin_Name;
+  startup_thread->startThread();
 
-  try {
-      jack_client->register_client(jack_client_name);
-  } catch (SSR::jack_server_not_running_exception& jsnre) {
-      SSR::Logger::get_instance()->log(SSR::Logger::Level::ERROR, jsnre.what(), LOG_TO_FILE);
-  } catch (std::exception& e) {
-      SSR::Logger::get_instance()->log(SSR::Logger::Level::ERROR, e.what(), LOG_TO_FILE);
-  }
-
-  read_ssr_incoming_message();
+  publish_host_parameters();
+  startTimer(20);
 }
 
 Controller::~Controller()
 {
+  stopTimer();
 
+  startup_thread = nullptr;
+
+  std::stringstream summary;
+  summary << "Send rate limiter suppressed " << get_updates_suppressed_by_rate() << " updates by rate and "
+          << get_updates_suppressed_by_deadband() << " updates by deadband";
+
+  SSR::Logger::get_instance()->log(SSR::Logger::Level::info, summary.str(), LOG_TO_FILE);
 }
 
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -110,7 +144,8 @@ const juce::String Controller::getName() const
 
 void Controller::prepareToPlay(double sampleRate, int estimatedSamplesPerBlock)
 {
-
+  trajectory_engine->prepare(sampleRate);
+  host_clock->prepare(sampleRate);
 }
 
 void Controller::releaseResources()
@@ -120,7 +155,40 @@ void Controller::releaseResources()
 
 void Controller::processBlock (AudioSampleBuffer& buffer, MidiBuffer& midiMessages)
 {
+  SSR_RT_SCOPE("Controller::processBlock");
+
+  AudioPlayHead* play_head = getPlayHead();
+  AudioPlayHead::CurrentPositionInfo position_info;
+
+  if (play_head == nullptr || !play_head->getCurrentPosition(position_info)) {
+      host_clock->stop();
+      return;
+  }
+
+  play_head_time_in_seconds.store(position_info.timeInSeconds, std::memory_order_relaxed);
+
+  if (!position_info.isPlaying) {
+      host_clock->stop();
+      return;
+  }
 
+  host_clock->start_block(position_info.timeInSamples, buffer.getNumSamples(), !isNonRealtime(), juce::Time::getMillisecondCounterHiRes());
+
+  const SSR::Trajectory_engine::Position* positions = nullptr;
+  const std::size_t count = trajectory_engine->process(position_info.timeInSeconds, buffer.getNumSamples(), positions);
+
+  for (std::size_t i = 0; i < count; i++) {
+
+      SSR::Outbound_update update;
+      update.changed = SSR::Update_specificator(SSR::Update_specificator::position);
+      update.source_id = positions[i].source_id;
+      update.x_position = positions[i].x;
+      update.y_position = positions[i].y;
+      update.stamp = host_clock->stamp_block(0);
+
+      network_thread->push_audio_update(update);
+      SSR::Metrics::get_instance().add(SSR::Metrics::outbound_updates);
+  }
 }
 
 const juce::String Controller::getInputChannelName(int channelIndex) const
@@ -182,188 +250,75 @@ bool Controller::hasEditor() const
 }
 
 int Controller::getNumParameters() {
-  return SSR::Source::parameter::parameter_count;
+  return SSR::Parameter_bank::parameter_count;
 }
 
 const juce::String Controller::getParameterName(int parameterIndex)
 {
-  typedef SSR::Source::parameter source_parameter;
-
-  std::string parameter_name = "No Name Specified";
-
-  switch (parameterIndex)
-  {
-    case source_parameter::x_position_idx:
-      parameter_name = scene->get_x_position_of_selected_source().get_name();
-      break;
-
-    case source_parameter::y_position_idx:
-      parameter_name = scene->get_y_position_of_selected_source().get_name();
-      break;
-
-    case source_parameter::gain_idx:
-      parameter_name = scene->get_gain_of_selected_source().get_name();
-      break;
-
-    case source_parameter::orientation_idx:
-      parameter_name = scene->get_orientation_of_selected_source().get_name();
-      break;
-
-    case source_parameter::mute_idx:
-      parameter_name = scene->get_mute_of_selected_source().get_name();
-      break;
-
-    case source_parameter::model_point_idx:
-      parameter_name = scene->get_model_point_of_selected_source().get_name();
-      break;
-
-    case source_parameter::fixed_idx:
-      parameter_name = scene->get_fixed_of_selected_source().get_name();
-      break;
-
-    default:
-      break;
-
-  }
-
-  return juce::String(parameter_name);
+  return juce::String(parameter_bank->get_name(parameterIndex));
 }
 
 float Controller::getParameter(int index)
 {
-  typedef SSR::Source::parameter source_parameter;
-
-  float parameter_as_float = 0.0f;
-
-  switch (index)
-  {
-    case source_parameter::x_position_idx:
-      parameter_as_float = scene->get_x_position_of_selected_source().get_continuous_value();
-      break;
-
-    case source_parameter::y_position_idx:
-      parameter_as_float = scene->get_y_position_of_selected_source().get_continuous_value();
-      break;
-
-    case source_parameter::gain_idx:
-      parameter_as_float = scene->get_gain_of_selected_source().get_continuous_value();
-      break;
-
-    case source_parameter::orientation_idx:
-      parameter_as_float = scene->get_orientation_of_selected_source().get_continuous_value();
-      break;
-
-    case source_parameter::mute_idx:
-      parameter_as_float = scene->get_mute_of_selected_source().get_continuous_value();
-      break;
-
-    case source_parameter::model_point_idx:
-      parameter_as_float = scene->get_model_point_of_selected_source().get_continuous_value();
-      break;
-
-    case source_parameter::fixed_idx:
-      parameter_as_float = scene->get_fixed_of_selected_source().get_continuous_value();
-      break;
-
-    default:
-      break;
+  SSR::Parameter_bank::Address address;
 
+  if (!parameter_bank->look_up(index, address)) {
+      return 0.0f;
   }
 
-  return parameter_as_float;
+  return host_parameters->get_value(index);
 }
 
 const juce::String Controller::getParameterText(int index)
 {
-  typedef SSR::Source::parameter source_parameter;
-
-  std::string parameter_text = "0.0";
-
-  switch (index)
-  {
-    case source_parameter::x_position_idx:
-      parameter_text = scene->get_x_position_of_selected_source().get_continuous_value();
-      break;
-
-    case source_parameter::y_position_idx:
-      parameter_text = scene->get_y_position_of_selected_source().get_continuous_value();
-      break;
-
-    case source_parameter::gain_idx:
-      parameter_text = scene->get_gain_of_selected_source().get_continuous_value();
-      break;
-
-    case source_parameter::orientation_idx:
-      parameter_text = scene->get_orientation_of_selected_source().get_continuous_value();
-      break;
-
-    case source_parameter::mute_idx:
-      parameter_text = scene->get_mute_of_selected_source().get_continuous_value();
-      break;
-
-    case source_parameter::model_point_idx:
-      parameter_text = scene->get_model_point_of_selected_source().get_continuous_value();
-      break;
-
-    case source_parameter::fixed_idx:
-      parameter_text = scene->get_fixed_of_selected_source().get_continuous_value();
-      break;
-
-    default:
-      break;
+  SSR::Parameter_bank::Address address;
 
+  if (!parameter_bank->look_up(index, address)) {
+      return juce::String("0.0");
   }
 
-  return juce::String(parameter_text);
+  return juce::String(getParameter(index));
 }
 
 void Controller::setParameter(int parameterIndex, float newValue)
 {
+  SSR_RT_SCOPE("Controller::setParameter");
+
   typedef SSR::Source::parameter source_parameter;
   typedef SSR::Update_specificator::Specificators update_specificators;
 
-  SSR::Update_specificator specificator { update_specificators::position };
-
-  switch (parameterIndex)
-  {
-    case source_parameter::x_position_idx:
-      scene->set_x_position_continuous_of_selected_source(newValue);
-      break;
-
-    case source_parameter::y_position_idx:
-      scene->set_y_position_continuous_of_selected_source(newValue);
-      break;
-
-    case source_parameter::gain_idx:
-      scene->set_gain_continuous_of_selected_source(newValue);
-      specificator = update_specificators::gain;
-      break;
-
-    case source_parameter::orientation_idx:
-      //TODO: Not possible for now!
-      break;
-
-    case source_parameter::mute_idx:
-      scene->set_mute_continuous_of_selected_source(newValue);
-      specificator = update_specificators::mute;
-      break;
-
-    case source_parameter::model_point_idx:
-      scene->set_model_point_continuous_of_selected_source(newValue);
-      specificator = update_specificators::model;
-      break;
+  // The update of every source parameter, indexed by field. The orientation
+  // has no update since setting it is not possible for now.
+  static const SSR::Update_specificator field_updates[source_parameter::parameter_count] = {
+    update_specificators::position,
+    update_specificators::position,
+    update_specificators::gain,
+    SSR::Update_specificator(),
+    update_specificators::mute,
+    update_specificators::model,
+    update_specificators::fixed
+  };
+
+  SSR::Parameter_bank::Address address;
+
+  if (!parameter_bank->look_up(parameterIndex, address) || field_updates[address.field].empty()) {
+      return;
+  }
 
-    case source_parameter::fixed_idx:
-      scene->set_fixed_continuous_of_selected_source(newValue);
-      specificator = update_specificators::fixed;
-      break;
+  // The Scene belongs to the message thread, which applies the value in
+  // timerCallback().
+  const unsigned int source_id = host_parameters->get_source_id(address.slot);
 
-    default:
-      break;
+  if (source_id == 0) {
+      return;
+  }
 
+  if (!host_parameters->set_value(parameterIndex, address.field, source_id, newValue)) {
+      SSR::Metrics::get_instance().add(SSR::Metrics::dropped_updates);
+      return;
   }
 
-  update_ssr(specificator);
+  update_ssr_from_host(address.slot, source_id, field_updates[address.field], host_clock->stamp_now(juce::Time::getMillisecondCounterHiRes()));
 }
 
 int Controller::getNumPrograms()
@@ -393,34 +348,14 @@ void Controller::changeProgramName(int index, const juce::String& newName)
 
 void Controller::getStateInformation(MemoryBlock& destData)
 {
-  /**
-  XmlElement root("Root");
-  std::unique_ptr<XmlElement> el(new XmlElement(""));
-
-  *el = root.createNewChildElement(juce::String(scene->get_x_position_of_selected_source().get_name()));
-  el->addTextElement(juce::String(scene->get_x_position_of_selected_source().get_continuous_value()));
-
-  *el = root.createNewChildElement(juce::String(scene->get_y_position_of_selected_source().get_name()));
-  el->addTextElement(juce::String(scene->get_y_position_of_selected_source().get_continuous_value()));
-
-  *el = root.createNewChildElement(juce::String(scene->get_gain_of_selected_source().get_name()));
-  el->addTextElement(juce::String(scene->get_gain_of_selected_source().get_continuous_value()));
-
-  *el = root.createNewChildElement(juce::String(scene->get_orientation_of_selected_source().get_name()));
-  el->addTextElement(juce::String(scene->get_orientation_of_selected_source().get_continuous_value()));
-
-  *el = root.createNewChildElement(juce::String(scene->get_mute_of_selected_source().get_name()));
-  el->addTextElement(juce::String(scene->get_mute_of_selected_source().get_continuous_value()));
+  juce::MemoryOutputStream output(destData, false);
 
-  *el = root.createNewChildElement(juce::String(scene->get_model_point_of_selected_source().get_name()));
-  el->addTextElement(juce::String(scene->get_model_point_of_selected_source().get_continuous_value()));
+  output.writeInt(static_cast<int>(SSR::state_stream::magic));
+  output.writeInt(static_cast<int>(SSR::state_stream::version));
 
-  *el = root.createNewChildElement(juce::String(scene->get_fixed_of_selected_source().get_name()));
-  el->addTextElement(juce::String(scene->get_fixed_of_selected_source().get_continuous_value()));
-
-  copyXmlToBinary(root, destData);
-
-  **/
+  scene->write_state(output);
+  parameter_bank->write_state(output);
+  trajectory_engine->write_state(output);
 }
 
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -435,242 +370,270 @@ SSR::Source Controller::get_source() const
 void Controller::set_x_position_discrete_of_selected_source(const float position)
 {
   scene->set_x_position_discrete_of_selected_source(position);
-  update_ssr(SSR::Update_specificator(SSR::Update_specificator::Specificators::position));
-  ui_update_flag = true;
+  update_ssr_rate_limited(SSR::Parameter_bank::selected_slot, SSR::Update_specificator(SSR::Update_specificator::Specificators::position));
 }
 
 void Controller::set_y_position_discrete_of_selected_source(const float position)
 {
   scene->set_y_position_discrete_of_selected_source(position);
-  update_ssr(SSR::Update_specificator(SSR::Update_specificator::Specificators::position));
-  ui_update_flag = true;
+  update_ssr_rate_limited(SSR::Parameter_bank::selected_slot, SSR::Update_specificator(SSR::Update_specificator::Specificators::position));
 }
 
 void Controller::set_gain_discrete_of_selected_source(const float gain, const bool linear)
 {
   scene->set_gain_discrete_of_selected_source(gain, linear);
-  update_ssr(SSR::Update_specificator(SSR::Update_specificator::Specificators::gain));
-  ui_update_flag = true;
+  update_ssr_rate_limited(SSR::Parameter_bank::selected_slot, SSR::Update_specificator(SSR::Update_specificator::Specificators::gain));
 }
 
 void Controller::set_mute_discrete_of_selected_source(const bool mute)
 {
   scene->set_mute_discrete_of_selected_source(mute);
   update_ssr(SSR::Update_specificator(SSR::Update_specificator::mute));
-  ui_update_flag = true;
 }
 
 void Controller::set_model_point_discrete_of_selected_source(const bool point)
 {
   scene->set_model_point_discrete_of_selected_source(point);
   update_ssr(SSR::Update_specificator(SSR::Update_specificator::model));
-  ui_update_flag = true;
 }
 
 void Controller::set_fixed_discrete_of_selected_source(const bool fixed)
 {
   scene->set_fixed_discrete_of_selected_source(fixed);
   update_ssr(SSR::Update_specificator(SSR::Update_specificator::fixed));
-  ui_update_flag = true;
 }
 
 void Controller::set_name_of_selected_source(const std::string name)
 {
   scene->set_name_of_selected_source(name);
   update_ssr(SSR::Update_specificator(SSR::Update_specificator::name));
-  ui_update_flag = true;
 }
 
 void Controller::set_properties_file_of_selected_source(const std::string value)
 {
   scene->set_properties_file_of_selected_source(value);
   update_ssr(SSR::Update_specificator(SSR::Update_specificator::properties_file));
-  ui_update_flag = true;
 }
 
 void Controller::set_jackport_of_selected_source(const std::string jackport)
 {
   scene->set_jackport_of_selected_source(jackport);
   update_ssr(SSR::Update_specificator(SSR::Update_specificator::port));
-  ui_update_flag = true;
 }
 
 bool Controller::select_source(const int id)
 {
-  return scene->select_source(id);
+  const bool selected = scene->select_source(id);
+  publish_host_parameters();
+
+  return selected;
 }
 
 void Controller::new_source()
 {
   unsigned int id = scene->new_source("Source" + SSR::Random_machine::get_instance()->generate_string(5, 'A', 'Z'));
   update_ssr(SSR::Update_specificator(SSR::Update_specificator::new_source));
-  ui_update_flag = true;
 }
 
 bool Controller::read_ssr_incoming_message()
 {
-  int wait_in_msec = 0;
-
-  bool message_incoming = false;
+  if (!network_thread->take_updates(inbound_updates)) {
+      return false;
+  }
 
-  while (tcp_connection->get_message(message_from_ssr, &wait_in_msec)) {
-      scene->interpret_xml_message(*message_from_ssr);
-      ui_update_flag = true;
-      message_incoming = true;
+  // The records of the sync only carry sources the SSR has, so dropping the
+  // others first keeps sources created right after the sync.
+  if (inbound_updates.is_sync_finished()) {
+      scene->retain_sources(inbound_updates.get_synced_source_ids());
   }
 
-  return message_incoming;
+  scene->apply_updates(inbound_updates.get_updates(), inbound_updates.get_texts());
+
+  return true;
 }
 
 void Controller::connect()
 {
+  const juce::ScopedLock scoped_lock(connect_lock);
+
   config->load_config_xml_file();
 
-  std::string hostname = config->get_network_config().get_hostname();
-  unsigned int port = config->get_network_config().get_port();
-  unsigned int timeout_in_ms = config->get_network_config().get_timeout();
+  const SSR::Network_config network_config = config->get_network_config();
+  const std::string transport = network_config.get_transport();
+
+  std::string hostname = network_config.get_hostname();
+  unsigned int port = network_config.get_port();
+  unsigned int timeout_in_ms = network_config.get_timeout();
 
-  tcp_connection = std::unique_ptr<SSR::TCP_connection>(new SSR::TCP_connection(hostname, port, timeout_in_ms, '\0'));
+  configure_send_rate_limiter();
+  metrics_exporter->configure(config->get_metrics_file(), config->get_metrics_interval());
 
-  tcp_connection->connect();
+  std::unique_ptr<SSR::IConnection> connection;
+
+  if (transport == "unix") {
+      connection.reset(new SSR::Unix_connection(network_config.get_socket_path(), timeout_in_ms, '\0'));
+  } else {
+
+      if (transport != "tcp") {
+          SSR::Logger::get_instance()->log(SSR::Logger::Level::error, "Unknown transport '" + transport + "', using tcp", LOG_TO_FILE);
+      }
+
+      connection.reset(new SSR::TCP_connection(hostname, port, timeout_in_ms, '\0'));
+  }
+
+  network_thread->set_connection(std::move(connection));
 }
 
 bool Controller::is_connected_to_ssr() const
 {
-  return tcp_connection->is_connected();
+  return network_thread->is_connected();
 }
 
-bool Controller::ui_needs_update() const
+SSR::Connection_state Controller::get_connection_state() const
 {
-  return ui_update_flag;
+  const SSR::Connection_state state = network_thread->get_state();
+
+  if (state == SSR::Connection_state::disconnected && !startup_thread->is_done()) {
+      return SSR::Connection_state::connecting;
+  }
+
+  return state;
 }
 
-void Controller::ui_request_update()
+void Controller::ui_set_updater(juce::AsyncUpdater* updater)
 {
-  ui_update_flag = true;
+  ui_updater = updater;
 }
 
-void Controller::ui_clear_update_flag()
+unsigned int Controller::ui_take_changes()
 {
-  ui_update_flag = false;
+  return scene->take_changes();
 }
 
-std::vector<std::string> Controller::get_all_jack_ports(const unsigned long flags)
+std::shared_ptr<const SSR::Jack_port_snapshot> Controller::get_jack_ports() const
 {
-  std::vector<std::string> available_jack_ports;
-  available_jack_ports.push_back(std::string("No Jackport available."));
-
-  try {
-      available_jack_ports = jack_client->look_up_jack_ports(flags);
-  } catch (SSR::jack_server_not_running_exception& jsnre) {
-      SSR::Logger::get_instance()->log(SSR::Logger::Level::ERROR, jsnre.what(), LOG_TO_FILE);
-  } catch (std::exception& e) {
-      SSR::Logger::get_instance()->log(SSR::Logger::Level::ERROR, e.what(), LOG_TO_FILE);
-  }
-
-  return available_jack_ports;
+  return jack_client->get_output_ports();
 }
 
 void Controller::update_ssr(SSR::Update_specificator specificator)
 {
+  update_ssr_of_source(scene->get_id_of_selected_source(), specificator);
+}
+
+void Controller::update_ssr_of_source(const unsigned int source_id, SSR::Update_specificator specificator, const SSR::Host_stamp& stamp)
+{
+  typedef SSR::Update_specificator::Specificators specificators;
 
-  switch (specificator.get_spec()) {
+  const SSR::Source* source = scene->get_source(source_id);
 
-    case SSR::Update_specificator::Specificators::gain:
+  if (source == nullptr) {
+      return;
+  }
 
+  SSR::Outbound_update update;
+  update.changed = specificator;
+  update.source_id = source_id;
+  update.stamp = stamp;
+
+  const bool new_source = specificator.contains(specificators::new_source);
+
+  if (specificator.contains(specificators::gain)) {
       //Importtant: Source Gain param is stored as linear value, so it has to be
       //converted to dB befor sending a request to change it
-      *message_to_ssr = requester->build(std::bind(
-          SSR::request::source_gain,
-          std::placeholders::_1,
-          scene->get_id_of_selected_source(),
-          SSR::helper::linear_to_dB(scene->get_gain_of_selected_source().get_discrete_value())
-      ));
-      break;
-
-    case SSR::Update_specificator::Specificators::position:
-      *message_to_ssr = requester->build(std::bind(
-          SSR::request::source_position,
-          std::placeholders::_1,
-          scene->get_id_of_selected_source(),
-          scene->get_x_position_of_selected_source().get_discrete_value(),
-          scene->get_y_position_of_selected_source().get_discrete_value()
-      ));
-      break;
-
-    case SSR::Update_specificator::Specificators::mute:
-      *message_to_ssr = requester->build(std::bind(
-          SSR::request::source_mute,
-          std::placeholders::_1,
-          scene->get_id_of_selected_source(),
-          scene->get_mute_of_selected_source().get_discrete_value()
-      ));
-      break;
-
-    case SSR::Update_specificator::Specificators::fixed:
-      *message_to_ssr = requester->build(std::bind(
-          SSR::request::source_fixed,
-          std::placeholders::_1,
-          scene->get_id_of_selected_source(),
-          scene->get_fixed_of_selected_source().get_discrete_value()
-      ));
-      break;
-
-    case SSR::Update_specificator::Specificators::model:
-
-      *message_to_ssr = requester->build(std::bind(
-          SSR::request::source_model,
-          std::placeholders::_1,
-          scene->get_id_of_selected_source(),
-          scene->get_model_point_of_selected_source().get_discrete_value() ? "point" : "plane"
-      ));
-      break;
-
-    case SSR::Update_specificator::Specificators::name:
-
-      *message_to_ssr = requester->build(std::bind(
-          SSR::request::source_name,
-          std::placeholders::_1,
-          scene->get_id_of_selected_source(),
-          scene->get_name_of_selected_source()
-      ));
-      break;
-
-    case SSR::Update_specificator::Specificators::properties_file:
-      *message_to_ssr = requester->build(std::bind(
-          SSR::request::source_properties_file,
-          std::placeholders::_1,
-          scene->get_id_of_selected_source(),
-          scene->get_properties_file_of_selected_source()
-      ));
-      break;
-
-    case SSR::Update_specificator::Specificators::port:
-      *message_to_ssr = requester->build(std::bind(
-          SSR::request::source_port,
-          std::placeholders::_1,
-          scene->get_id_of_selected_source(),
-          scene->get_jackport_of_selected_source()
-      ));
-      break;
-
-    case SSR::Update_specificator::Specificators::new_source:
-      *message_to_ssr = requester->build(std::bind(
-          SSR::request::new_source,
-          std::placeholders::_1,
-          scene->get_name_of_selected_source(),
-          scene->get_jackport_of_selected_source(),
-          scene->get_x_position_of_selected_source().get_discrete_value(),
-          scene->get_y_position_of_selected_source().get_discrete_value()
-      ));
-      break;
-
-    default:
-      break;
-
-  }
-
-  send_message_to_ssr();
+      update.gain_in_db = SSR::helper::linear_to_dB(source->get_gain().get_discrete_value());
+  }
+
+  if (specificator.contains(specificators::position) || new_source) {
+      update.x_position = source->get_x_position().get_discrete_value();
+      update.y_position = source->get_y_position().get_discrete_value();
+  }
+
+  if (specificator.contains(specificators::mute)) {
+      update.mute = source->get_mute().get_discrete_value();
+  }
+
+  if (specificator.contains(specificators::fixed)) {
+      update.fixed = source->get_fixed().get_discrete_value();
+  }
+
+  if (specificator.contains(specificators::model)) {
+      update.model_point = source->get_model_point().get_discrete_value();
+  }
+
+  if (specificator.contains(specificators::name) || new_source) {
+      SSR::set_text(update.name, source->get_name());
+  }
+
+  if (specificator.contains(specificators::properties_file)) {
+      SSR::set_text(update.properties_file, source->get_properties_file());
+  }
+
+  if (specificator.contains(specificators::port) || new_source) {
+      SSR::set_text(update.port, source->get_jackport());
+  }
+
+  network_thread->push_update(update);
+  SSR::Metrics::get_instance().add(SSR::Metrics::outbound_updates);
+}
+
+void Controller::clear_trajectory_of_selected_source()
+{
+  const unsigned int source_id = scene->get_id_of_selected_source();
+
+  trajectory_engine->remove_trajectory(source_id);
+  recorded_keyframes.erase(source_id);
+}
+
+bool Controller::add_keyframe_to_selected_source(const SSR::Trajectory::Shape shape)
+{
+  const unsigned int source_id = scene->get_id_of_selected_source();
+  const SSR::Source* source = scene->get_source(source_id);
+
+  if (source == nullptr) {
+      return false;
+  }
+
+  SSR::Trajectory::Keyframe keyframe;
+  keyframe.time_in_seconds = play_head_time_in_seconds.load(std::memory_order_relaxed);
+  keyframe.x = source->get_x_position().get_discrete_value();
+  keyframe.y = source->get_y_position().get_discrete_value();
+
+  recorded_keyframes_of(source_id).push_back(keyframe);
+
+  return assign_recorded_trajectory(source_id, shape);
+}
+
+bool Controller::set_trajectory_shape_of_selected_source(const SSR::Trajectory::Shape shape)
+{
+  return assign_recorded_trajectory(scene->get_id_of_selected_source(), shape);
+}
+
+bool Controller::get_trajectory_shape_of_selected_source(SSR::Trajectory::Shape& shape) const
+{
+  const unsigned int source_id = scene->get_id_of_selected_source();
+
+  for (const auto& source_and_trajectory : trajectory_engine->get_trajectories()) {
+
+      if (source_and_trajectory.first == source_id) {
+          shape = source_and_trajectory.second.get_shape();
+          return true;
+      }
+
+  }
+
+  return false;
+}
+
+void Controller::bind_slot_to_source(const std::size_t slot, const unsigned int source_id)
+{
+  parameter_bank->bind_slot(slot, source_id);
+  publish_host_parameters();
+  updateHostDisplay();
+}
+
+unsigned int Controller::get_source_id_of_slot(const std::size_t slot) const
+{
+  return parameter_bank->get_source_id(slot);
 }
 
 std::shared_ptr< std::vector< std::pair<unsigned int, std::string> > > Controller::get_source_ids_and_names()
@@ -678,16 +641,283 @@ std::shared_ptr< std::vector< std::pair<unsigned int, std::string> > > Controlle
   return scene->get_source_ids_and_names();
 }
 
+void Controller::for_each_source(const std::function<void(const SSR::Source&)>& visit) const
+{
+  scene->for_each_source(visit);
+}
+
+unsigned long Controller::get_updates_suppressed_by_rate() const
+{
+  return send_rate_limiter->get_suppressed_by_rate();
+}
+
+unsigned long Controller::get_updates_suppressed_by_deadband() const
+{
+  return send_rate_limiter->get_suppressed_by_deadband();
+}
+
+unsigned long Controller::get_collapsed_incoming_updates() const
+{
+  return network_thread->get_collapsed_updates();
+}
+
+const SSR::Latency_probe& Controller::get_latency_probe() const
+{
+  return network_thread->get_latency_probe();
+}
+
 //==============================================================================
 // PRIVATE METHODS
 //==============================================================================
 
-void Controller::send_message_to_ssr()
+void Controller::update_ssr_rate_limited(const std::size_t slot, SSR::Update_specificator specificator, const SSR::Host_stamp& stamp)
+{
+  typedef SSR::Update_specificator::Specificators specificators;
+
+  const unsigned int now_in_msec = juce::Time::getMillisecondCounter();
+  const unsigned int source_id = source_id_of_slot(slot);
+  const SSR::Source* source = scene->get_source(source_id);
+
+  if (source == nullptr) {
+      return;
+  }
+
+  if (specificator.contains(specificators::position)) {
+
+      const float x_position = source->get_x_position().get_discrete_value();
+      const float y_position = source->get_y_position().get_discrete_value();
+
+      if (!send_rate_limiter->should_send(position_channel_of(slot), x_position, y_position, now_in_msec)) {
+          return;
+      }
+
+  } else if (specificator.contains(specificators::gain)) {
+
+      const float gain_in_db = SSR::helper::linear_to_dB(source->get_gain().get_discrete_value());
+
+      if (!send_rate_limiter->should_send(gain_channel_of(slot), gain_in_db, 0.0f, now_in_msec)) {
+          return;
+      }
+
+  }
+
+  update_ssr_of_source(source_id, specificator, stamp);
+}
+
+void Controller::update_ssr_from_host(const std::size_t slot, const unsigned int source_id, SSR::Update_specificator specificator, const SSR::Host_stamp& stamp)
 {
-  tcp_connection->send_message(message_to_ssr, 0x00);
+  typedef SSR::Update_specificator::Specificators specificators;
+  namespace translations = SSR::translations;
 
-  //Reset message to empty string after sending the message
-  *message_to_ssr = std::string("");
+  const unsigned int now_in_msec = juce::Time::getMillisecondCounter();
+  const float scene_range = host_parameters->get_scene_range();
+
+  auto value_of = [this, slot](const SSR::Source::parameter field) {
+    return host_parameters->get_value(parameter_bank->get_index(slot, field));
+  };
+
+  SSR::Outbound_update update;
+  update.changed = specificator;
+  update.source_id = source_id;
+  update.stamp = stamp;
+
+  if (specificator.contains(specificators::position)) {
+
+      update.x_position = translations::X_position::to_discrete(value_of(SSR::Source::x_position_idx), scene_range);
+      update.y_position = translations::Y_position::to_discrete(value_of(SSR::Source::y_position_idx), scene_range);
+
+      if (!send_rate_limiter->should_send(position_channel_of(slot), update.x_position, update.y_position, now_in_msec)) {
+          return;
+      }
+
+  } else if (specificator.contains(specificators::gain)) {
+
+      //The gain is sent in dB, see update_ssr_of_source(...)
+      update.gain_in_db = SSR::helper::linear_to_dB(translations::Gain::to_discrete(value_of(SSR::Source::gain_idx), scene_range));
+
+      if (!send_rate_limiter->should_send(gain_channel_of(slot), update.gain_in_db, 0.0f, now_in_msec)) {
+          return;
+      }
+
+  }
+
+  if (specificator.contains(specificators::mute)) {
+      update.mute = translations::Mute::to_discrete(value_of(SSR::Source::mute_idx), scene_range);
+  }
+
+  if (specificator.contains(specificators::fixed)) {
+      update.fixed = translations::Fixed::to_discrete(value_of(SSR::Source::fixed_idx), scene_range);
+  }
+
+  if (specificator.contains(specificators::model)) {
+      update.model_point = translations::Model_point::to_discrete(value_of(SSR::Source::model_point_idx), scene_range);
+  }
+
+  network_thread->push_update(update);
+  SSR::Metrics::get_instance().add(SSR::Metrics::outbound_updates);
+}
+
+void Controller::publish_host_parameters()
+{
+  host_parameters->publish_scene_range(scene->get_scene_range());
+
+  for (std::size_t slot = 0; slot <= SSR::Parameter_bank::selected_slot; slot++) {
+
+      const unsigned int source_id = source_id_of_slot(slot);
+      const SSR::Source* source = scene->get_source(source_id);
+
+      host_parameters->publish_source_id(slot, (source != nullptr) ? source_id : 0);
+
+      if (source == nullptr) {
+          continue;
+      }
+
+      for (std::size_t field = 0; field < SSR::Source::parameter_count; field++) {
+          const SSR::Source::parameter parameter = static_cast<SSR::Source::parameter>(field);
+          host_parameters->publish_value(parameter_bank->get_index(slot, parameter), source->get_continuous_value(parameter));
+      }
+
+  }
+}
+
+void Controller::timerCallback()
+{
+  const unsigned int now_in_msec = juce::Time::getMillisecondCounter();
+
+  read_ssr_incoming_message();
+
+  // The values the host set, in the order it set them. The held back ones
+  // below are sent from the Scene, so they have to be applied first.
+  SSR::Host_parameters::Change change;
+
+  while (host_parameters->take_change(change)) {
+      scene->set_parameter_continuous_of_source(change.source_id, change.field, change.value);
+  }
+
+  for (std::size_t slot = 0; slot <= SSR::Parameter_bank::selected_slot; slot++) {
+
+      const unsigned int source_id = source_id_of_slot(slot);
+      const SSR::Source* source = scene->get_source(source_id);
+
+      if (source == nullptr) {
+          continue;
+      }
+
+      if (send_rate_limiter->take_pending(position_channel_of(slot),
+                                          source->get_x_position().get_discrete_value(),
+                                          source->get_y_position().get_discrete_value(),
+                                          now_in_msec)) {
+          update_ssr_of_source(source_id, SSR::Update_specificator(SSR::Update_specificator::position));
+      }
+
+      if (send_rate_limiter->take_pending(gain_channel_of(slot),
+                                          SSR::helper::linear_to_dB(source->get_gain().get_discrete_value()),
+                                          0.0f,
+                                          now_in_msec)) {
+          update_ssr_of_source(source_id, SSR::Update_specificator(SSR::Update_specificator::gain));
+      }
+
+  }
+
+  trajectory_positions.clear();
+
+  if (trajectory_engine->take_positions(trajectory_positions)) {
+
+      for (const SSR::Trajectory_engine::Position& position : trajectory_positions) {
+          scene->set_position_of_source(position.source_id, position.x, position.y);
+      }
+
+  }
+
+  publish_host_parameters();
+
+  const SSR::Connection_state connection_state = get_connection_state();
+  const unsigned long jack_ports_version = jack_client->get_output_ports_version();
+
+  // An idle editor is not woken up at all.
+  if (ui_updater != nullptr && (scene->has_changes() || connection_state != ui_connection_state || jack_ports_version != ui_jack_ports_version)) {
+      ui_connection_state = connection_state;
+      ui_jack_ports_version = jack_ports_version;
+      ui_updater->triggerAsyncUpdate();
+  }
+}
+
+void Controller::configure_send_rate_limiter()
+{
+  const SSR::Network_config network_config = config->get_network_config();
+
+  for (std::size_t slot = 0; slot <= SSR::Parameter_bank::selected_slot; slot++) {
+      send_rate_limiter->set_max_rate(position_channel_of(slot), network_config.get_position_max_update_rate());
+      send_rate_limiter->set_max_rate(gain_channel_of(slot), network_config.get_gain_max_update_rate());
+      send_rate_limiter->set_deadband(position_channel_of(slot), network_config.get_position_deadband(), network_config.get_position_relative_deadband());
+      send_rate_limiter->set_deadband(gain_channel_of(slot), network_config.get_gain_deadband(), network_config.get_gain_relative_deadband());
+  }
+
+  // Trajectories only move sources.
+  trajectory_engine->set_max_rate(network_config.get_position_max_update_rate());
+}
+
+void Controller::register_jack_client()
+{
+  const char* jack_client_name = JucePlugin_Name;
+
+  try {
+      jack_client->register_client(jack_client_name);
+  } catch (SSR::jack_server_not_running_exception& jsnre) {
+      SSR::Logger::get_instance()->log(SSR::Logger::Level::error, jsnre.what(), LOG_TO_FILE);
+  } catch (std::exception& e) {
+      SSR::Logger::get_instance()->log(SSR::Logger::Level::error, e.what(), LOG_TO_FILE);
+  }
+}
+
+unsigned int Controller::source_id_of_slot(const std::size_t slot) const
+{
+  return (slot == SSR::Parameter_bank::selected_slot) ? scene->get_id_of_selected_source() : parameter_bank->get_source_id(slot);
+}
+
+std::vector<SSR::Trajectory::Keyframe>& Controller::recorded_keyframes_of(const unsigned int source_id)
+{
+  auto found = recorded_keyframes.find(source_id);
+
+  if (found == recorded_keyframes.end()) {
+
+      std::vector<SSR::Trajectory::Keyframe> keyframes;
+
+      for (const auto& source_and_trajectory : trajectory_engine->get_trajectories()) {
+
+          if (source_and_trajectory.first == source_id) {
+              keyframes = source_and_trajectory.second.get_keyframes();
+          }
+
+      }
+
+      found = recorded_keyframes.insert(std::make_pair(source_id, std::move(keyframes))).first;
+  }
+
+  return found->second;
+}
+
+bool Controller::assign_recorded_trajectory(const unsigned int source_id, const SSR::Trajectory::Shape shape)
+{
+  try {
+      return trajectory_engine->set_trajectory(source_id, SSR::Trajectory::from_keyframes(shape, recorded_keyframes_of(source_id)));
+  } catch (const std::invalid_argument& e) {
+      // Too few keyframes yet, the source stays where it is.
+      SSR::Logger::get_instance()->log(SSR::Logger::Level::debug, e.what(), LOG_TO_FILE);
+      trajectory_engine->remove_trajectory(source_id);
+  }
+
+  return false;
+}
+
+std::size_t Controller::position_channel_of(const std::size_t slot)
+{
+  return 2 * slot;
+}
+
+std::size_t Controller::gain_channel_of(const std::size_t slot)
+{
+  return 2 * slot + 1;
 }
 
 boost::filesystem::path Controller::get_config_file_path()
@@ -698,11 +928,11 @@ boost::filesystem::path Controller::get_config_file_path()
   try {
       config_file_location = SSR::helper::get_environment_variable("SSREMOTE_VST");
   } catch (std::invalid_argument& iae) {
-      SSR::Logger::get_instance()->log(SSR::Logger::Level::ERROR, iae.what(), LOG_TO_FILE);
+      SSR::Logger::get_instance()->log(SSR::Logger::Level::error, iae.what(), LOG_TO_FILE);
   }
 
   if (!bfs::is_directory(config_file_location)) {
-      SSR::Logger::get_instance()->log(SSR::Logger::Level::ERROR, "Configfile location is not a directory!", LOG_TO_FILE);
+      SSR::Logger::get_instance()->log(SSR::Logger::Level::error, "Configfile location is not a directory!", LOG_TO_FILE);
   }
 
   std::string filename = "ssremote_config.xml";
@@ -710,7 +940,7 @@ boost::filesystem::path Controller::get_config_file_path()
   boost::filesystem::path config_file_path = config_file_location / bfs::path(filename);
 
   if (!bfs::is_regular_file(config_file_path)) {
-      SSR::Logger::get_instance()->log(SSR::Logger::Level::ERROR, "Configfile is not a regular file!", LOG_TO_FILE);
+      SSR::Logger::get_instance()->log(SSR::Logger::Level::error, "Configfile is not a regular file!", LOG_TO_FILE);
   }
 
   return config_file_path;
@@ -719,7 +949,35 @@ boost::filesystem::path Controller::get_config_file_path()
 
 void Controller::setStateInformation (const void* data, int sizeInBytes)
 {
-  //TODO: Implement this method!
+  juce::MemoryInputStream input(data, static_cast<std::size_t>(std::max(sizeInBytes, 0)), false);
+
+  // Every section is replaced only if it could be read completely, the
+  // sections before a damaged one stay restored.
+  try {
+
+      if (SSR::state_stream::read_uint32(input) != SSR::state_stream::magic) {
+          throw std::runtime_error("Plugin state has an unknown format!");
+      }
+
+      const juce::uint32 version = SSR::state_stream::read_uint32(input);
+
+      if (version == 0 || version > SSR::state_stream::version) {
+          throw std::runtime_error("Plugin state version " + std::to_string(version) + " is not supported!");
+      }
+
+      scene->read_state(input);
+      parameter_bank->read_state(input);
+      trajectory_engine->read_state(input);
+      recorded_keyframes.clear();
+
+      SSR::Logger::get_instance()->log(SSR::Logger::Level::info, "Restored the plugin state (" + std::to_string(sizeInBytes) + " bytes)", LOG_TO_FILE);
+
+  } catch (const std::exception& e) {
+      SSR::Logger::get_instance()->log(SSR::Logger::Level::error, std::string("Could not restore the plugin state: ") + e.what(), LOG_TO_FILE);
+  }
+
+  publish_host_parameters();
+  updateHostDisplay();
 }
 
 
@@ -15,6 +15,8 @@
 
 #include <algorithm> 
 #include <array>
+#include <atomic>
+#include <functional>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -27,8 +29,18 @@
 //Own classes
 #include <src/utils/jack_client.h>
 #include <src/utils/tcp_connection.h>
-#include <src/utils/ssr_requester.h>
-#include <src/parameter/parameter.h>
+#include <src/utils/network_thread.h>
+#include <src/utils/inbound_coalescer.h>
+#include <src/utils/startup_thread.h>
+#include <src/utils/connection_state.h>
+#include <src/utils/send_rate_limiter.h>
+#include <src/utils/host_clock.h>
+#include <src/utils/metrics_exporter.h>
+#include <src/parameter/parameter_bank.h>
+#include <src/parameter/host_parameters.h>
+#include <src/trajectory/trajectory.h>
+#include <src/trajectory/trajectory_engine.h>
+#include <src/parameter/static_parameter.h>
 #include <src/config/config.h>
 #include <src/utils/update_specificator.h>
 #include <src/scene/scene.h>
@@ -50,18 +62,17 @@
  */
 class Controller 
     : public AudioProcessor
+    , private juce::Timer
 {
 
 public:
 
   /**
-   * Constructor initializing the ui_update_flag with true and the scene with a
-   * range of 20.0.
+   * Constructor initializing the scene with a range of 20.0.
    *
-   * Loads the config for the VST Plugin, network connects to the SSR, registers
-   * this VST Plugin at the Jack Server.
-   *
-   * Reads the first incoming messages from the SSR.
+   * Returns immediately: loading the config for the VST Plugin, handing the
+   * connection to the network thread and registering this VST Plugin at the
+   * Jack Server is done by a startup thread in the background.
    */
   Controller();
 
@@ -86,7 +97,7 @@ public:
   const String getName() const override;
 
   /**
-   * Currently there is nothing put in this method.
+   * Hands the sample rate to the trajectory engine.
    *
    * JUCE Doc.:
    *
@@ -115,7 +126,11 @@ public:
   void releaseResources() override;
 
   /**
-   * Currently there is nothing put in this method.
+   * Evaluates the trajectories of all sources at the host timeline position
+   * of the block (see AudioPlayHead) and hands the changed positions to the
+   * network thread. The audio buffer is left untouched.
+   *
+   * @see trajectory_engine.h
    *
    * JUCE Doc.:
    *
@@ -368,8 +383,10 @@ public:
   bool hasEditor() const override;
 
   /**
-   * Returns the number of parameters.
+   * Returns the number of parameters: the parameters of the selected source
+   * followed by the parameters of every slot of the parameter bank.
    *
+   * @see parameter_bank.h
    * @see source.h
    * @see enum parameter
    *
@@ -407,8 +424,10 @@ public:
   const String getParameterName (int parameterIndex) override;
 
   /**
-   * Returns the parameter value identified by the transferred index.
+   * Returns the parameter value identified by the transferred index, as
+   * published by the message thread or set by the host.
    *
+   * @see host_parameters.h
    * @see source.h
    * @see scene.h
    *
@@ -458,7 +477,8 @@ public:
    * Sets the parameter indexed by the transferred parameter parameterIndex
    * to the value of the transferred parameter newValue.
    *
-   * The parameterIndex values will index the following parameters:
+   * The parameterIndex values 0 to 6 will index the following parameters
+   * of the current selected source:
    *
    * 0 -> X Position
    * 1 -> Y Position
@@ -470,15 +490,23 @@ public:
    * 5 -> Model Point
    * 6 -> Fixed
    *
+   * The following indices repeat these parameters for every slot of the
+   * parameter bank, each slot bound to one source id, so one instance can
+   * automate the whole scene.
+   *
+   * @see parameter_bank.h
+   *
    * Please see the Source class for more detailed information on the
    * parameters.
    *
    * @see source.h
    *
-   * Furthermore, this method calls the update_ssr(...) method to update the
+   * The value is stored in the host parameters and applied to the scene by
+   * timerCallback(), since the scene belongs to the message thread.
+   * Furthermore, this method calls update_ssr_from_host(...) to update the
    * SSR with the correlating update specificator.
    *
-   * @see void update_ssr(SSR::Update_specificator specificator)
+   * @see host_parameters.h
    *
    * JUCE Doc.:
    *
@@ -585,7 +613,9 @@ public:
   void changeProgramName(int index, const String& newName) override;
 
   /**
-   * TODO: This method must be implemented see issue #10.
+   * Writes the versioned binary state chunk (see SSR::state_stream): the
+   * scene mirror with all sources, the selection and the scene range, the
+   * slot bindings of the parameter bank and the trajectories.
    *
    * JUCE Doc.:
    *
@@ -617,7 +647,10 @@ public:
   void getStateInformation(MemoryBlock& destData);
 
   /**
-   * This method must be implemented see issue #11.
+   * Restores a state chunk written by getStateInformation, so the scene is
+   * available before the SSR is connected. The SSR overrides it once it
+   * has sent its scene. A chunk which cannot be read is logged and leaves
+   * the plugin as it is.
    *
    * JUCE Doc.:
    *
@@ -766,18 +799,23 @@ public:
   void new_source();
 
   /**
-   * This method reads the incoming message from the SSR server, interprets
-   * them and updates the members if there have been any request of doing so
-   * from the SSR server.
+   * This method takes over the records the network thread received from the
+   * SSR server since the last call, merged so that only the newest value of
+   * every field of a source is left, and applies them to the scene.
+   *
+   * Must be called from the message thread.
    *
    * @return       if there was any message from the SSR server to interpret.
    **/
   bool read_ssr_incoming_message();
 
   /**
-   * This method will try to connect to the SSR with the data given by the
-   * XML config file (which data will be loaded every time this method is
-   * called).
+   * This method will hand a new connection to the SSR, created with the data
+   * given by the XML config file (which data will be loaded every time this
+   * method is called), to the network thread which then connects to the SSR.
+   * The transport (TCP/IP or Unix domain socket) is taken from the config
+   * file as well. The metrics export is restarted with the settings of the config file as
+   * well.
    */
   void connect();
 
@@ -789,51 +827,123 @@ public:
   bool is_connected_to_ssr() const;
 
   /**
-   * Returns true if the UI needs update.
+   * Returns the state of the connection to the SSR. While the startup thread
+   * is still running, the state is connecting.
    *
-   * @return true if the UI needs update.
-   **/
-  bool ui_needs_update() const;
+   * @return the connection state.
+   */
+  SSR::Connection_state get_connection_state() const;
 
   /**
-   * Sets the ui_update_flag to true for requesting a UI update.
+   * Sets the updater which is triggered on the message thread whenever the
+   * scene or the connection state changed. The editor registers itself when
+   * it is created and passes nullptr when it is destroyed.
+   *
+   * Must be called from the message thread.
+   *
+   * @param    updater     The updater of the editor or nullptr.
    **/
-  void ui_request_update();
+  void ui_set_updater(juce::AsyncUpdater* updater);
 
   /**
-   * Clears the ui_update_flag by setting it tp false.
+   * Returns the changes of the scene since the last call and clears them.
+   *
+   * @return a combination of SSR::Scene::Change bits.
+   *
+   * @see scene.h
    **/
-  void ui_clear_update_flag();
+  unsigned int ui_take_changes();
 
   /**
-   * This method returns all Jack Ports specified by the flags. If there are no
-   * jackports available, the method will return a vector with one element
-   * which content is "No Jackport available.".
-   *
-   * Furthermore, the method will log an error an error occurs.
+   * This method returns the current snapshot of all Jack output ports. The
+   * snapshot is empty (version 0) as long as the jack client is not
+   * registered at the Jack Server.
    *
-   * @param    flags       Flags to specify which Jack Ports shall be returned.
-   *                       See JackPortFlags (jack/types.h) for all flags you can
-   *                       set.
-   *
-   * @return   all jackports specified by the flags.
+   * @return   the current snapshot of the Jack output ports.
    **/
-  std::vector<std::string> get_all_jack_ports(const unsigned long flags);
+  std::shared_ptr<const SSR::Jack_port_snapshot> get_jack_ports() const;
 
   /**
-   * This method will update the SSR by composing a string with all information
-   * needed for updating the parameters specified by the specificator.
+   * This method will update the SSR by composing an outbound update with all
+   * information needed for updating the parameters specified by the
+   * specificator.
    *
-   * Finally, the method will send the new composed message to the SSR.
+   * Finally, the method will hand the update to the network thread which
+   * builds the message and sends it to the SSR. This method does not block
+   * and does not allocate a message string.
    *
    * @see update_specificator.h
-   * @see ssr_requester.h
+   * @see outbound_update.h
+   * @see network_thread.h
    *
    * @param     specificator    The specificator specifying the parameters
    *                            which shall be updated.
    */
   void update_ssr(SSR::Update_specificator specificator);
 
+  /**
+   * Removes the trajectory of the current selected source and the keyframes
+   * recorded for it.
+   */
+  void clear_trajectory_of_selected_source();
+
+  /**
+   * Records the position of the current selected source at the current play
+   * head position of the host as a keyframe and assigns the trajectory of
+   * the transferred shape built from all keyframes recorded for the source.
+   *
+   * @see Trajectory::from_keyframes(...)
+   *
+   * @param     shape           The shape of the trajectory.
+   *
+   * @return    false if the trajectory could not be assigned (too few
+   *            keyframes for the shape or too many sources with a
+   *            trajectory), the keyframe is recorded anyway.
+   */
+  bool add_keyframe_to_selected_source(const SSR::Trajectory::Shape shape);
+
+  /**
+   * Assigns the trajectory of the transferred shape built from the keyframes
+   * recorded for the current selected source. If they are too few for the
+   * shape, the source has no trajectory until more are recorded.
+   *
+   * @param     shape           The shape of the trajectory.
+   *
+   * @return    false if the trajectory could not be assigned.
+   */
+  bool set_trajectory_shape_of_selected_source(const SSR::Trajectory::Shape shape);
+
+  /**
+   * Returns the shape of the trajectory of the current selected source.
+   *
+   * @param     shape           Will be set to the shape.
+   *
+   * @return    false if the source has no trajectory.
+   */
+  bool get_trajectory_shape_of_selected_source(SSR::Trajectory::Shape& shape) const;
+
+  /**
+   * Binds the transferred slot of the parameter bank to the source with the
+   * transferred id.
+   *
+   * @param     slot            The slot, less than Parameter_bank::slot_count.
+   *
+   * @param     source_id       The SSR id of the source, 0 unbinds the slot.
+   *
+   * @throws    out_of_range    If the slot is out of range.
+   */
+  void bind_slot_to_source(const std::size_t slot, const unsigned int source_id);
+
+  /**
+   * Returns the id of the source the transferred slot of the parameter bank
+   * is bound to.
+   *
+   * @param     slot            The slot, less than Parameter_bank::slot_count.
+   *
+   * @return    the SSR id of the source, 0 if the slot is unbound.
+   */
+  unsigned int get_source_id_of_slot(const std::size_t slot) const;
+
   /**
    * Creates a vector with the sources ids and names and returns it.
    *
@@ -841,13 +951,176 @@ public:
    */
   std::shared_ptr< std::vector< std::pair<unsigned int, std::string> > > get_source_ids_and_names();
 
+  /**
+   * Calls the transferred function for every source of the scene.
+   *
+   * Must be called from the message thread.
+   *
+   * @param    visit       The function called per source.
+   */
+  void for_each_source(const std::function<void(const SSR::Source&)>& visit) const;
+
+  /**
+   * Returns the number of position and gain updates which have not been sent
+   * to the SSR because of the maximum update rate.
+   *
+   * @return the number of updates suppressed by the rate limit.
+   */
+  unsigned long get_updates_suppressed_by_rate() const;
+
+  /**
+   * Returns the number of position and gain updates which have not been sent
+   * to the SSR because they changed less than the deadband.
+   *
+   * @return the number of updates suppressed by the deadband.
+   */
+  unsigned long get_updates_suppressed_by_deadband() const;
+
+  /**
+   * Returns the number of records received from the SSR which were not
+   * applied on their own because a newer record of the same source arrived
+   * before the next tick of the message thread.
+   *
+   * @return the number of collapsed incoming records.
+   */
+  unsigned long get_collapsed_incoming_updates() const;
+
+  /**
+   * Returns the latency histograms of the connection to the SSR: the time
+   * changes wait in the plugin, the round trip of the network and the round
+   * trip until the SSR echoes a change, per kind of change.
+   *
+   * @return the latency probe of the network thread.
+   */
+  const SSR::Latency_probe& get_latency_probe() const;
+
 private:
 
   /**
-   * Sends the message_to_ssr to the SSR and sets the message_to_ssr to empty
-   * string.
-   **/
-  void send_message_to_ssr();
+   * Like update_ssr(...), but for the source with the transferred id.
+   * Nothing is sent if there is no such source.
+   *
+   * @param     source_id       The SSR id of the source.
+   *
+   * @param     specificator    The specificator specifying the parameters
+   *                            which shall be updated.
+   *
+   * @param     stamp           Where the change belongs on the timeline of
+   *                            the host, sent at once by default.
+   */
+  void update_ssr_of_source(const unsigned int source_id, SSR::Update_specificator specificator, const SSR::Host_stamp& stamp = SSR::Host_stamp());
+
+  /**
+   * Calls update_ssr_of_source(...) for the source of the transferred slot
+   * unless the send rate limiter holds back a position or gain update. Held
+   * back updates are sent by timerCallback() once the parameter is idle.
+   *
+   * @see send_rate_limiter.h
+   *
+   * @param     slot            The slot of the parameter bank or
+   *                            Parameter_bank::selected_slot.
+   *
+   * @param     specificator    The specificator specifying the parameters
+   *                            which shall be updated.
+   *
+   * @param     stamp           Where the change belongs on the timeline of
+   *                            the host, sent at once by default.
+   */
+  void update_ssr_rate_limited(const std::size_t slot, SSR::Update_specificator specificator, const SSR::Host_stamp& stamp = SSR::Host_stamp());
+
+  /**
+   * Sends the values the host parameters hold for the transferred slot to
+   * the SSR unless the send rate limiter holds back a position or gain
+   * update. Called by setParameter(...), so it never touches the scene.
+   *
+   * @param     slot            The slot of the parameter bank or
+   *                            Parameter_bank::selected_slot.
+   *
+   * @param     source_id       The id of the source the slot refers to.
+   *
+   * @param     specificator    The specificator specifying the parameters
+   *                            which shall be updated.
+   *
+   * @param     stamp           Where the change belongs on the timeline of
+   *                            the host.
+   */
+  void update_ssr_from_host(const std::size_t slot, const unsigned int source_id, SSR::Update_specificator specificator, const SSR::Host_stamp& stamp);
+
+  /**
+   * Publishes the scene range, the source of every slot and the values of
+   * its parameters to the host parameters. Called by the message thread.
+   */
+  void publish_host_parameters();
+
+  /**
+   * Registers this VST Plugin at the Jack Server, called by the startup
+   * thread.
+   */
+  void register_jack_client();
+
+  /**
+   * Returns the id of the source the transferred slot refers to, the id of
+   * the current selected source for Parameter_bank::selected_slot.
+   *
+   * @param     slot            The slot of the parameter bank or
+   *                            Parameter_bank::selected_slot.
+   *
+   * @return    the SSR id of the source, 0 if the slot is unbound.
+   */
+  unsigned int source_id_of_slot(const std::size_t slot) const;
+
+  /**
+   * Returns the keyframes recorded for the source with the transferred id.
+   * If none were recorded since the plugin state was restored, they are
+   * taken from the keyframed trajectory of the source, if any.
+   *
+   * @param     source_id       The SSR id of the source.
+   *
+   * @return    the recorded keyframes.
+   */
+  std::vector<SSR::Trajectory::Keyframe>& recorded_keyframes_of(const unsigned int source_id);
+
+  /**
+   * Assigns the trajectory of the transferred shape built from the keyframes
+   * recorded for the source with the transferred id. The trajectory of the
+   * source is removed if they are too few for the shape.
+   *
+   * @param     source_id       The SSR id of the source.
+   *
+   * @param     shape           The shape of the trajectory.
+   *
+   * @return    false if the trajectory could not be assigned.
+   */
+  bool assign_recorded_trajectory(const unsigned int source_id, const SSR::Trajectory::Shape shape);
+
+  /**
+   * Returns the send rate limiter channel of the position of the transferred
+   * slot.
+   */
+  static std::size_t position_channel_of(const std::size_t slot);
+
+  /**
+   * Returns the send rate limiter channel of the gain of the transferred
+   * slot.
+   */
+  static std::size_t gain_channel_of(const std::size_t slot);
+
+  /**
+   * Applies the updates received from the SSR, the values set by the host
+   * and the positions evaluated by the trajectory engine to the scene, sends
+   * the latest value of every position or gain parameter which has been held
+   * back by the send rate limiter and is idle now, publishes the scene to the
+   * host parameters and triggers the ui_updater if the scene, the connection
+   * state or the Jack ports changed.
+   */
+  void timerCallback() override;
+
+  /**
+   * Applies the maximum update rate and the deadbands of the network config
+   * to the send rate limiter and the maximum update rate to the trajectory
+   * engine.
+   */
+  void configure_send_rate_limiter();
 
   /**
    * Returns a the valid config file path (including the file name).
@@ -874,27 +1147,31 @@ private:
 private:
 
   /**
-   * Bool flag indicating if the user interface needs to be updated (= true).
+   * The updater of the editor, nullptr while no editor is open. Only used
+   * on the message thread.
    **/
-  bool ui_update_flag;
+  juce::AsyncUpdater* ui_updater;
 
   /**
-   * TCP connection object for connecting to ssr.
+   * The connection state the editor was last triggered for.
    **/
-  std::unique_ptr<SSR::IConnection> tcp_connection;
+  SSR::Connection_state ui_connection_state;
 
   /**
-   * The message that will be send to the SSR server.
-   * It has to include the '\0' also called EOF ending so the SSR server understands
-   * that this is the end of the message.
+   * The version of the Jack port snapshot the editor was last triggered for.
    **/
-  std::shared_ptr<std::string> message_to_ssr;
+  unsigned long ui_jack_ports_version;
 
   /**
-   * The message that comes from the SSR server.
-   * It has to have an '\0' at the end.
+   * The network thread owning the connection to the SSR.
    **/
-  std::shared_ptr<std::string> message_from_ssr;
+  std::unique_ptr<SSR::Network_thread> network_thread;
+
+  /**
+   * The records received from the SSR, merged per source. Reused between
+   * calls of read_ssr_incoming_message.
+   **/
+  SSR::Inbound_coalescer inbound_updates;
 
   /**
    * The jack client managing the provided jack ports.
@@ -902,20 +1179,77 @@ private:
   std::unique_ptr<SSR::Jack_client> jack_client;
 
   /**
-   * This is the SSR requester, requesting changes of the SSR scene.
+   * Holds back position and gain updates exceeding the maximum update rate or
+   * changing less than the deadband.
+   */
+  std::unique_ptr<SSR::Send_rate_limiter> send_rate_limiter;
+
+  /**
+   * Maps the VST parameter indices onto the sources.
+   */
+  std::unique_ptr<SSR::Parameter_bank> parameter_bank;
+
+  /**
+   * The values of the VST parameters for the threads of the host.
    */
-  std::unique_ptr<SSR::SSR_requester> requester;
+  std::unique_ptr<SSR::Host_parameters> host_parameters;
+
+  /**
+   * Evaluates the trajectories of the sources on the audio thread.
+   */
+  std::unique_ptr<SSR::Trajectory_engine> trajectory_engine;
+
+  /**
+   * Maps the sample positions of the host to wall clock time, so parameter
+   * changes and trajectory positions are stamped with the position they
+   * belong to.
+   */
+  std::unique_ptr<SSR::Host_clock> host_clock;
+
+  /**
+   * The play head position of the host in seconds as of the last audio
+   * block, also while the transport is stopped. Keyframes are recorded at
+   * this position.
+   */
+  std::atomic<double> play_head_time_in_seconds;
+
+  /**
+   * The positions taken from the trajectory engine, reused between timer
+   * callbacks.
+   */
+  std::vector<SSR::Trajectory_engine::Position> trajectory_positions;
+
+  /**
+   * The keyframes recorded for every source by the GUI, only touched by the
+   * message thread.
+   */
+  std::map< unsigned int, std::vector<SSR::Trajectory::Keyframe> > recorded_keyframes;
 
   /**
    * The config for this VST Plugin.
    */
   std::unique_ptr<SSR::Config> config;
 
+  /**
+   * Writes the metrics to the file named by the config, if any.
+   */
+  std::unique_ptr<SSR::Metrics_exporter> metrics_exporter;
+
   /**
    * The scene with all related sources and additional information.
    */
   std::unique_ptr< SSR::Scene > scene;
 
+  /**
+   * Serialises connect() between the startup thread and the GUI.
+   */
+  juce::CriticalSection connect_lock;
+
+  /**
+   * Runs the slow part of the initialisation once in the background.
+   */
+  std::unique_ptr<SSR::Startup_thread> startup_thread;
+
 };
 
 
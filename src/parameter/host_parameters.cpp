@@ -0,0 +1,116 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/parameter/host_parameters.h>
+
+//============================================================================
+// PUBLIC
+
+SSR::Host_parameters::Host_parameters()
+: scene_range(0.0f)
+, source_ids()
+, values()
+, unapplied()
+, changes()
+{
+  for (std::atomic<unsigned int>& source_id : source_ids) {
+      source_id.store(0, std::memory_order_relaxed);
+  }
+
+  for (std::size_t index = 0; index < values.size(); index++) {
+      values[index].store(0.0f, std::memory_order_relaxed);
+      unapplied[index].store(0, std::memory_order_relaxed);
+  }
+}
+
+SSR::Host_parameters::~Host_parameters()
+{
+
+}
+
+float SSR::Host_parameters::get_scene_range() const
+{
+  return scene_range.load(std::memory_order_relaxed);
+}
+
+unsigned int SSR::Host_parameters::get_source_id(const std::size_t slot) const
+{
+  return (slot < source_ids.size()) ? source_ids[slot].load(std::memory_order_acquire) : 0;
+}
+
+float SSR::Host_parameters::get_value(const int index) const
+{
+  if (index < 0 || static_cast<std::size_t>(index) >= values.size()) {
+      return 0.0f;
+  }
+
+  return values[index].load(std::memory_order_relaxed);
+}
+
+bool SSR::Host_parameters::set_value(const int index, const SSR::Source::parameter field, const unsigned int source_id, const float value)
+{
+  if (index < 0 || static_cast<std::size_t>(index) >= values.size()) {
+      return false;
+  }
+
+  Change change;
+  change.index = index;
+  change.field = field;
+  change.source_id = source_id;
+  change.value = value;
+
+  // Counted before it is queued, so the message thread never sees a change
+  // it has not counted.
+  unapplied[index].fetch_add(1, std::memory_order_relaxed);
+  values[index].store(value, std::memory_order_relaxed);
+
+  if (!changes.try_push(change)) {
+      unapplied[index].fetch_sub(1, std::memory_order_relaxed);
+      return false;
+  }
+
+  return true;
+}
+
+bool SSR::Host_parameters::take_change(Change& change)
+{
+  if (!changes.try_pop(change)) {
+      return false;
+  }
+
+  unapplied[change.index].fetch_sub(1, std::memory_order_relaxed);
+
+  return true;
+}
+
+void SSR::Host_parameters::publish_scene_range(const float scene_range)
+{
+  this->scene_range.store(scene_range, std::memory_order_relaxed);
+}
+
+void SSR::Host_parameters::publish_source_id(const std::size_t slot, const unsigned int source_id)
+{
+  if (slot < source_ids.size()) {
+      source_ids[slot].store(source_id, std::memory_order_release);
+  }
+}
+
+void SSR::Host_parameters::publish_value(const int index, const float value)
+{
+  if (index < 0 || static_cast<std::size_t>(index) >= values.size()) {
+      return;
+  }
+
+  if (unapplied[index].load(std::memory_order_relaxed) == 0) {
+      values[index].store(value, std::memory_order_relaxed);
+  }
+}
@@ -0,0 +1,200 @@
+#ifndef HOST_PARAMETERS_H
+#define HOST_PARAMETERS_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+//Own Libs
+#include <src/parameter/parameter_bank.h>
+#include <src/scene/source.h>
+#include <src/utils/mpsc_ring.h>
+
+namespace SSR
+{
+
+  /**
+   * This class holds the values of all VST parameters for the threads of the
+   * host, so setParameter and getParameter never touch the Scene, which the
+   * message thread changes (and reallocates) at any time.
+   *
+   * The message thread publishes the scene range, the id of the source every
+   * slot refers to and the values of its parameters once per tick. A value the host sets is
+   * stored right away and queued for the message thread, which applies it to
+   * the Scene. Until it did, publishing leaves that value alone, so the host
+   * does not read back an older value than the one it set. (A value set
+   * right while the message thread publishes it may be replaced by the
+   * older one for a single tick.)
+   *
+   * All methods but take_change are lock-free and may be called from any
+   * thread. take_change and the publish methods must only be called by the
+   * message thread.
+   */
+  class Host_parameters
+  {
+
+  public:
+
+    /**
+     * A value the host set, to be applied to the Scene.
+     */
+    struct Change
+    {
+
+      /**
+       * The VST parameter index.
+       */
+      int index;
+
+      /**
+       * The source parameter.
+       */
+      SSR::Source::parameter field;
+
+      /**
+       * The id of the source the slot referred to when the value was set.
+       */
+      unsigned int source_id;
+
+      /**
+       * The continuous value.
+       */
+      float value;
+
+    };
+
+    /**
+     * Constructor, all slots refer to no source and all values are 0.
+     */
+    Host_parameters();
+
+    /**
+     * Destructor.
+     */
+    ~Host_parameters();
+
+    /**
+     * Returns the scene range the continuous positions are translated with.
+     */
+    float get_scene_range() const;
+
+    /**
+     * Returns the id of the source the transferred slot refers to.
+     *
+     * @param     slot            The slot or Parameter_bank::selected_slot.
+     *
+     * @return    the SSR id of the source, 0 if the slot is unbound or its
+     *            source does not exist.
+     */
+    unsigned int get_source_id(const std::size_t slot) const;
+
+    /**
+     * Returns the continuous value of the transferred VST parameter.
+     *
+     * @param     index           The VST parameter index.
+     *
+     * @return    the continuous value, 0 if the index is out of range.
+     */
+    float get_value(const int index) const;
+
+    /**
+     * Stores the transferred value set by the host and queues it for the
+     * message thread. Never blocks and never allocates.
+     *
+     * @param     index           The VST parameter index.
+     *
+     * @param     field           The source parameter of the index.
+     *
+     * @param     source_id       The id of the source of the slot.
+     *
+     * @param     value           The continuous value.
+     *
+     * @return    false if the queue was full and the value was dropped.
+     */
+    bool set_value(const int index, const SSR::Source::parameter field, const unsigned int source_id, const float value);
+
+    /**
+     * Takes the oldest value the host set. Must only be called by the
+     * message thread, which applies it to the Scene before publishing.
+     *
+     * @param     change          Will be set to the change.
+     *
+     * @return    false if there is no change.
+     */
+    bool take_change(Change& change);
+
+    /**
+     * Publishes the scene range of the Scene.
+     */
+    void publish_scene_range(const float scene_range);
+
+    /**
+     * Publishes the id of the source the transferred slot refers to.
+     *
+     * @param     slot            The slot or Parameter_bank::selected_slot.
+     *
+     * @param     source_id       The SSR id of the source, 0 if the slot is
+     *                            unbound or its source does not exist.
+     */
+    void publish_source_id(const std::size_t slot, const unsigned int source_id);
+
+    /**
+     * Publishes the transferred value of the Scene unless the host set a
+     * value which is not applied yet.
+     *
+     * @param     index           The VST parameter index.
+     *
+     * @param     value           The continuous value.
+     */
+    void publish_value(const int index, const float value);
+
+  private:
+
+    /**
+     * The capacity of the queue of changes.
+     */
+    static const std::size_t change_capacity = 1024;
+
+    /**
+     * The scene range of the Scene.
+     */
+    std::atomic<float> scene_range;
+
+    /**
+     * The id of the source of every slot, the selected slot last.
+     */
+    std::array<std::atomic<unsigned int>, SSR::Parameter_bank::slot_count + 1> source_ids;
+
+    /**
+     * The continuous value of every VST parameter.
+     */
+    std::array<std::atomic<float>, SSR::Parameter_bank::parameter_count> values;
+
+    /**
+     * The number of queued changes of every VST parameter.
+     */
+    std::array<std::atomic<unsigned int>, SSR::Parameter_bank::parameter_count> unapplied;
+
+    /**
+     * The values the host set, in the order it set them.
+     */
+    SSR::Mpsc_ring<Change, change_capacity> changes;
+
+  };
+
+}
+
+#endif
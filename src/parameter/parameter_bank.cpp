@@ -0,0 +1,135 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/parameter/parameter_bank.h>
+
+//C++ Libs
+#include <cstdio>
+#include <stdexcept>
+
+//Own Libs
+#include <src/utils/state_stream.h>
+
+//============================================================================
+// PUBLIC
+
+SSR::Parameter_bank::Parameter_bank()
+: addresses()
+, names()
+, bindings()
+{
+  names.reserve(parameter_count);
+
+  for (std::size_t index = 0; index < parameter_count; index++) {
+
+      // The legacy parameters come first, then the slots in ascending order.
+      const std::size_t block = index / field_count;
+      const SSR::Source::parameter field = static_cast<SSR::Source::parameter>(index % field_count);
+
+      Address& address = addresses[index];
+      address.slot = (block == 0) ? selected_slot : block - 1;
+      address.field = field;
+
+      if (address.slot == selected_slot) {
+          names.push_back(SSR::Source::get_parameter_name(field));
+      } else {
+          char prefix[16];
+          std::snprintf(prefix, sizeof(prefix), "Slot %02u ", static_cast<unsigned int>(address.slot + 1));
+          names.push_back(std::string(prefix) + SSR::Source::get_parameter_name(field));
+      }
+
+  }
+
+  for (std::size_t slot = 0; slot < slot_count; slot++) {
+      bindings[slot] = static_cast<unsigned int>(slot + 1);
+  }
+}
+
+SSR::Parameter_bank::~Parameter_bank()
+{
+
+}
+
+bool SSR::Parameter_bank::look_up(const int index, Address& address) const
+{
+  if (index < 0 || static_cast<std::size_t>(index) >= parameter_count) {
+      return false;
+  }
+
+  address = addresses[index];
+
+  return true;
+}
+
+int SSR::Parameter_bank::get_index(const std::size_t slot, const SSR::Source::parameter field) const
+{
+  const std::size_t block = (slot == selected_slot) ? 0 : slot + 1;
+  return static_cast<int>(block * field_count + field);
+}
+
+const std::string& SSR::Parameter_bank::get_name(const int index) const
+{
+  static const std::string no_name = "No Name Specified";
+
+  if (index < 0 || static_cast<std::size_t>(index) >= parameter_count) {
+      return no_name;
+  }
+
+  return names[index];
+}
+
+void SSR::Parameter_bank::bind_slot(const std::size_t slot, const unsigned int source_id)
+{
+  if (slot >= slot_count) {
+      throw std::out_of_range("Parameter_bank: slot out of range!");
+  }
+
+  bindings[slot] = source_id;
+}
+
+unsigned int SSR::Parameter_bank::get_source_id(const std::size_t slot) const
+{
+  return (slot < slot_count) ? bindings[slot].load() : 0;
+}
+
+void SSR::Parameter_bank::write_state(juce::OutputStream& output) const
+{
+  output.writeInt(static_cast<int>(slot_count));
+
+  for (std::size_t slot = 0; slot < slot_count; slot++) {
+      output.writeInt(static_cast<int>(bindings[slot].load()));
+  }
+}
+
+void SSR::Parameter_bank::read_state(juce::InputStream& input)
+{
+  const juce::uint32 count = SSR::state_stream::read_count(input, 4);
+  std::array<unsigned int, slot_count> restored_bindings;
+
+  for (std::size_t slot = 0; slot < slot_count; slot++) {
+      restored_bindings[slot] = bindings[slot].load();
+  }
+
+  for (juce::uint32 slot = 0; slot < count; slot++) {
+
+      const unsigned int source_id = SSR::state_stream::read_uint32(input);
+
+      if (slot < slot_count) {
+          restored_bindings[slot] = source_id;
+      }
+
+  }
+
+  for (std::size_t slot = 0; slot < slot_count; slot++) {
+      bindings[slot] = restored_bindings[slot];
+  }
+}
@@ -0,0 +1,193 @@
+#ifndef PARAMETER_BANK_H
+#define PARAMETER_BANK_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+//Own Libs
+#include <src/scene/source.h>
+
+//JUCE Lib
+#include <JUCE/JuceHeader.h>
+
+namespace SSR
+{
+
+  /**
+   * This class maps the flat VST parameter indices onto sources.
+   *
+   * The first Source::parameter_count indices are the legacy parameters of
+   * the selected source, so existing host automation keeps working. They are
+   * followed by slot_count slots of Source::parameter_count parameters each,
+   * every slot bound to a SSR source id:
+   *
+   * index = (slot + 1) * field_count + field      (slot 0 .. slot_count - 1)
+   *
+   * The index is resolved by a lookup table built once, so the host
+   * callbacks do a single array access instead of a switch per field.
+   * Slot i is bound to source id i + 1 until it is rebound. Bindings may be
+   * read from any thread.
+   */
+  class Parameter_bank
+  {
+
+  public:
+
+    /**
+     * The number of slots bound to a source id.
+     */
+    static const std::size_t slot_count = 64;
+
+    /**
+     * The number of parameters per slot.
+     */
+    static const std::size_t field_count = SSR::Source::parameter::parameter_count;
+
+    /**
+     * The slot of the legacy parameters which follow the selected source.
+     */
+    static const std::size_t selected_slot = slot_count;
+
+    /**
+     * The number of VST parameters.
+     */
+    static const std::size_t parameter_count = (slot_count + 1) * field_count;
+
+    /**
+     * The slot and field a VST parameter index refers to.
+     */
+    struct Address
+    {
+
+      /**
+       * The slot, selected_slot for the legacy parameters.
+       */
+      std::size_t slot;
+
+      /**
+       * The source parameter.
+       */
+      SSR::Source::parameter field;
+
+    };
+
+    /**
+     * Constructor building the lookup table and binding slot i to source
+     * id i + 1.
+     */
+    Parameter_bank();
+
+    /**
+     * Destructor.
+     */
+    ~Parameter_bank();
+
+    /**
+     * Resolves the transferred VST parameter index.
+     *
+     * @param     index           The VST parameter index.
+     *
+     * @param     address         Will be set to the slot and field.
+     *
+     * @return    false if the index is out of range.
+     */
+    bool look_up(const int index, Address& address) const;
+
+    /**
+     * Returns the VST parameter index of the transferred slot and field.
+     *
+     * @param     slot            The slot or selected_slot.
+     *
+     * @param     field           The source parameter.
+     *
+     * @return    the VST parameter index.
+     */
+    int get_index(const std::size_t slot, const SSR::Source::parameter field) const;
+
+    /**
+     * Returns the name of the VST parameter with the transferred index, for
+     * example "Slot 03 Gain".
+     *
+     * @param     index           The VST parameter index.
+     *
+     * @return    the name or "No Name Specified" if the index is out of range.
+     */
+    const std::string& get_name(const int index) const;
+
+    /**
+     * Binds the transferred slot to the source with the transferred id.
+     *
+     * @param     slot            The slot, less than slot_count.
+     *
+     * @param     source_id       The SSR id of the source, 0 unbinds the
+     *                            slot.
+     *
+     * @throws    out_of_range    If the slot is not less than slot_count.
+     */
+    void bind_slot(const std::size_t slot, const unsigned int source_id);
+
+    /**
+     * Returns the id of the source the transferred slot is bound to.
+     *
+     * @param     slot            The slot, less than slot_count.
+     *
+     * @return    the SSR id of the source, 0 if the slot is unbound.
+     */
+    unsigned int get_source_id(const std::size_t slot) const;
+
+    /**
+     * Writes the bindings of all slots to the transferred stream.
+     *
+     * @param     output          The stream the bindings are written to.
+     */
+    void write_state(juce::OutputStream& output) const;
+
+    /**
+     * Restores the bindings written by write_state. Slots beyond slot_count
+     * are skipped, missing slots keep their binding. The bindings are only
+     * changed if the whole section could be read.
+     *
+     * @param     input           The stream the bindings are read from.
+     *
+     * @throws    runtime_error   If the section is truncated.
+     */
+    void read_state(juce::InputStream& input);
+
+  private:
+
+    /**
+     * The slot and field of every VST parameter index.
+     */
+    std::array<Address, parameter_count> addresses;
+
+    /**
+     * The name of every VST parameter index.
+     */
+    std::vector<std::string> names;
+
+    /**
+     * The source id every slot is bound to.
+     */
+    std::array<std::atomic<unsigned int>, slot_count> bindings;
+
+  };
+
+}
+
+#endif
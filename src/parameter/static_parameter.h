@@ -0,0 +1,237 @@
+#ifndef STATIC_PARAMETER_H
+#define STATIC_PARAMETER_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <ostream>
+#include <string>
+
+namespace SSR {
+
+    /**
+     * This class represents a VST parameter like SSR::Parameter, but takes its
+     * translation functions and its name from the compile time policy
+     * Translation instead of storing them per instance.
+     *
+     * The Translation policy has to provide:
+     *
+     * - static ContinuousType to_continuous(DiscreteType discrete, float scene_range)
+     * - static DiscreteType to_discrete(ContinuousType continuous, float scene_range)
+     * - static const char* name()
+     *
+     * The scene range is the only runtime information a translation gets, it
+     * is stored as field. All members are plain values, so a Static_parameter
+     * is trivially copyable and the translation calls can be inlined.
+     *
+     * Example on how to use this class:
+     *
+     * SSR::Static_parameter<bool, float, SSR::translations::Mute> p(false, false);
+     *
+     * p.set_continuous_value(1.0f);
+     * std::cout << p << std::endl;
+     *
+     * Output:
+     *
+     * Mute: Discrete Value -> 1 | Continuous Value -> 1
+     *
+     * @tparam  DiscreteType    The type of the discrete value.
+     * @tparam  ContinuousType  The type of the continuous value (float in
+     *                          general).
+     * @tparam  Translation     The translation policy.
+     */
+    template<class DiscreteType, class ContinuousType, class Translation>
+    class Static_parameter {
+
+    public:
+
+        /**
+         * Constructs a Static_parameter object with the transferred
+         * parameters.
+         *
+         * @param   discrete_value          The discrete value the parameter is
+         *                                  initialised with.
+         *
+         * @param   default_discrete_value  The default discrete value the
+         *                                  parameter can be set to.
+         *
+         * @param   scene_range             The scene range which is passed to
+         *                                  the translation functions.
+         */
+        Static_parameter(          DiscreteType discrete_value,
+                                   DiscreteType default_discrete_value,
+                                   float scene_range = 0.0f)
+                : discrete_value(discrete_value)
+                , default_discrete_value(default_discrete_value)
+                , continuous_value(Translation::to_continuous(discrete_value, scene_range))
+                , scene_range(scene_range)
+        {
+
+        }
+
+        /**
+         * Returns the discrete value.
+         *
+         * @return the discrete value.
+         */
+        DiscreteType get_discrete_value() const
+        {
+            return discrete_value;
+        }
+
+        /**
+         * Returns the continuous value.
+         *
+         * @return the continuous value.
+         */
+        ContinuousType get_continuous_value() const
+        {
+            return continuous_value;
+        }
+
+        /**
+         * Sets the Parameters discrete value to new_discrete_value and
+         * also the continuous value by translating it.
+         *
+         * @param    new_discrete_value       The new discrete value to
+         *                                    which the Parameters value
+         *                                    will be set.
+         */
+        void set_discrete_value(const DiscreteType new_discrete_value)
+        {
+            discrete_value = new_discrete_value;
+            continuous_value = Translation::to_continuous(discrete_value, scene_range);
+        }
+
+        /**
+         * Sets the Parameters continuous value to new_continuous_value and
+         * also the discrete value by translating it.
+         *
+         * @param    new_continuous_value       The new continuous value to
+         *                                      which the Parameters value
+         *                                      will be set.
+         */
+        void set_continuous_value(const ContinuousType new_continuous_value)
+        {
+            continuous_value = new_continuous_value;
+            discrete_value = Translation::to_discrete(continuous_value, scene_range);
+        }
+
+        /**
+         * Sets the Parameter to the default value which was set during
+         * construction.
+         */
+        void set_to_default()
+        {
+            discrete_value = default_discrete_value;
+            continuous_value = Translation::to_continuous(discrete_value, scene_range);
+        }
+
+        /**
+         * Returns the scene range passed to the translation functions.
+         *
+         * @return the scene range.
+         */
+        float get_scene_range() const
+        {
+            return scene_range;
+        }
+
+        /**
+         * This method returns the name of the parameter.
+         *
+         * @return the name of the parameter.
+         */
+        std::string get_name() const
+        {
+            return Translation::name();
+        }
+
+    private:
+
+        /**
+         * The discrete representation of the Parameters value.
+         */
+        DiscreteType discrete_value;
+
+        /**
+         * The default discrete value.
+         */
+        DiscreteType default_discrete_value;
+
+        /**
+         * The continuous representation of the Parameters value.
+         */
+        ContinuousType continuous_value;
+
+        /**
+         * The scene range passed to the translation functions.
+         */
+        float scene_range;
+
+    };
+
+    /**
+     * Equal operator returning true if the discrete and continuous values of
+     * lhs and rhs are equal, else false.
+     *
+     * @param       lhs         The left hand side parameter.
+     *
+     * @param       rhs         The right hand side parameter.
+     *
+     * @return true if the lhs and rhs parameters are equal, else false.
+     */
+    template <class DiscreteType, class ContinuousType, class Translation>
+    bool operator==(const Static_parameter<DiscreteType, ContinuousType, Translation>& lhs, const Static_parameter<DiscreteType, ContinuousType, Translation>& rhs)
+    {
+        return (lhs.get_discrete_value() == rhs.get_discrete_value()) && (lhs.get_continuous_value() == rhs.get_continuous_value());
+    }
+
+    /**
+     * Unequal operator returning false if the lhs and rhs parameters are
+     * equal, else true.
+     *
+     * @param       lhs         The left hand side parameter.
+     *
+     * @param       rhs         The right hand side parameter.
+     *
+     * @return false if the lhs and rhs parameters are equal, else true.
+     */
+    template <class DiscreteType, class ContinuousType, class Translation>
+    bool operator!=(const Static_parameter<DiscreteType, ContinuousType, Translation>& lhs, const Static_parameter<DiscreteType, ContinuousType, Translation>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * Returning an output stream containing the parameter data as a string as
+     * follows:
+     *
+     * 'name': Discrete Value -> 'discrete_value' | Continuous Value -> 'continuous_value'
+     *
+     * @param               os              The output stream.
+     *
+     * @param               parameter       The parameter.
+     *
+     * @return the output stream.
+     */
+    template <class DiscreteType, class ContinuousType, class Translation>
+    std::ostream& operator<<(std::ostream& os, const Static_parameter<DiscreteType, ContinuousType, Translation>& parameter)
+    {
+        os << Translation::name() << ": Discrete Value -> " << parameter.get_discrete_value() << " | Continuous Value -> " << parameter.get_continuous_value();
+        return os;
+    }
+
+}
+
+#endif
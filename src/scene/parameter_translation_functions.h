@@ -13,6 +13,13 @@
  * For more detailed information, please read the license.txt in the root directory.
  */
 
+//C++ Libs
+#include <cmath>
+#include <algorithm>
+
+//Boost Libs
+#include <boost/math/constants/constants.hpp>
+
 namespace SSR
 {
 
@@ -53,7 +60,22 @@ namespace SSR
      *
      * @author Florian Willich
      */
-    float x_position_discrete_to_continuous(float discrete_position, double scene_range);
+    inline float x_position_discrete_to_continuous(float discrete_position, double scene_range)
+    {
+      float relative_position = 0.0f;
+      float lower_bound = scene_range / -2.0f;
+      float upper_bound = scene_range / 2.0f;
+
+      if (discrete_position <= lower_bound) {
+          relative_position = 0.0f;
+      } else if (discrete_position >= upper_bound) {
+          relative_position = 1.0f;
+      } else {
+          relative_position = (0.5 / upper_bound) * discrete_position + 0.5;
+      }
+
+      return relative_position;
+    }
 
     /**
      * Computes the discrete source X position from the continuous X position
@@ -77,7 +99,21 @@ namespace SSR
      *
      * @author Florian Willich
      */
-    float x_position_continuous_to_discrete(float continuous_position, double scene_range);
+    inline float x_position_continuous_to_discrete(float continuous_position, double scene_range)
+    {
+      float discrete_position = 0.0f;
+      float margin = scene_range / 2.0f;
+
+      if (continuous_position >= 1.0f) {
+          discrete_position = margin;
+      } else if (continuous_position <= 0.0f) {
+          discrete_position = margin * -1.0f;
+      } else {
+          discrete_position = scene_range * continuous_position - margin;
+      }
+
+      return discrete_position;
+    }
 
     /**
      * Computes the source continuous Y position from discrete value and
@@ -101,7 +137,24 @@ namespace SSR
      *
      * @author Florian Willich
      */
-    float y_position_discrete_to_continuous(float discrete_position, double scene_range);
+    inline float y_position_discrete_to_continuous(float discrete_position, double scene_range)
+    {
+      discrete_position *= -1.0f;
+
+      float continuous_position = 0.0f;
+      float lower_bound = scene_range / -2.0f;
+      float upper_bound = scene_range / 2.0f;
+
+      if (discrete_position <= lower_bound) {
+          continuous_position = 0.0f;
+      } else if (discrete_position >= upper_bound) {
+          continuous_position = 1.0f;
+      } else {
+          continuous_position = (0.5 / upper_bound) * discrete_position + 0.5;
+      }
+
+      return continuous_position;
+    }
 
     /**
      * Computes the discrete source Y position from the continuous Y position
@@ -126,7 +179,21 @@ namespace SSR
      *
      * @author Florian Willich
      */
-    float y_position_continuous_to_discrete(float continuous_position, double scene_range);
+    inline float y_position_continuous_to_discrete(float continuous_position, double scene_range)
+    {
+      float discrete_position = 0.0f;
+      float margin = scene_range / 2.0f;
+
+      if (continuous_position >= 1.0f) {
+          discrete_position = margin;
+      } else if (continuous_position <= 0.0f) {
+          discrete_position = margin * -1.0f;
+      } else {
+          discrete_position = scene_range * continuous_position - margin;
+      }
+
+      return discrete_position * -1.0f;
+    }
 
     /**
      * Computes the continuous linear gain from the discrete linear gain
@@ -138,7 +205,15 @@ namespace SSR
      *
      * @author Florian Willich
      */
-    float gain_discrete_to_continuous(float discrete_linear_gain);
+    inline float gain_discrete_to_continuous(float discrete_linear_gain)
+    {
+      float continuous_value = discrete_linear_gain / 4.0f;
+
+      continuous_value = std::min(continuous_value, 1.0f);
+      continuous_value = std::max(continuous_value, 0.0f);
+
+      return continuous_value;
+    }
 
     /**
      * Computes the discrete linear gain from the continuouos linear gain.
@@ -149,7 +224,10 @@ namespace SSR
      *
      * @author Florian Willich
      */
-    float gain_continuous_to_discrete(float continuous_linear_gain);
+    constexpr float gain_continuous_to_discrete(float continuous_linear_gain)
+    {
+      return continuous_linear_gain * 4.0f;
+    }
 
     /**
      * Computes the continuous orientation from the discrete orientation.
@@ -165,7 +243,15 @@ namespace SSR
      *
      * @author Florian Willich
      */
-    float orientation_discrete_to_continuous(float discrete_orientation);
+    inline float orientation_discrete_to_continuous(float discrete_orientation)
+    {
+      float continuous_orientation = discrete_orientation / (2 *  boost::math::float_constants::pi);
+
+      continuous_orientation = std::min(continuous_orientation, 1.0f);
+      continuous_orientation = std::max(continuous_orientation, 0.0f);
+
+      return continuous_orientation;
+    }
 
     /**
      * Computes the discrete orientation from the continuous orientation.
@@ -181,7 +267,13 @@ namespace SSR
      *
      * @author Florian Willich
      */
-    float orientation_continuous_to_discrete(float continuous_orientation);
+    inline float orientation_continuous_to_discrete(float continuous_orientation)
+    {
+      float discrete_orientation = continuous_orientation * 2 * boost::math::float_constants::pi;
+      discrete_orientation = std::fmod(discrete_orientation, 2 * boost::math::float_constants::pi);
+
+      return discrete_orientation;
+    }
 
     /**
      * Computes the continuous mute value from the discrete mute value as
@@ -195,7 +287,10 @@ namespace SSR
      *
      * @author Florian Willich
      */
-    float mute_discrete_to_continuous(bool discrete_mute);
+    constexpr float mute_discrete_to_continuous(bool discrete_mute)
+    {
+      return discrete_mute ? 1.0f : 0.0f;
+    }
 
     /**
      * Computes the discrete mute value from the continuous mute value as
@@ -207,7 +302,10 @@ namespace SSR
      *
      * @return true if continuous_mute is 1.0, false otherwise.
      */
-    bool mute_continuous_to_discrete(float continuous_mute);
+    constexpr bool mute_continuous_to_discrete(float continuous_mute)
+    {
+      return continuous_mute == 1.0f;
+    }
 
     /**
      * Computes the continuous model point value from the discrete model point
@@ -221,7 +319,10 @@ namespace SSR
      *
      * @author Florian Willich
      */
-    float model_point_discrete_to_continuous(bool discrete_model);
+    constexpr float model_point_discrete_to_continuous(bool discrete_model)
+    {
+      return discrete_model ? 1.0f : 0.0f;
+    }
 
     /**
      * Computes the discrete model point value from the continuous model point
@@ -233,7 +334,10 @@ namespace SSR
      *
      * @return true if continuous_model is 1.0, false otherwise.
      */
-    bool model_point_continuous_to_discrete(float continuous_model);
+    constexpr bool model_point_continuous_to_discrete(float continuous_model)
+    {
+      return continuous_model == 1.0f;
+    }
 
     /**
      * Computes the continuous fixed value from the discrete fixed
@@ -247,7 +351,10 @@ namespace SSR
      *
      * @author Florian Willich
      */
-    float fixed_discrete_to_continuous(bool discrete_fixed);
+    constexpr float fixed_discrete_to_continuous(bool discrete_fixed)
+    {
+      return discrete_fixed ? 1.0f : 0.0f;
+    }
 
     /**
      * Computes the discrete fixed value from the continuous fixed value as
@@ -259,7 +366,86 @@ namespace SSR
      *
      * @return true if continuous_fixed is 1.0, false otherwise.
      */
-    bool fixed_continuous_to_discrete(float continuous_fixed);
+    constexpr bool fixed_continuous_to_discrete(float continuous_fixed)
+    {
+      return continuous_fixed == 1.0f;
+    }
+
+    /**
+     * The following policies bundle the name of a source parameter with its
+     * translation functions for SSR::Static_parameter. Every policy takes the
+     * scene range, policies of parameters not depending on it ignore it.
+     */
+
+    /**
+     * Translation policy of the X position.
+     */
+    struct X_position
+    {
+      static const char* name() { return "X Position"; }
+      static float to_continuous(float discrete, float scene_range) { return x_position_discrete_to_continuous(discrete, scene_range); }
+      static float to_discrete(float continuous, float scene_range) { return x_position_continuous_to_discrete(continuous, scene_range); }
+    };
+
+    /**
+     * Translation policy of the Y position.
+     */
+    struct Y_position
+    {
+      static const char* name() { return "Y Position"; }
+      static float to_continuous(float discrete, float scene_range) { return y_position_discrete_to_continuous(discrete, scene_range); }
+      static float to_discrete(float continuous, float scene_range) { return y_position_continuous_to_discrete(continuous, scene_range); }
+    };
+
+    /**
+     * Translation policy of the (linear) gain.
+     */
+    struct Gain
+    {
+      static const char* name() { return "Gain"; }
+      static float to_continuous(float discrete, float) { return gain_discrete_to_continuous(discrete); }
+      static constexpr float to_discrete(float continuous, float) { return gain_continuous_to_discrete(continuous); }
+    };
+
+    /**
+     * Translation policy of the orientation.
+     */
+    struct Orientation
+    {
+      static const char* name() { return "Orientation"; }
+      static float to_continuous(float discrete, float) { return orientation_discrete_to_continuous(discrete); }
+      static float to_discrete(float continuous, float) { return orientation_continuous_to_discrete(continuous); }
+    };
+
+    /**
+     * Translation policy of mute.
+     */
+    struct Mute
+    {
+      static const char* name() { return "Mute"; }
+      static constexpr float to_continuous(bool discrete, float) { return mute_discrete_to_continuous(discrete); }
+      static constexpr bool to_discrete(float continuous, float) { return mute_continuous_to_discrete(continuous); }
+    };
+
+    /**
+     * Translation policy of the source model.
+     */
+    struct Model_point
+    {
+      static const char* name() { return "Model"; }
+      static constexpr float to_continuous(bool discrete, float) { return model_point_discrete_to_continuous(discrete); }
+      static constexpr bool to_discrete(float continuous, float) { return model_point_continuous_to_discrete(continuous); }
+    };
+
+    /**
+     * Translation policy of fixed.
+     */
+    struct Fixed
+    {
+      static const char* name() { return "Fixed"; }
+      static constexpr float to_continuous(bool discrete, float) { return fixed_discrete_to_continuous(discrete); }
+      static constexpr bool to_discrete(float continuous, float) { return fixed_continuous_to_discrete(continuous); }
+    };
 
   }
 
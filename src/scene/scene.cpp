@@ -16,21 +16,29 @@
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
 
 //Own Libs
 #include <src/scene/source.h>
-#include <src/parameter/parameter.h>
+#include <src/scene/update_parser.h>
+#include <src/utils/state_stream.h>
+#include <src/utils/metrics.h>
 
 //JUCE Lib
 #include <JUCE/JuceHeader.h>
 
-typedef std::vector<SSR::Source>::iterator source_iterator;
-
 SSR::Scene::Scene(float scene_range)
-: sources(new std::vector<SSR::Source>())
-, ids_and_names(new std::vector< std::pair<unsigned int, std::string> >())
+: sources()
+, source_handles()
+, current_selected_source(Source_map::invalid_handle())
 , scene_range(scene_range)
-, current_selected_source()
+, ids_and_names(new std::vector< std::pair<unsigned int, std::string> >())
+, changes(all_changed)
+, update_parser()
+, parsed_updates()
+, text_buffer()
 {
   new_source("Default Source");
 }
@@ -40,67 +48,130 @@ SSR::Scene::~Scene()
 
 }
 
-void SSR::Scene::interpret_xml_message(std::string xml_message)
+void SSR::Scene::interpret_xml_message(const std::string& xml_message)
 {
+  interpret_xml_message(xml_message.data(), xml_message.size());
+}
 
-  XmlDocument xml_document(xml_message);
-  auto main_element = std::unique_ptr<juce::XmlElement>(xml_document.getDocumentElement());
+void SSR::Scene::interpret_xml_message(const char* data, const std::size_t size)
+{
+  const unsigned long long start_in_usec = SSR::Metrics::now_in_usec();
 
-  if (main_element->hasTagName("update")) {
+  update_parser.parse(data, size, parsed_updates);
+  SSR::Metrics::get_instance().add_duration(SSR::Metrics::parse_time_in_usec, SSR::Metrics::parsed_messages, start_in_usec);
 
-      forEachXmlChildElement (*main_element, e) {
+  apply_updates(parsed_updates, data);
+}
 
-        if (e->hasTagName("source")) {
+void SSR::Scene::apply_updates(const std::vector<SSR::Source_update>& updates, const char* texts)
+{
+  for (const SSR::Source_update& update : updates) {
 
-            if (e->hasAttribute("id")) {
+      if (update.deleted) {
+          remove_source(update.id);
+      }
 
-                int id = e->getIntAttribute("id");
+      if (update.fields == 0) {
+          continue;
+      }
 
-                if (id_already_in_use(id)) {
+      SSR::Source* source = find_source(update.id);
 
-                    manipulate_source(get_iterator(id), e);
+      if (source != nullptr) {
 
-                } else {
+          manipulate_source(*source, update, texts);
 
-                    if (e->hasAttribute("name")) {
+      } else if (update.has(SSR::Source_update::name)) {
 
-                        std::string name = e->getStringAttribute("name").toStdString();
-                        sources->push_back(SSR::Source(id, name, scene_range));
-                        ids_and_names->push_back( std::pair<unsigned int, std::string>(id, name) );
-                        current_selected_source = sources->begin();
+          text_buffer.clear();
+          SSR::Update_parser::append_text(texts, update.name_text, text_buffer);
+          source = sources.get(add_source(SSR::Source(update.id, text_buffer, scene_range)));
 
-                        manipulate_source(get_iterator(id), e);
+          manipulate_source(*source, update, texts);
 
-                    }
+      }
 
-                }
+  }
+}
 
-            }
+bool SSR::Scene::select_source(const int id)
+{
+  auto entry = source_handles.find(id);
 
-         }
+  if (entry == source_handles.end()) {
+      return false;
+  }
 
-      }
+  if (entry->second != current_selected_source) {
+      current_selected_source = entry->second;
+      mark_changed(selection_changed);
+  }
+
+  return true;
+}
+
+bool SSR::Scene::remove_source(const unsigned int id)
+{
+  auto entry = source_handles.find(id);
+
+  if (entry == source_handles.end() || sources.size() == 1) {
+      return false;
+  }
+
+  const Source_map::Handle handle = entry->second;
 
-      main_element->deleteAllChildElements();
+  sources.erase(handle);
+  source_handles.erase(entry);
+  ids_and_names->erase(std::remove_if(ids_and_names->begin(), ids_and_names->end(), [id](const std::pair<unsigned int, std::string>& p) { return p.first == id; }), ids_and_names->end());
 
+  if (handle == current_selected_source) {
+      current_selected_source = sources.handle_at(0);
+      mark_changed(selection_changed);
   }
 
+  mark_changed(source_list_changed);
+
+  return true;
 }
 
-bool SSR::Scene::select_source(const int id)
+std::size_t SSR::Scene::retain_sources(const std::vector<unsigned int>& ids)
 {
-  bool source_is_selected = false;
+  std::vector<unsigned int> stale_ids;
+
+  for (const SSR::Source& source : sources) {
+
+      if (std::find(ids.begin(), ids.end(), source.get_id()) == ids.end()) {
+          stale_ids.push_back(source.get_id());
+      }
+
+  }
+
+  std::size_t removed = 0;
 
-  for (source_iterator it = sources->begin(); it != sources->end(); it++) {
+  for (const unsigned int id : stale_ids) {
 
-      if (it->get_id() == id) {
-          current_selected_source = it;
-          source_is_selected = true;
+      if (remove_source(id)) {
+          removed++;
       }
 
   }
 
-  return source_is_selected;
+  return removed;
+}
+
+bool SSR::Scene::set_position_of_source(const unsigned int id, const float x, const float y)
+{
+  SSR::Source* source = find_source(id);
+
+  if (source == nullptr) {
+      return false;
+  }
+
+  source->set_x_position_discrete(x);
+  source->set_y_position_discrete(y);
+  mark_changed(id, position_changed);
+
+  return true;
 }
 
 std::shared_ptr< std::vector< std::pair<unsigned int, std::string> > > SSR::Scene::get_source_ids_and_names()
@@ -110,16 +181,42 @@ std::shared_ptr< std::vector< std::pair<unsigned int, std::string> > > SSR::Scen
 
 SSR::Source SSR::Scene::get_source() const
 {
-  SSR::Source s = *current_selected_source;
+  SSR::Source s = selected_source();
   return s;
 }
 
+void SSR::Scene::for_each_source(const std::function<void(const SSR::Source&)>& visit) const
+{
+  for (const SSR::Source& source : sources) {
+      visit(source);
+  }
+}
+
+const SSR::Source* SSR::Scene::get_source(const unsigned int id) const
+{
+  auto entry = source_handles.find(id);
+  return (entry == source_handles.end()) ? nullptr : sources.get(entry->second);
+}
+
+bool SSR::Scene::set_parameter_continuous_of_source(const unsigned int id, const SSR::Source::parameter field, const float value)
+{
+  SSR::Source* source = find_source(id);
+
+  if (source == nullptr) {
+      return false;
+  }
+
+  source->set_continuous_value(field, value);
+  mark_changed(id, change_of(field));
+
+  return true;
+}
+
 unsigned int SSR::Scene::new_source(const std::string name)
 {
   unsigned int id = get_next_id();
-  sources->push_back(SSR::Source(id, name, scene_range));
-  ids_and_names->push_back( std::pair<unsigned int, std::string>(id, name) );
-  current_selected_source = get_iterator(id);
+  current_selected_source = add_source(SSR::Source(id, name, scene_range));
+  mark_changed(selection_changed);
   return id;
 }
 
@@ -128,9 +225,8 @@ bool SSR::Scene::new_source(const std::string name, const unsigned int id)
   bool source_successfully_created = false;
 
   if (!id_already_in_use(id)) {
-      sources->push_back(SSR::Source(id, name, scene_range));
-      ids_and_names->push_back( std::pair<unsigned int, std::string>(id, name) );
-      current_selected_source = get_iterator(id);
+      current_selected_source = add_source(SSR::Source(id, name, scene_range));
+      mark_changed(selection_changed);
       source_successfully_created = true;
   }
 
@@ -142,9 +238,8 @@ bool SSR::Scene::new_source(const std::string name, const unsigned int id, const
   bool source_successfully_created = false;
 
   if (!id_already_in_use(id)) {
-      sources->push_back(SSR::Source(id, name, scene_range, jackport));
-      ids_and_names->push_back( std::pair<unsigned int, std::string>(id, name) );
-      current_selected_source = get_iterator(id);
+      current_selected_source = add_source(SSR::Source(id, name, scene_range, jackport));
+      mark_changed(selection_changed);
       source_successfully_created = true;
   }
 
@@ -153,185 +248,288 @@ bool SSR::Scene::new_source(const std::string name, const unsigned int id, const
 
 void SSR::Scene::set_id_of_selected_source(const int id)
 {
-  set_id_of_source(current_selected_source->get_id(), id);
+  set_id_of_source(selected_source().get_id(), id);
 }
 
 int SSR::Scene::get_id_of_selected_source() const
 {
-  return current_selected_source->get_id();
+  return selected_source().get_id();
+}
+
+float SSR::Scene::get_scene_range() const
+{
+  return scene_range;
 }
 
 void SSR::Scene::set_x_position_discrete_of_selected_source(const float position)
 {
-  current_selected_source->set_x_position_discrete(position);
+  selected_source().set_x_position_discrete(position);
+  mark_changed(position_changed);
 }
 
 void SSR::Scene::set_x_position_continuous_of_selected_source(const float position)
 {
-  current_selected_source->set_x_position_continuous(position);
+  selected_source().set_x_position_continuous(position);
+  mark_changed(position_changed);
 }
 
-SSR::Parameter<float, float> SSR::Scene::get_x_position_of_selected_source() const
+SSR::X_position_parameter SSR::Scene::get_x_position_of_selected_source() const
 {
-  return current_selected_source->get_x_position();
+  return selected_source().get_x_position();
 }
 
 void SSR::Scene::set_y_position_discrete_of_selected_source(const float position)
 {
-  current_selected_source->set_y_position_discrete(position);
+  selected_source().set_y_position_discrete(position);
+  mark_changed(position_changed);
 }
 
 void SSR::Scene::set_y_position_continuous_of_selected_source(const float position)
 {
-  current_selected_source->set_y_position_continuous(position);
+  selected_source().set_y_position_continuous(position);
+  mark_changed(position_changed);
 }
 
-SSR::Parameter<float, float> SSR::Scene::get_y_position_of_selected_source() const
+SSR::Y_position_parameter SSR::Scene::get_y_position_of_selected_source() const
 {
-  return current_selected_source->get_y_position();
+  return selected_source().get_y_position();
 }
 
 void SSR::Scene::set_gain_discrete_of_selected_source(const float gain, const bool linear)
 {
-  current_selected_source->set_discrete_gain(gain, linear);
+  selected_source().set_discrete_gain(gain, linear);
+  mark_changed(gain_changed);
 }
 
 void SSR::Scene::set_gain_continuous_of_selected_source(const float gain)
 {
-  current_selected_source->set_continuous_gain(gain);
+  selected_source().set_continuous_gain(gain);
+  mark_changed(gain_changed);
 }
 
-SSR::Parameter<float, float> SSR::Scene::get_gain_of_selected_source() const
+SSR::Gain_parameter SSR::Scene::get_gain_of_selected_source() const
 {
-  return current_selected_source->get_gain();
+  return selected_source().get_gain();
 }
 
 void SSR::Scene::set_orientation_discrete_of_selected_source(const float orientation)
 {
-  current_selected_source->set_discrete_orientation(orientation);
+  selected_source().set_discrete_orientation(orientation);
+  mark_changed(orientation_changed);
 }
 
 void SSR::Scene::set_orientation_continuous_of_selected_source(const float orientation)
 {
-  current_selected_source->set_continuous_orientation(orientation);
+  selected_source().set_continuous_orientation(orientation);
+  mark_changed(orientation_changed);
 }
 
-SSR::Parameter<float, float> SSR::Scene::get_orientation_of_selected_source() const
+SSR::Orientation_parameter SSR::Scene::get_orientation_of_selected_source() const
 {
-  return current_selected_source->get_orientation();
+  return selected_source().get_orientation();
 }
 
 void SSR::Scene::set_mute_discrete_of_selected_source(const bool mute)
 {
-  current_selected_source->set_discrete_mute(mute);
+  selected_source().set_discrete_mute(mute);
+  mark_changed(mute_changed);
 }
 
 void SSR::Scene::set_mute_continuous_of_selected_source(const float mute)
 {
-  current_selected_source->set_continuous_mute(mute);
+  selected_source().set_continuous_mute(mute);
+  mark_changed(mute_changed);
 }
 
-SSR::Parameter<bool, float> SSR::Scene::get_mute_of_selected_source() const
+SSR::Mute_parameter SSR::Scene::get_mute_of_selected_source() const
 {
-  return current_selected_source->get_mute();
+  return selected_source().get_mute();
 }
 
 void SSR::Scene::set_model_point_discrete_of_selected_source(const bool point)
 {
-  current_selected_source->set_discrete_model_point(point);
+  selected_source().set_discrete_model_point(point);
+  mark_changed(model_changed);
 }
 
 void SSR::Scene::set_model_point_continuous_of_selected_source(const float point)
 {
-  current_selected_source->set_continuous_model_point(point);
+  selected_source().set_continuous_model_point(point);
+  mark_changed(model_changed);
 }
 
-SSR::Parameter<bool, float> SSR::Scene::get_model_point_of_selected_source() const
+SSR::Model_point_parameter SSR::Scene::get_model_point_of_selected_source() const
 {
-  return current_selected_source->get_model_point();
+  return selected_source().get_model_point();
 }
 
 void SSR::Scene::set_fixed_discrete_of_selected_source(const bool fixed)
 {
-  current_selected_source->set_discrete_fixed(fixed);
+  selected_source().set_discrete_fixed(fixed);
+  mark_changed(fixed_changed);
 }
 
 void SSR::Scene::set_fixed_continuous_of_selected_source(const float fixed)
 {
-  current_selected_source->set_continuous_fixed(fixed);
+  selected_source().set_continuous_fixed(fixed);
+  mark_changed(fixed_changed);
 }
 
-SSR::Parameter<bool, float> SSR::Scene::get_fixed_of_selected_source() const
+SSR::Fixed_parameter SSR::Scene::get_fixed_of_selected_source() const
 {
-  return current_selected_source->get_fixed();
+  return selected_source().get_fixed();
 }
 
 void SSR::Scene::set_name_of_selected_source(const std::string name)
 {
-  set_name_of_source(current_selected_source->get_id(), name);
+  set_name_of_source(selected_source().get_id(), name);
 }
 
 std::string SSR::Scene::get_name_of_selected_source() const
 {
-  return current_selected_source->get_name();
+  return selected_source().get_name();
 }
 
 void SSR::Scene::set_properties_file_of_selected_source(const std::string prop_file)
 {
-  current_selected_source->set_properties_file(prop_file);
+  selected_source().set_properties_file(prop_file);
+  mark_changed(properties_file_changed);
 }
 
 std::string SSR::Scene::get_properties_file_of_selected_source() const
 {
-  return current_selected_source->get_properties_file();
+  return selected_source().get_properties_file();
 }
 
 void SSR::Scene::set_jackport_of_selected_source(const std::string value)
 {
-  current_selected_source->set_jackport(value);
+  selected_source().set_jackport(value);
+  mark_changed(jackport_changed);
 }
 
 std::string SSR::Scene::get_jackport_of_selected_source() const
 {
-  return current_selected_source->get_jackport();
+  return selected_source().get_jackport();
+}
+
+void SSR::Scene::write_state(juce::OutputStream& output) const
+{
+  output.writeFloat(scene_range);
+  output.writeInt(get_id_of_selected_source());
+  output.writeInt(static_cast<int>(sources.size()));
+
+  for (const SSR::Source& source : sources) {
+      write_source(output, source);
+  }
+}
+
+void SSR::Scene::read_state(juce::InputStream& input)
+{
+  const float restored_scene_range = SSR::state_stream::read_float(input);
+  const unsigned int selected_id = SSR::state_stream::read_uint32(input);
+  const juce::uint32 count = SSR::state_stream::read_count(input, min_source_state_size);
+
+  if (count == 0) {
+      throw std::runtime_error("Plugin state has no sources!");
+  }
+
+  std::vector<SSR::Source> restored_sources;
+  std::unordered_set<unsigned int> restored_ids;
+  restored_sources.reserve(count);
+
+  for (juce::uint32 index = 0; index < count; index++) {
+
+      restored_sources.push_back(read_source(input, restored_scene_range));
+
+      if (!restored_ids.insert(restored_sources.back().get_id()).second) {
+          throw std::runtime_error("Plugin state has a source id twice!");
+      }
+
+  }
+
+  sources = Source_map();
+  source_handles.clear();
+  ids_and_names->clear();
+  scene_range = restored_scene_range;
+
+  for (SSR::Source& source : restored_sources) {
+      add_source(std::move(source));
+  }
+
+  if (!select_source(static_cast<int>(selected_id))) {
+      current_selected_source = sources.handle_at(0);
+  }
+
+  mark_changed(all_changed);
+}
+
+unsigned int SSR::Scene::take_changes()
+{
+  return changes.exchange(0);
+}
+
+bool SSR::Scene::has_changes() const
+{
+  return changes != 0;
 }
 
 // PRIVATE
 
 bool SSR::Scene::id_already_in_use(unsigned int id_to_check)
 {
-  return std::any_of(begin(*ids_and_names), end(*ids_and_names), [&id_to_check](std::pair<unsigned int, std::string> p){ return id_to_check == p.first; });
+  return source_handles.count(id_to_check) != 0;
 }
 
 unsigned int SSR::Scene::get_next_id()
 {
   unsigned int next_id = 1;
-  std::for_each(begin(*ids_and_names), end(*ids_and_names), [&next_id](std::pair<unsigned int, std::string> p){
 
-    if (next_id == p.first) {
-        next_id++;
-    }
+  while (id_already_in_use(next_id)) {
+      next_id++;
+  }
 
-  });
   return next_id;
 }
 
-const source_iterator SSR::Scene::get_iterator(unsigned int id)
+SSR::Source* SSR::Scene::find_source(unsigned int id)
 {
+  auto entry = source_handles.find(id);
+  return (entry == source_handles.end()) ? nullptr : sources.get(entry->second);
+}
 
-  if (id_already_in_use(id)) {
-    return std::find_if(begin(*sources), end(*sources), [id](const SSR::Source s) { return id == s.get_id(); }  );
-  } else {
-    throw std::runtime_error("Source does not exist!");
-  }
+SSR::Source& SSR::Scene::selected_source()
+{
+  return *sources.get(current_selected_source);
+}
 
+const SSR::Source& SSR::Scene::selected_source() const
+{
+  return *sources.get(current_selected_source);
+}
+
+SSR::Scene::Source_map::Handle SSR::Scene::add_source(SSR::Source source)
+{
+  const unsigned int id = source.get_id();
+  const std::string name = source.get_name();
+  const Source_map::Handle handle = sources.insert(std::move(source));
+
+  source_handles[id] = handle;
+  ids_and_names->push_back( std::pair<unsigned int, std::string>(id, name) );
+  mark_changed(source_list_changed);
+
+  return handle;
 }
 
 void SSR::Scene::set_name_of_source(const unsigned int id, const std::string name)
 {
-  auto source = get_iterator(id);
+  SSR::Source* source = find_source(id);
+
+  if (source == nullptr) {
+      throw std::runtime_error("Source does not exist!");
+  }
+
   source->set_name(name);
-  std::for_each(begin(*ids_and_names), end(*ids_and_names), [&id, &name](std::pair<unsigned int, std::string> p) {
+  std::for_each(begin(*ids_and_names), end(*ids_and_names), [&id, &name](std::pair<unsigned int, std::string>& p) {
 
     if (p.first == id) {
         p.second = name;
@@ -339,13 +537,30 @@ void SSR::Scene::set_name_of_source(const unsigned int id, const std::string nam
 
   });
 
+  mark_changed(source_list_changed);
+  mark_changed(id, name_changed);
+
 }
 
 void SSR::Scene::set_id_of_source(const unsigned int old_id, const unsigned int new_id)
 {
-  auto source = get_iterator(old_id);
-  source->set_id(new_id);
-  std::for_each(begin(*ids_and_names), end(*ids_and_names), [&old_id, &new_id](std::pair<unsigned int, std::string> p) {
+  auto entry = source_handles.find(old_id);
+
+  if (entry == source_handles.end()) {
+      throw std::runtime_error("Source does not exist!");
+  }
+
+  if (old_id == new_id || id_already_in_use(new_id)) {
+      return;
+  }
+
+  const Source_map::Handle handle = entry->second;
+
+  sources.get(handle)->set_id(new_id);
+  source_handles.erase(entry);
+  source_handles[new_id] = handle;
+  mark_changed(source_list_changed);
+  std::for_each(begin(*ids_and_names), end(*ids_and_names), [&old_id, &new_id](std::pair<unsigned int, std::string>& p) {
 
     if (p.first == old_id) {
         p.first = new_id;
@@ -354,68 +569,150 @@ void SSR::Scene::set_id_of_source(const unsigned int old_id, const unsigned int
   });
 }
 
-void SSR::Scene::manipulate_source(source_iterator source_to_manipulate, juce::XmlElement* element)
+void SSR::Scene::manipulate_source(SSR::Source& source_to_manipulate, const SSR::Source_update& update, const char* message)
 {
 
-  if (element->hasAttribute("volume")) {
-      source_to_manipulate->set_discrete_gain(static_cast<float>(element->getDoubleAttribute("volume")), false);
+  if (update.has(SSR::Source_update::volume)) {
+      source_to_manipulate.set_discrete_gain(update.volume_in_db, false);
   }
 
-  if (element->hasAttribute("name")) {
-      std::string name = element->getStringAttribute("name").toStdString();
-      set_name_of_source(source_to_manipulate->get_id(), name);
+  if (update.has(SSR::Source_update::name)) {
+      text_buffer.clear();
+      SSR::Update_parser::append_text(message, update.name_text, text_buffer);
+      set_name_of_source(source_to_manipulate.get_id(), text_buffer);
   }
 
-  if (element->hasAttribute("mute")) {
-      source_to_manipulate->set_discrete_mute(element->getBoolAttribute("mute"));
+  if (update.has(SSR::Source_update::mute)) {
+      source_to_manipulate.set_discrete_mute(update.is_muted);
   }
 
-  if (element->hasAttribute("model")) {
-      source_to_manipulate->set_discrete_model_point(element->getStringAttribute("model").toStdString() == "point");
+  if (update.has(SSR::Source_update::model)) {
+      source_to_manipulate.set_discrete_model_point(update.model_point);
   }
 
-  if (element->hasAttribute("properties_file")) {
-      source_to_manipulate->set_properties_file(element->getStringAttribute("properties_file").toStdString());
+  if (update.has(SSR::Source_update::properties_file)) {
+      text_buffer.clear();
+      SSR::Update_parser::append_text(message, update.properties_file_text, text_buffer);
+      source_to_manipulate.set_properties_file(text_buffer);
   }
 
-  forEachXmlChildElement(*element, f) {
-
-    if (f->hasTagName("position")) {
-
-        if (f->hasAttribute("x")) {
-            source_to_manipulate->set_x_position_discrete(static_cast<float>(f->getDoubleAttribute("x")));
-        }
+  if (update.has(SSR::Source_update::x_position)) {
+      source_to_manipulate.set_x_position_discrete(update.x);
+  }
 
-        if (f->hasAttribute("y")) {
-            source_to_manipulate->set_y_position_discrete(static_cast<float>(f->getDoubleAttribute("y")));
-        }
+  if (update.has(SSR::Source_update::y_position)) {
+      source_to_manipulate.set_y_position_discrete(update.y);
+  }
 
-        if (f->hasAttribute("fixed")) {
-            source_to_manipulate->set_discrete_fixed(f->getBoolAttribute("fixed"));
-        } else {
-            source_to_manipulate->set_discrete_fixed(false);
-        }
+  if (update.has(SSR::Source_update::fixed)) {
+      source_to_manipulate.set_discrete_fixed(update.is_fixed);
+  }
 
-    } else {
+  if (update.has(SSR::Source_update::orientation)) {
+      source_to_manipulate.set_discrete_orientation(update.azimuth);
+  }
 
-        if (f->hasTagName("orientation")) {
+  if (update.has(SSR::Source_update::port)) {
+      text_buffer.clear();
+      SSR::Update_parser::append_text(message, update.port_text, text_buffer);
+      source_to_manipulate.set_jackport(text_buffer);
+  }
 
-            if (f->hasAttribute("azimuth")) {
-                source_to_manipulate->set_discrete_orientation(static_cast<float>(f->getDoubleAttribute("azimuth")));
-            }
+  // The changes of the name are marked by set_name_of_source.
+  static const unsigned int field_changes[SSR::Source_update::field_count] = {
+    position_changed,
+    position_changed,
+    fixed_changed,
+    orientation_changed,
+    gain_changed,
+    mute_changed,
+    model_changed,
+    0,
+    properties_file_changed,
+    jackport_changed
+  };
+
+  unsigned int change = 0;
+
+  for (int field = 0; field < SSR::Source_update::field_count; field++) {
+
+      if (update.has(static_cast<SSR::Source_update::Field>(field))) {
+          change |= field_changes[field];
+      }
 
-        } else {
+  }
 
-            if (f->hasTagName("port")) {
-                //WARNING: I put the getAllSubText() method in here because with getText()
-                //I dont get the string of the port
-                source_to_manipulate->set_jackport(f->getAllSubText().toStdString());
-            }
+  mark_changed(source_to_manipulate.get_id(), change);
+}
 
-        }
+void SSR::Scene::mark_changed(const unsigned int change)
+{
+  changes |= (change & position_changed) ? (change | scene_positions_changed) : change;
+}
 
-    }
+void SSR::Scene::mark_changed(const unsigned int id, const unsigned int change)
+{
+  if (change & position_changed) {
+      changes |= scene_positions_changed;
+  }
 
+  if (change != 0 && id == selected_source().get_id()) {
+      changes |= change;
   }
+}
 
+unsigned int SSR::Scene::change_of(const SSR::Source::parameter field)
+{
+  static const unsigned int parameter_changes[SSR::Source::parameter_count] = {
+    position_changed,
+    position_changed,
+    gain_changed,
+    orientation_changed,
+    mute_changed,
+    model_changed,
+    fixed_changed
+  };
+
+  return parameter_changes[field];
+}
+
+void SSR::Scene::write_source(juce::OutputStream& output, const SSR::Source& source)
+{
+  output.writeInt(static_cast<int>(source.get_id()));
+  output.writeFloat(source.get_x_position().get_discrete_value());
+  output.writeFloat(source.get_y_position().get_discrete_value());
+  output.writeFloat(source.get_gain().get_discrete_value());
+  output.writeFloat(source.get_orientation().get_discrete_value());
+  output.writeBool(source.get_mute().get_discrete_value());
+  output.writeBool(source.get_model_point().get_discrete_value());
+  output.writeBool(source.get_fixed().get_discrete_value());
+  SSR::state_stream::write_string(output, source.get_name());
+  SSR::state_stream::write_string(output, source.get_jackport());
+  SSR::state_stream::write_string(output, source.get_properties_file());
+}
+
+SSR::Source SSR::Scene::read_source(juce::InputStream& input, const float scene_range)
+{
+  const unsigned int id = SSR::state_stream::read_uint32(input);
+  const float x_position = SSR::state_stream::read_float(input);
+  const float y_position = SSR::state_stream::read_float(input);
+  const float linear_gain = SSR::state_stream::read_float(input);
+  const float orientation = SSR::state_stream::read_float(input);
+  const bool mute = SSR::state_stream::read_bool(input);
+  const bool model_point = SSR::state_stream::read_bool(input);
+  const bool fixed = SSR::state_stream::read_bool(input);
+  const std::string name = SSR::state_stream::read_string(input);
+  const std::string jackport = SSR::state_stream::read_string(input);
+
+  SSR::Source source(id, name, scene_range, jackport);
+  source.set_x_position_discrete(x_position);
+  source.set_y_position_discrete(y_position);
+  source.set_discrete_gain(linear_gain, true);
+  source.set_discrete_orientation(orientation);
+  source.set_discrete_mute(mute);
+  source.set_discrete_model_point(model_point);
+  source.set_discrete_fixed(fixed);
+  source.set_properties_file(SSR::state_stream::read_string(input));
+
+  return source;
 }
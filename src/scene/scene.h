@@ -14,11 +14,16 @@
 #define SCENE_H
 
 //C++ Libs
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <vector>
+#include <unordered_map>
 
 //Own Libs
 #include <src/scene/source.h>
+#include <src/scene/update_parser.h>
+#include <src/utils/slot_map.h>
 
 //JUCE Lib
 #include <JUCE/JuceHeader.h>
@@ -29,6 +34,11 @@ namespace SSR
   /**
    * This class represents the SSR scene with all related sources.
    *
+   * Every change is recorded in a change mask (see Change) which the GUI
+   * takes with take_changes() to update only the affected widgets. The field
+   * bits refer to the selected source only, except scene_positions_changed
+   * which is set if the position of any source changed.
+   *
    * @since 2015-07-20
    */
   class Scene
@@ -36,6 +46,25 @@ namespace SSR
 
   public:
 
+    /**
+     * The bits of the change mask.
+     */
+    enum Change {
+      selection_changed       = 1 << 0,
+      source_list_changed     = 1 << 1,
+      position_changed        = 1 << 2,
+      gain_changed            = 1 << 3,
+      orientation_changed     = 1 << 4,
+      mute_changed            = 1 << 5,
+      model_changed           = 1 << 6,
+      fixed_changed           = 1 << 7,
+      name_changed            = 1 << 8,
+      jackport_changed        = 1 << 9,
+      properties_file_changed = 1 << 10,
+      scene_positions_changed = 1 << 11,
+      all_changed             = (1 << 12) - 1
+    };
+
     /**
      * Creates a new Scene with the transferred scene range.
      */
@@ -53,7 +82,32 @@ namespace SSR
      * @param   xml_message             The XML message that shall be
      *                                  interpreted.
      */
-    void interpret_xml_message(std::string xml_message);
+    void interpret_xml_message(const std::string& xml_message);
+
+    /**
+     * Interprets the transferred XML message directly from the buffer it was
+     * received into. The message is parsed by the Update_parser, no DOM is
+     * built.
+     *
+     * @param   data                    The XML message that shall be
+     *                                  interpreted.
+     *
+     * @param   size                    The length of the message.
+     */
+    void interpret_xml_message(const char* data, const std::size_t size);
+
+    /**
+     * Applies the transferred records, e.g. the merged records of an
+     * Inbound_coalescer. A record of a deleted source removes it first and
+     * then applies its remaining fields, an unknown source is created if the
+     * record carries a name.
+     *
+     * @param   updates                 The records that shall be applied.
+     *
+     * @param   texts                   The buffer the text spans of the
+     *                                  records refer to.
+     */
+    void apply_updates(const std::vector<SSR::Source_update>& updates, const char* texts);
 
     /**
      * Changes the current selected source to the source with the transferred
@@ -66,6 +120,42 @@ namespace SSR
      */
     bool select_source(const int id);
 
+    /**
+     * Removes the source with the transferred id. If it was the current
+     * selected source, another source is selected. The last source of the
+     * scene is never removed since there always has to be a selected source.
+     *
+     * @param           id              The id of the source that shall be
+     *                                  removed.
+     *
+     * @return          true if the source was removed, false otherwise.
+     */
+    bool remove_source(const unsigned int id);
+
+    /**
+     * Removes all sources whose id is not in the transferred list, for
+     * example the sources restored from the DAW session which the SSR does
+     * not have. Like remove_source, the last source is never removed.
+     *
+     * @param           ids             The ids of the sources to keep.
+     *
+     * @return          the number of removed sources.
+     */
+    std::size_t retain_sources(const std::vector<unsigned int>& ids);
+
+    /**
+     * Sets the discrete position of the source with the transferred id.
+     *
+     * @param           id              The id of the source.
+     *
+     * @param           x               The discrete X position.
+     *
+     * @param           y               The discrete Y position.
+     *
+     * @return          true if the source exists, false otherwise.
+     */
+    bool set_position_of_source(const unsigned int id, const float x, const float y);
+
     /**
      * Creates a vector with the sources ids and names and
      * returns it.
@@ -81,6 +171,36 @@ namespace SSR
      */
     SSR::Source get_source() const;
 
+    /**
+     * Calls the transferred function for every source of the scene.
+     *
+     * @param   visit                   The function called per source.
+     */
+    void for_each_source(const std::function<void(const SSR::Source&)>& visit) const;
+
+    /**
+     * Returns the source having the transferred id.
+     *
+     * @param           id              The ID of the source.
+     *
+     * @return the source or nullptr if no source has the transferred id.
+     */
+    const SSR::Source* get_source(const unsigned int id) const;
+
+    /**
+     * Sets the continuous value of the transferred parameter of the source
+     * with the transferred id.
+     *
+     * @param           id              The ID of the source.
+     *
+     * @param           field           The parameter.
+     *
+     * @param           value           The new continuous value.
+     *
+     * @return          true if the source exists, false otherwise.
+     */
+    bool set_parameter_continuous_of_source(const unsigned int id, const SSR::Source::parameter field, const float value);
+
     /**
      * Creates a new source with the transferred name. The ID will automatically
      * be computed and assigned.
@@ -156,6 +276,13 @@ namespace SSR
      */
     int get_id_of_selected_source() const;
 
+    /**
+     * Returns the scene range the continuous positions are translated with.
+     *
+     * @return the scene range.
+     */
+    float get_scene_range() const;
+
     /**
      * Sets the discrete X position of the current selected source to
      * the transferred position.
@@ -181,7 +308,7 @@ namespace SSR
      *
      * @return the X position of the current selected source.
      */
-    SSR::Parameter<float, float> get_x_position_of_selected_source() const;
+    SSR::X_position_parameter get_x_position_of_selected_source() const;
 
     /**
      * Sets the discrete Y position of the current selected source to
@@ -208,7 +335,7 @@ namespace SSR
      *
      * @return the Y position of the current selected source.
      */
-    SSR::Parameter<float, float> get_y_position_of_selected_source() const;
+    SSR::Y_position_parameter get_y_position_of_selected_source() const;
 
     /**
      * Sets the discrete gain value of the current selected source to the
@@ -237,7 +364,7 @@ namespace SSR
      *
      * @return the gain of the current selected source.
      */
-    SSR::Parameter<float, float> get_gain_of_selected_source() const;
+    SSR::Gain_parameter get_gain_of_selected_source() const;
 
     /**
      * Sets the discrete orientation of the current selected source to the
@@ -262,7 +389,7 @@ namespace SSR
      *
      * @return the orientation of the current selected source.
      */
-    SSR::Parameter<float, float> get_orientation_of_selected_source() const;
+    SSR::Orientation_parameter get_orientation_of_selected_source() const;
 
     /**
      * Sets the discrete mute value of the current selected source to the
@@ -287,7 +414,7 @@ namespace SSR
      *
      * @return the mute parameter of the current selected source.
      */
-    SSR::Parameter<bool, float> get_mute_of_selected_source() const;
+    SSR::Mute_parameter get_mute_of_selected_source() const;
 
     /**
      * Sets the discrete source model of the current selected source where the
@@ -314,7 +441,7 @@ namespace SSR
      *
      * @return the source model of the current selected source.
      */
-    SSR::Parameter<bool, float> get_model_point_of_selected_source() const;
+    SSR::Model_point_parameter get_model_point_of_selected_source() const;
 
     /**
      * Sets the discrete value of the current selected source where the
@@ -341,7 +468,7 @@ namespace SSR
      *
      * @return the fixed parameter of the current selected source.
      */
-    SSR::Parameter<bool, float> get_fixed_of_selected_source() const;
+    SSR::Fixed_parameter get_fixed_of_selected_source() const;
 
     /**
      * Sets the name of the current selected source to the transferred
@@ -391,23 +518,64 @@ namespace SSR
      */
     std::string get_jackport_of_selected_source() const;
 
+    /**
+     * Writes the scene range, the id of the selected source and all sources
+     * with their parameters, names, jackports and properties files to the
+     * transferred stream.
+     *
+     * @see SSR::state_stream
+     *
+     * @param           output          The stream the scene is written to.
+     */
+    void write_state(juce::OutputStream& output) const;
+
+    /**
+     * Replaces the scene by the one written by write_state. The scene is
+     * only changed if the whole section could be read.
+     *
+     * @param           input           The stream the scene is read from.
+     *
+     * @throws          runtime_error   If the section is truncated, has no
+     *                                  sources or a source id twice.
+     */
+    void read_state(juce::InputStream& input);
+
+    /**
+     * Returns the changes (a combination of Change bits) since the last call
+     * and clears them. May be called from any thread.
+     *
+     * @return the change mask.
+     */
+    unsigned int take_changes();
+
+    /**
+     * Returns true if there are changes which were not taken yet.
+     *
+     * @return true if there are changes which were not taken yet.
+     */
+    bool has_changes() const;
+
   private:
 
     /**
-     * Type definition for the source iterator.
+     * Type definition for the source container.
      */
-    typedef std::vector<SSR::Source>::iterator source_iterator;
+    typedef SSR::Slot_map<SSR::Source> Source_map;
 
     /**
      * All sources related to this scene.
      */
-    std::unique_ptr< std::vector<SSR::Source> > sources;
+    Source_map sources;
+
+    /**
+     * The handles of all sources by their SSR id.
+     */
+    std::unordered_map<unsigned int, Source_map::Handle> source_handles;
 
     /**
-     *
      * The currently selected source.
      */
-    source_iterator current_selected_source;
+    Source_map::Handle current_selected_source;
 
     /**
      * The scenes range.
@@ -419,6 +587,38 @@ namespace SSR
      */
     std::shared_ptr< std::vector< std::pair<unsigned int, std::string> > > ids_and_names;
 
+    /**
+     * The changes not taken yet, see Change.
+     */
+    std::atomic<unsigned int> changes;
+
+    /**
+     * Adds the transferred changes to the change mask.
+     *
+     * @param           change          A combination of Change bits.
+     */
+    void mark_changed(const unsigned int change);
+
+    /**
+     * Adds the transferred changes to the change mask if the source with the
+     * transferred id is the selected one. A position change is always added
+     * as scene_positions_changed.
+     *
+     * @param           id              The ID of the changed source.
+     *
+     * @param           change          A combination of Change bits.
+     */
+    void mark_changed(const unsigned int id, const unsigned int change);
+
+    /**
+     * Returns the Change bit of the transferred source parameter.
+     *
+     * @param           field           The source parameter.
+     *
+     * @return the Change bit.
+     */
+    static unsigned int change_of(const SSR::Source::parameter field);
+
     /**
      * Checks whether the transferred id_to_check is already in use and returns
      * true if so - false otherwise.
@@ -438,18 +638,36 @@ namespace SSR
     unsigned int get_next_id();
 
     /**
-     * Returns the source iterator for the source having the transferred id.
+     * Returns the source having the transferred id.
      *
-     * @param           id              The ID of the source which iterator
-     *                                  shall be returned.
+     * @param           id              The ID of the source.
      *
-     * @return the source iterator for the source having the transferred id.
+     * @return the source or nullptr if no source has the transferred id.
+     */
+    SSR::Source* find_source(unsigned int id);
+
+    /**
+     * Returns the current selected source.
      *
-     * @throws          runtime_error   If no source has the transferred id,
-     *                                  a runtime_error exception will be
-     *                                  thrown.
+     * @return the current selected source.
+     */
+    SSR::Source& selected_source();
+
+    /**
+     * Returns the current selected source.
+     *
+     * @return the current selected source.
+     */
+    const SSR::Source& selected_source() const;
+
+    /**
+     * Adds the transferred source to the scene and to the ids and names.
+     *
+     * @param           source          The source, its id must not be in use.
+     *
+     * @return the handle of the new source.
      */
-    const source_iterator get_iterator(unsigned int id);
+    Source_map::Handle add_source(SSR::Source source);
 
     /**
      * Sets the name of the source with the transferred id to the transferred
@@ -464,7 +682,7 @@ namespace SSR
 
     /**
      * Sets the id of the source which has the transferred old_id to the
-     * transferred new_id.
+     * transferred new_id. Nothing happens if new_id is already in use.
      *
      * @param           old_id          The current id of the source which
      *                                  id shall be reset.
@@ -474,16 +692,48 @@ namespace SSR
     void set_id_of_source(const unsigned int old_id, const unsigned int new_id);
 
     /**
-     * Manipulates the transferred source_to_manipulate by interpreting the
-     * transferred element (XML message).
+     * Manipulates the transferred source_to_manipulate by applying the fields
+     * of the transferred update.
      *
      * @param           source_to_manipulate    The source that shall be
      *                                          manipulated.
      *
-     * @param           element                 The XML message that shall be
-     *                                          interpreted.
+     * @param           update                  The parsed source element.
+     *
+     * @param           message                 The message the text spans
+     *                                          of the update refer to.
+     */
+    void manipulate_source(SSR::Source& source_to_manipulate, const SSR::Source_update& update, const char* message);
+
+    /**
+     * Writes one source of the state section.
+     */
+    static void write_source(juce::OutputStream& output, const SSR::Source& source);
+
+    /**
+     * Reads one source of the state section.
+     */
+    static SSR::Source read_source(juce::InputStream& input, const float scene_range);
+
+    /**
+     * The minimum size of one source in the state section in bytes.
+     */
+    static const std::size_t min_source_state_size = 29;
+
+    /**
+     * Parses incoming update messages.
+     */
+    SSR::Update_parser update_parser;
+
+    /**
+     * The records of the last parsed message, reused between messages.
+     */
+    std::vector<SSR::Source_update> parsed_updates;
+
+    /**
+     * Buffer for unescaped texts, reused between messages.
      */
-    void manipulate_source(source_iterator source_to_manipulate, juce::XmlElement* element);
+    std::string text_buffer;
 
   };
 
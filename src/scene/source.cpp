@@ -15,51 +15,21 @@
 //C++ Libs
 #include <memory>
 #include <string>
-#include <functional>
 
 //Own Libs
 #include <src/utils/helper.h>
 #include <src/utils/random_machine.h>
-#include <src/parameter/parameter.h>
 #include <src/scene/parameter_translation_functions.h>
 
 SSR::Source::Source(const unsigned int id, const std::string name, float scene_range)
 : id(id)
-, x_position(   0.0f,
-                0.0f,
-                std::bind(SSR::translations::x_position_discrete_to_continuous, std::placeholders::_1, scene_range),
-                std::bind(SSR::translations::x_position_continuous_to_discrete, std::placeholders::_1, scene_range),
-                "X Position")
-, y_position(   0.0f,
-                0.0f,
-                std::bind(SSR::translations::y_position_discrete_to_continuous, std::placeholders::_1, scene_range),
-                std::bind(SSR::translations::y_position_continuous_to_discrete, std::placeholders::_1, scene_range),
-                "Y Position")
-, gain(         1.0f,
-                1.0f,
-                SSR::translations::gain_discrete_to_continuous,
-                SSR::translations::gain_continuous_to_discrete,
-                "Gain")
-, orientation(  0.0f,
-                0.0f,
-                SSR::translations::orientation_discrete_to_continuous,
-                SSR::translations::orientation_continuous_to_discrete,
-                "Orientation")
-, mute(         false,
-                false,
-                SSR::translations::mute_discrete_to_continuous,
-                SSR::translations::mute_continuous_to_discrete,
-                "Mute")
-, model_point(  true,
-                true,
-                SSR::translations::model_point_discrete_to_continuous,
-                SSR::translations::model_point_continuous_to_discrete,
-                "Model")
-, fixed(        false,
-                false,
-                SSR::translations::fixed_discrete_to_continuous,
-                SSR::translations::fixed_continuous_to_discrete,
-                "Fixed")
+, x_position(0.0f, 0.0f, scene_range)
+, y_position(0.0f, 0.0f, scene_range)
+, gain(1.0f, 1.0f)
+, orientation(0.0f, 0.0f)
+, mute(false, false)
+, model_point(true, true)
+, fixed(false, false)
 , name(name)
 , properties_file("")
 , jackport("capture_2")
@@ -95,7 +65,7 @@ SSR::Source::Source(const SSR::Source& other)
 SSR::Source& SSR::Source::operator=(const SSR::Source& other)
 {
 
-  if (*this != other) {
+  if (this != &other) {
     SSR::Source tmp(other);
     swap(*this, tmp);
   }
@@ -128,7 +98,7 @@ void SSR::Source::set_x_position_discrete(const float position)
   x_position.set_discrete_value(position);
 }
 
-SSR::Parameter<float, float> SSR::Source::get_x_position() const
+SSR::X_position_parameter SSR::Source::get_x_position() const
 {
   return x_position;
 }
@@ -143,7 +113,7 @@ void SSR::Source::set_y_position_discrete(const float position)
   y_position.set_discrete_value(position);
 }
 
-SSR::Parameter<float, float> SSR::Source::get_y_position() const
+SSR::Y_position_parameter SSR::Source::get_y_position() const
 {
   return y_position;
 }
@@ -170,7 +140,7 @@ void SSR::Source::set_continuous_gain(const float gain_value)
   gain.set_continuous_value(gain_value);
 }
 
-SSR::Parameter<float, float> SSR::Source::get_gain() const
+SSR::Gain_parameter SSR::Source::get_gain() const
 {
   return gain;
 }
@@ -195,7 +165,7 @@ void SSR::Source::set_continuous_orientation(const float continuous_orientation)
   orientation.set_continuous_value(continuous_orientation);
 }
 
-SSR::Parameter<float, float> SSR::Source::get_orientation() const
+SSR::Orientation_parameter SSR::Source::get_orientation() const
 {
   return orientation;
 }
@@ -210,7 +180,7 @@ void SSR::Source::set_continuous_mute(const float continuous_mute)
   mute.set_continuous_value(continuous_mute);
 }
 
-SSR::Parameter<bool, float> SSR::Source::get_mute() const
+SSR::Mute_parameter SSR::Source::get_mute() const
 {
   return mute;
 }
@@ -225,7 +195,7 @@ void SSR::Source::set_continuous_model_point(const float point)
   model_point.set_continuous_value(point);
 }
 
-SSR::Parameter<bool, float> SSR::Source::get_model_point() const
+SSR::Model_point_parameter SSR::Source::get_model_point() const
 {
   return model_point;
 }
@@ -240,7 +210,7 @@ void SSR::Source::set_continuous_fixed(const float fixed_value)
   fixed.set_continuous_value(fixed_value);
 }
 
-SSR::Parameter<bool, float> SSR::Source::get_fixed() const
+SSR::Fixed_parameter SSR::Source::get_fixed() const
 {
   return fixed;
 }
@@ -275,6 +245,48 @@ std::string SSR::Source::get_jackport() const
   return jackport;
 }
 
+float SSR::Source::get_continuous_value(const parameter field) const
+{
+  switch (field) {
+    case x_position_idx:  return x_position.get_continuous_value();
+    case y_position_idx:  return y_position.get_continuous_value();
+    case gain_idx:        return gain.get_continuous_value();
+    case orientation_idx: return orientation.get_continuous_value();
+    case mute_idx:        return mute.get_continuous_value();
+    case model_point_idx: return model_point.get_continuous_value();
+    case fixed_idx:       return fixed.get_continuous_value();
+    default:              return 0.0f;
+  }
+}
+
+void SSR::Source::set_continuous_value(const parameter field, const float value)
+{
+  switch (field) {
+    case x_position_idx:  x_position.set_continuous_value(value);  break;
+    case y_position_idx:  y_position.set_continuous_value(value);  break;
+    case gain_idx:        gain.set_continuous_value(value);        break;
+    case orientation_idx: orientation.set_continuous_value(value); break;
+    case mute_idx:        mute.set_continuous_value(value);        break;
+    case model_point_idx: model_point.set_continuous_value(value); break;
+    case fixed_idx:       fixed.set_continuous_value(value);       break;
+    default:              break;
+  }
+}
+
+const char* SSR::Source::get_parameter_name(const parameter field)
+{
+  switch (field) {
+    case x_position_idx:  return translations::X_position::name();
+    case y_position_idx:  return translations::Y_position::name();
+    case gain_idx:        return translations::Gain::name();
+    case orientation_idx: return translations::Orientation::name();
+    case mute_idx:        return translations::Mute::name();
+    case model_point_idx: return translations::Model_point::name();
+    case fixed_idx:       return translations::Fixed::name();
+    default:              return "No Name Specified";
+  }
+}
+
 void SSR::Source::set_all_parameters_on_default()
 {
   x_position.set_to_default();
@@ -18,11 +18,26 @@
 #include <string>
 
 //Own Libs
-#include <src/parameter/parameter.h>
+#include <src/parameter/static_parameter.h>
+#include <src/scene/parameter_translation_functions.h>
 
 namespace SSR
 {
 
+  typedef Static_parameter<float, float, translations::X_position> X_position_parameter;
+
+  typedef Static_parameter<float, float, translations::Y_position> Y_position_parameter;
+
+  typedef Static_parameter<float, float, translations::Gain> Gain_parameter;
+
+  typedef Static_parameter<float, float, translations::Orientation> Orientation_parameter;
+
+  typedef Static_parameter<bool, float, translations::Mute> Mute_parameter;
+
+  typedef Static_parameter<bool, float, translations::Model_point> Model_point_parameter;
+
+  typedef Static_parameter<bool, float, translations::Fixed> Fixed_parameter;
+
   /**
    * This class represents a source. Since this VST Plugin remotely controls
    * the SSR, this class is the equivalent to a audio source in the SSR.
@@ -51,43 +66,10 @@ namespace SSR
      * Constructor setting the source id, name and the scene_range to the
      * transferred parameters.
      *
-     * The Parameter member will be set as follows:
-     *
-     * x_position:
-     * translate_to_continuous function = SSR::translations::x_position_discrete_to_continuous
-     * translate_to_discrete function = SSR::translations::x_position_continuous_to_discrete
-     * name = "X Position"
-     *
-     * y_position:
-     * translate_to_continuous function = SSR::translations::y_position_discrete_to_continuous
-     * translate_to_discrete function = SSR::translations::y_position_continuous_to_discrete
-     * name = "Y Position"
-     *
-     * gain:
-     * translate_to_continuous function = SSR::translations::gain_discrete_to_continuous
-     * translate_to_discrete function = SSR::translations::gain_continuous_to_discrete
-     * name = "Gain"
-     *
-     * orientation:
-     * translate_to_continuous function = SSR::translations::orientation_discrete_to_continuous
-     * translate_to_discrete function = SSR::translations::orientation_continuous_to_discrete
-     * name = "Orientation"
-     *
-     * mute:
-     * translate_to_continuous function = SSR::translations::mute_discrete_to_continuous
-     * translate_to_discrete function = SSR::translations::mute_continuous_to_discrete
-     * name = "Mute"
-     *
-     * model_point:
-     * translate_to_continuous function = SSR::translations::model_point_discrete_to_continuous
-     * translate_to_discrete function = SSR::translations::model_point_continuous_to_discrete
-     * name = "Model"
-     * 
-     * fixed:
-     * translate_to_continuous function = SSR::translations::fixed_discrete_to_continuous
-     * translate_to_discrete function = SSR::translations::fixed_continuous_to_discrete
-     * name = "Fixed"
-     * 
+     * The parameters take their names and translation functions from the
+     * policies in SSR::translations (X_position, Y_position, Gain,
+     * Orientation, Mute, Model_point and Fixed).
+     *
      * @see parameter_translation_functions.h
      *
      * All parameters will be set to default values.
@@ -173,7 +155,7 @@ namespace SSR
      *
      * @return the source x position.
      */
-    SSR::Parameter<float, float> get_x_position() const;
+    SSR::X_position_parameter get_x_position() const;
 
     /**
      * Setter for the source continuous X position.
@@ -196,7 +178,7 @@ namespace SSR
      *
      * @return the the source Y position.
      */
-    SSR::Parameter<float, float> get_y_position() const;
+    SSR::Y_position_parameter get_y_position() const;
 
     /**
      * Setter for the source continuous Y position.
@@ -239,7 +221,7 @@ namespace SSR
      *
      * @return the gain parameter of the source.
      */
-    SSR::Parameter<float, float> get_gain() const;
+    SSR::Gain_parameter get_gain() const;
 
     /**
      * Setter for the source ID.
@@ -277,7 +259,7 @@ namespace SSR
      *
      * @return the source orientation parameter.
      */
-    SSR::Parameter<float, float> get_orientation() const;
+    SSR::Orientation_parameter get_orientation() const;
 
     /**
      * Setter for the source mute parameter - true mutes the source.
@@ -305,7 +287,7 @@ namespace SSR
      *
      * @return the source mute parameter.
      */
-    SSR::Parameter<bool, float> get_mute() const;
+    SSR::Mute_parameter get_mute() const;
 
     /**
      * Sets the discrete source model point parameter where the
@@ -331,7 +313,7 @@ namespace SSR
      *
      * @return the source model parameter.
      */
-    SSR::Parameter<bool, float> get_model_point() const;
+    SSR::Model_point_parameter get_model_point() const;
 
     /**
      * Sets the discrete source fixed state, where the transferred parameter
@@ -356,7 +338,7 @@ namespace SSR
      *
      * @return the source fixed parameter.
      */
-    SSR::Parameter<bool, float> get_fixed() const;
+    SSR::Fixed_parameter get_fixed() const;
 
     /**
      * Setter for the source name parameter.
@@ -400,6 +382,34 @@ namespace SSR
      */
     std::string get_jackport() const;
 
+    /**
+     * Returns the continuous value of the transferred parameter.
+     *
+     * @param           field           The parameter.
+     *
+     * @return the continuous value, 0.0 for parameter_count.
+     */
+    float get_continuous_value(const parameter field) const;
+
+    /**
+     * Sets the continuous value of the transferred parameter.
+     *
+     * @param           field           The parameter.
+     *
+     * @param           value           The new continuous value.
+     */
+    void set_continuous_value(const parameter field, const float value);
+
+    /**
+     * Returns the name of the transferred parameter without needing a source.
+     *
+     * @param           field           The parameter.
+     *
+     * @return the name of the parameter, "No Name Specified" for
+     *         parameter_count.
+     */
+    static const char* get_parameter_name(const parameter field);
+
     /**
      * This method sets all parameters to the default values.
      *
@@ -436,38 +446,38 @@ namespace SSR
     /**
      * The source x position.
      */
-    Parameter<float, float> x_position;
+    X_position_parameter x_position;
 
     /**
      * The source y position.
      */
-    Parameter<float, float> y_position;
+    Y_position_parameter y_position;
 
     /**
      * The source gain.
      */
-    Parameter<float, float> gain;
+    Gain_parameter gain;
 
     /**
      * The source orientation (azimuth).
      */
-    Parameter<float, float> orientation;
+    Orientation_parameter orientation;
 
     /**
      * The source mute, defining whether the source is muted or not.
      */
-    Parameter<bool, float> mute;
+    Mute_parameter mute;
 
     /**
      * The source model, defining whether the source is a point source
      * (true) or a plane source (false).
      */
-    Parameter<bool, float> model_point;
+    Model_point_parameter model_point;
 
     /**
      * Defines whether the source has a fixed position (true) or not (false).
      */
-    Parameter<bool, float> fixed;
+    Fixed_parameter fixed;
 
     /**
      * The source name.
@@ -0,0 +1,783 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/scene/update_parser.h>
+
+//C++ Libs
+#include <cstring>
+#include <cmath>
+
+namespace
+{
+
+  bool is_whitespace(const char c)
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+  }
+
+  bool is_name_end(const char c)
+  {
+    return is_whitespace(c) || c == '/' || c == '>' || c == '=';
+  }
+
+  const char* find(const char* begin, const char* end, const char* pattern)
+  {
+    const std::size_t pattern_length = std::strlen(pattern);
+
+    for (const char* it = begin; it + pattern_length <= end; it++) {
+
+        it = static_cast<const char*>(std::memchr(it, pattern[0], end - it));
+
+        if (it == nullptr || it + pattern_length > end) {
+            return nullptr;
+        }
+
+        if (std::memcmp(it, pattern, pattern_length) == 0) {
+            return it;
+        }
+
+    }
+
+    return nullptr;
+  }
+
+  void append_utf8(const unsigned long code_point, std::string& output)
+  {
+    if (code_point < 0x80) {
+        output += static_cast<char>(code_point);
+    } else if (code_point < 0x800) {
+        output += static_cast<char>(0xC0 | (code_point >> 6));
+        output += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else if (code_point < 0x10000) {
+        output += static_cast<char>(0xE0 | (code_point >> 12));
+        output += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        output += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else {
+        output += static_cast<char>(0xF0 | (code_point >> 18));
+        output += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+        output += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        output += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+  }
+
+  /**
+   * Resolves the entity between '&' and ';' (both excluded) and appends it,
+   * returns false if the entity is unknown.
+   */
+  bool append_entity(const char* begin, const char* end, std::string& output)
+  {
+    const std::size_t length = end - begin;
+
+    if (length == 2 && std::memcmp(begin, "lt", 2) == 0) {
+        output += '<';
+    } else if (length == 2 && std::memcmp(begin, "gt", 2) == 0) {
+        output += '>';
+    } else if (length == 3 && std::memcmp(begin, "amp", 3) == 0) {
+        output += '&';
+    } else if (length == 4 && std::memcmp(begin, "quot", 4) == 0) {
+        output += '"';
+    } else if (length == 4 && std::memcmp(begin, "apos", 4) == 0) {
+        output += '\'';
+    } else if (length > 1 && *begin == '#') {
+
+        const bool hexadecimal = begin[1] == 'x' || begin[1] == 'X';
+        const char* digit = begin + (hexadecimal ? 2 : 1);
+        unsigned long code_point = 0;
+
+        if (digit == end) {
+            return false;
+        }
+
+        for (; digit != end; digit++) {
+
+            unsigned int value = 0;
+
+            if (*digit >= '0' && *digit <= '9') {
+                value = *digit - '0';
+            } else if (hexadecimal && *digit >= 'a' && *digit <= 'f') {
+                value = *digit - 'a' + 10;
+            } else if (hexadecimal && *digit >= 'A' && *digit <= 'F') {
+                value = *digit - 'A' + 10;
+            } else {
+                return false;
+            }
+
+            code_point = code_point * (hexadecimal ? 16 : 10) + value;
+
+            if (code_point > 0x10FFFF) {
+                return false;
+            }
+
+        }
+
+        append_utf8(code_point, output);
+
+    } else {
+        return false;
+    }
+
+    return true;
+  }
+
+}
+
+//============================================================================
+// PUBLIC
+
+SSR::Update_parser::Update_parser()
+: begin(nullptr)
+, current(nullptr)
+, end(nullptr)
+, name_begin(nullptr)
+, name_end(nullptr)
+, value_begin(nullptr)
+, value_end(nullptr)
+, failed(false)
+{
+
+}
+
+SSR::Update_parser::~Update_parser()
+{
+
+}
+
+bool SSR::Update_parser::parse(const char* data, const std::size_t size, std::vector<SSR::Source_update>& updates)
+{
+  updates.clear();
+
+  begin = data;
+  current = data;
+  end = data + size;
+  failed = false;
+
+  Token token = next_tag();
+
+  if (token != start_tag || !name_is("update")) {
+      return false;
+  }
+
+  while (next_attribute()) {}
+
+  token = finish_tag();
+
+  if (token == empty_tag) {
+      return true;
+  }
+
+  if (token != start_tag) {
+      return false;
+  }
+
+  while (true) {
+
+      token = next_tag();
+
+      if (token == end_tag) {
+          return true;
+      }
+
+      if (token != start_tag) {
+          return false;
+      }
+
+      if (name_is("source")) {
+
+          SSR::Source_update update = SSR::Source_update();
+          bool has_id = false;
+
+          if (!parse_source(update, has_id)) {
+              return false;
+          }
+
+          if (has_id) {
+              updates.push_back(update);
+          }
+
+      } else if (name_is("delete")) {
+
+          if (!parse_delete(updates)) {
+              return false;
+          }
+
+      } else {
+
+          while (next_attribute()) {}
+
+          token = finish_tag();
+
+          if (token == error || (token == start_tag && !skip_element())) {
+              return false;
+          }
+
+      }
+
+  }
+}
+
+void SSR::Update_parser::append_text(const char* data, const SSR::Text_span& span, std::string& output)
+{
+  const char* it = data + span.offset;
+  const char* const text_end = it + span.length;
+
+  while (it != text_end) {
+
+      const char* ampersand = static_cast<const char*>(std::memchr(it, '&', text_end - it));
+
+      if (ampersand == nullptr) {
+          output.append(it, text_end);
+          return;
+      }
+
+      output.append(it, ampersand);
+
+      const char* semicolon = static_cast<const char*>(std::memchr(ampersand, ';', text_end - ampersand));
+
+      if (semicolon == nullptr || !append_entity(ampersand + 1, semicolon, output)) {
+          // Not a (known) entity, keep the ampersand as it is.
+          output += '&';
+          it = ampersand + 1;
+      } else {
+          it = semicolon + 1;
+      }
+
+  }
+}
+
+bool SSR::Update_parser::parse_float(const char* begin, const char* end, float& value)
+{
+  while (begin != end && is_whitespace(*begin)) {
+      begin++;
+  }
+
+  while (begin != end && is_whitespace(*(end - 1))) {
+      end--;
+  }
+
+  const char* it = begin;
+  bool negative = false;
+
+  if (it != end && (*it == '-' || *it == '+')) {
+      negative = *it == '-';
+      it++;
+  }
+
+  // Up to 19 significant digits fit into the mantissa, further digits only
+  // shift the decimal exponent.
+  unsigned long long mantissa = 0;
+  unsigned int significant_digits = 0;
+  int exponent = 0;
+  bool has_digits = false;
+
+  for (; it != end && *it >= '0' && *it <= '9'; it++) {
+
+      has_digits = true;
+
+      if (significant_digits < 19) {
+          mantissa = mantissa * 10 + (*it - '0');
+          significant_digits += (mantissa != 0) ? 1 : 0;
+      } else {
+          exponent++;
+      }
+
+  }
+
+  if (it != end && *it == '.') {
+
+      for (it++; it != end && *it >= '0' && *it <= '9'; it++) {
+
+          has_digits = true;
+
+          if (significant_digits < 19) {
+              mantissa = mantissa * 10 + (*it - '0');
+              significant_digits += (mantissa != 0) ? 1 : 0;
+              exponent--;
+          }
+
+      }
+
+  }
+
+  if (!has_digits) {
+      return false;
+  }
+
+  if (it != end && (*it == 'e' || *it == 'E')) {
+
+      it++;
+
+      bool negative_exponent = false;
+
+      if (it != end && (*it == '-' || *it == '+')) {
+          negative_exponent = *it == '-';
+          it++;
+      }
+
+      if (it == end || *it < '0' || *it > '9') {
+          return false;
+      }
+
+      int explicit_exponent = 0;
+
+      for (; it != end && *it >= '0' && *it <= '9'; it++) {
+
+          if (explicit_exponent < 10000) {
+              explicit_exponent = explicit_exponent * 10 + (*it - '0');
+          }
+
+      }
+
+      exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+
+  }
+
+  if (it != end) {
+      return false;
+  }
+
+  double result = static_cast<double>(mantissa);
+
+  if (mantissa != 0 && exponent != 0) {
+      result = (exponent < 0) ? result / std::pow(10.0, -exponent) : result * std::pow(10.0, exponent);
+  }
+
+  value = static_cast<float>(negative ? -result : result);
+
+  return true;
+}
+
+//============================================================================
+// PRIVATE
+
+SSR::Update_parser::Token SSR::Update_parser::next_tag()
+{
+  while (!failed) {
+
+      const char* less_than = static_cast<const char*>(std::memchr(current, '<', end - current));
+
+      if (less_than == nullptr) {
+          current = end;
+          return end_of_input;
+      }
+
+      current = less_than + 1;
+
+      if (current == end) {
+          break;
+      }
+
+      if (*current == '!') {
+
+          const char* comment_end = (end - current >= 3 && std::memcmp(current, "!--", 3) == 0)
+                                  ? find(current + 3, end, "-->")
+                                  : find(current, end, ">");
+
+          if (comment_end == nullptr) {
+              break;
+          }
+
+          current = comment_end + 1;
+          continue;
+      }
+
+      if (*current == '?') {
+
+          const char* instruction_end = find(current, end, "?>");
+
+          if (instruction_end == nullptr) {
+              break;
+          }
+
+          current = instruction_end + 2;
+          continue;
+      }
+
+      const bool closing = *current == '/';
+
+      if (closing) {
+          current++;
+      }
+
+      name_begin = current;
+
+      while (current != end && !is_name_end(*current)) {
+          current++;
+      }
+
+      name_end = current;
+
+      if (name_begin == name_end) {
+          break;
+      }
+
+      if (!closing) {
+          return start_tag;
+      }
+
+      skip_whitespace();
+
+      if (current == end || *current != '>') {
+          break;
+      }
+
+      current++;
+
+      return end_tag;
+  }
+
+  failed = true;
+  return error;
+}
+
+bool SSR::Update_parser::next_attribute()
+{
+  skip_whitespace();
+
+  if (failed || current == end || *current == '/' || *current == '>') {
+      return false;
+  }
+
+  name_begin = current;
+
+  while (current != end && !is_name_end(*current)) {
+      current++;
+  }
+
+  name_end = current;
+
+  skip_whitespace();
+
+  if (name_begin == name_end || current == end || *current != '=') {
+      failed = true;
+      return false;
+  }
+
+  current++;
+
+  skip_whitespace();
+
+  if (current == end || (*current != '"' && *current != '\'')) {
+      failed = true;
+      return false;
+  }
+
+  const char quote = *current;
+
+  value_begin = current + 1;
+  value_end = static_cast<const char*>(std::memchr(value_begin, quote, end - value_begin));
+
+  if (value_end == nullptr) {
+      failed = true;
+      return false;
+  }
+
+  current = value_end + 1;
+
+  return true;
+}
+
+SSR::Update_parser::Token SSR::Update_parser::finish_tag()
+{
+  if (!failed && current != end) {
+
+      if (*current == '>') {
+          current++;
+          return start_tag;
+      }
+
+      if (*current == '/' && end - current >= 2 && current[1] == '>') {
+          current += 2;
+          return empty_tag;
+      }
+
+  }
+
+  failed = true;
+  return error;
+}
+
+bool SSR::Update_parser::skip_element()
+{
+  unsigned int depth = 1;
+
+  while (depth > 0) {
+
+      Token token = next_tag();
+
+      if (token == end_tag) {
+          depth--;
+      } else if (token == start_tag) {
+
+          while (next_attribute()) {}
+
+          token = finish_tag();
+
+          if (token == error) {
+              return false;
+          }
+
+          if (token == start_tag) {
+              depth++;
+          }
+
+      } else {
+          return false;
+      }
+
+  }
+
+  return true;
+}
+
+bool SSR::Update_parser::read_text(SSR::Text_span& text)
+{
+  const char* less_than = static_cast<const char*>(std::memchr(current, '<', end - current));
+
+  if (less_than == nullptr) {
+      failed = true;
+      return false;
+  }
+
+  text.offset = current - begin;
+  text.length = less_than - current;
+
+  return skip_element();
+}
+
+bool SSR::Update_parser::parse_source(SSR::Source_update& update, bool& has_id)
+{
+  while (next_attribute()) {
+
+      if (name_is("id")) {
+          has_id = value_as_unsigned(update.id);
+      } else if (name_is("volume")) {
+
+          if (value_as_float(update.volume_in_db)) {
+              update.set(SSR::Source_update::volume);
+          }
+
+      } else if (name_is("name")) {
+          update.name_text = value_span();
+          update.set(SSR::Source_update::name);
+      } else if (name_is("mute")) {
+          update.is_muted = value_is_true();
+          update.set(SSR::Source_update::mute);
+      } else if (name_is("model")) {
+          update.model_point = (value_end - value_begin == 5) && std::memcmp(value_begin, "point", 5) == 0;
+          update.set(SSR::Source_update::model);
+      } else if (name_is("properties_file")) {
+          update.properties_file_text = value_span();
+          update.set(SSR::Source_update::properties_file);
+      }
+
+  }
+
+  Token token = finish_tag();
+
+  if (token != start_tag) {
+      return token == empty_tag;
+  }
+
+  while (true) {
+
+      token = next_tag();
+
+      if (token == end_tag) {
+          return true;
+      }
+
+      if (token != start_tag) {
+          return false;
+      }
+
+      if (name_is("position")) {
+
+          // A position without fixed attribute means the source is movable.
+          update.is_fixed = false;
+          update.set(SSR::Source_update::fixed);
+
+          while (next_attribute()) {
+
+              if (name_is("x")) {
+
+                  if (value_as_float(update.x)) {
+                      update.set(SSR::Source_update::x_position);
+                  }
+
+              } else if (name_is("y")) {
+
+                  if (value_as_float(update.y)) {
+                      update.set(SSR::Source_update::y_position);
+                  }
+
+              } else if (name_is("fixed")) {
+                  update.is_fixed = value_is_true();
+              }
+
+          }
+
+          token = finish_tag();
+
+      } else if (name_is("orientation")) {
+
+          while (next_attribute()) {
+
+              if (name_is("azimuth") && value_as_float(update.azimuth)) {
+                  update.set(SSR::Source_update::orientation);
+              }
+
+          }
+
+          token = finish_tag();
+
+      } else if (name_is("port")) {
+
+          while (next_attribute()) {}
+
+          token = finish_tag();
+
+          if (token == start_tag) {
+
+              if (!read_text(update.port_text)) {
+                  return false;
+              }
+
+              update.set(SSR::Source_update::port);
+              continue;
+          }
+
+      } else {
+
+          while (next_attribute()) {}
+
+          token = finish_tag();
+
+      }
+
+      if (token == error || (token == start_tag && !skip_element())) {
+          return false;
+      }
+
+  }
+}
+
+bool SSR::Update_parser::parse_delete(std::vector<SSR::Source_update>& updates)
+{
+  while (next_attribute()) {}
+
+  Token token = finish_tag();
+
+  if (token != start_tag) {
+      return token == empty_tag;
+  }
+
+  while (true) {
+
+      token = next_tag();
+
+      if (token == end_tag) {
+          return true;
+      }
+
+      if (token != start_tag) {
+          return false;
+      }
+
+      if (name_is("source")) {
+
+          SSR::Source_update update = SSR::Source_update();
+          bool has_id = false;
+
+          if (!parse_source(update, has_id)) {
+              return false;
+          }
+
+          if (has_id) {
+              update.fields = 0;
+              update.deleted = true;
+              updates.push_back(update);
+          }
+
+      } else {
+
+          while (next_attribute()) {}
+
+          token = finish_tag();
+
+          if (token == error || (token == start_tag && !skip_element())) {
+              return false;
+          }
+
+      }
+
+  }
+}
+
+bool SSR::Update_parser::name_is(const char* literal) const
+{
+  const std::size_t length = name_end - name_begin;
+  return std::strncmp(name_begin, literal, length) == 0 && literal[length] == '\0';
+}
+
+bool SSR::Update_parser::value_is_true() const
+{
+  const char* it = value_begin;
+
+  while (it != value_end && is_whitespace(*it)) {
+      it++;
+  }
+
+  return it != value_end && (*it == '1' || *it == 't' || *it == 'T' || *it == 'y' || *it == 'Y');
+}
+
+bool SSR::Update_parser::value_as_float(float& value) const
+{
+  return parse_float(value_begin, value_end, value);
+}
+
+bool SSR::Update_parser::value_as_unsigned(unsigned int& value) const
+{
+  const char* it = value_begin;
+
+  while (it != value_end && is_whitespace(*it)) {
+      it++;
+  }
+
+  if (it == value_end) {
+      return false;
+  }
+
+  unsigned int result = 0;
+
+  for (; it != value_end && *it >= '0' && *it <= '9'; it++) {
+      result = result * 10 + (*it - '0');
+  }
+
+  value = result;
+
+  return true;
+}
+
+SSR::Text_span SSR::Update_parser::value_span() const
+{
+  SSR::Text_span span;
+  span.offset = value_begin - begin;
+  span.length = value_end - value_begin;
+  return span;
+}
+
+void SSR::Update_parser::skip_whitespace()
+{
+  while (current != end && is_whitespace(*current)) {
+      current++;
+  }
+}
@@ -0,0 +1,383 @@
+#ifndef UPDATE_PARSER_H
+#define UPDATE_PARSER_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace SSR
+{
+
+  /**
+   * A piece of text inside the parsed message, given as offset and length so
+   * it stays valid if the message buffer is moved.
+   */
+  struct Text_span
+  {
+
+    /**
+     * Offset of the first character relative to the start of the message.
+     */
+    std::size_t offset;
+
+    /**
+     * Number of characters.
+     */
+    std::size_t length;
+
+  };
+
+  /**
+   * The typed changes of one source element of an SSR update message.
+   */
+  struct Source_update
+  {
+
+    /**
+     * The fields a source element may carry.
+     */
+    enum Field {
+      x_position,
+      y_position,
+      fixed,
+      orientation,
+      volume,
+      mute,
+      model,
+      name,
+      properties_file,
+      port,
+      field_count
+    };
+
+    /**
+     * Returns true if the transferred field is set.
+     *
+     * @param     field           The field.
+     *
+     * @return true if the transferred field is set.
+     */
+    bool has(const Field field) const { return (fields & (1u << field)) != 0; }
+
+    /**
+     * Marks the transferred field as set.
+     *
+     * @param     field           The field.
+     */
+    void set(const Field field) { fields |= (1u << field); }
+
+    /**
+     * Marks the transferred field as not set.
+     *
+     * @param     field           The field.
+     */
+    void clear(const Field field) { fields &= ~(1u << field); }
+
+    /**
+     * The SSR id of the source.
+     */
+    unsigned int id;
+
+    /**
+     * One bit per Field which is set.
+     */
+    unsigned int fields;
+
+    /**
+     * The discrete X position.
+     */
+    float x;
+
+    /**
+     * The discrete Y position.
+     */
+    float y;
+
+    /**
+     * The azimuth in degrees.
+     */
+    float azimuth;
+
+    /**
+     * The volume in dB.
+     */
+    float volume_in_db;
+
+    /**
+     * True if the source is fixed.
+     */
+    bool is_fixed;
+
+    /**
+     * True if the source is muted.
+     */
+    bool is_muted;
+
+    /**
+     * True if the source is a point source, false if it is a plane wave.
+     */
+    bool model_point;
+
+    /**
+     * True if the source element was part of a delete element, i.e. the
+     * source was removed from the SSR scene.
+     */
+    bool deleted;
+
+    /**
+     * The raw (still XML escaped) name.
+     */
+    Text_span name_text;
+
+    /**
+     * The raw (still XML escaped) properties file.
+     */
+    Text_span properties_file_text;
+
+    /**
+     * The raw (still XML escaped) jackport.
+     */
+    Text_span port_text;
+
+  };
+
+  /**
+   * This class is a pull parser for the SSR update grammar:
+   *
+   * `<update><source id="1" name=".." volume=".." mute=".." model=".."
+   *  properties_file=".."><position x=".." y=".." fixed=".."/>
+   *  <orientation azimuth=".."/><port>..</port></source>...
+   *  <delete><source id="2"/></delete></update>`
+   *
+   * It parses directly from the receive buffer into typed Source_update
+   * records without building a DOM. Elements it does not know are skipped.
+   * Texts are not copied but referenced as Text_span, numbers are parsed
+   * locale independently. Once the output vector has grown to the largest
+   * message, parsing does not allocate any memory.
+   */
+  class Update_parser
+  {
+
+  public:
+
+    /**
+     * Constructor.
+     */
+    Update_parser();
+
+    /**
+     * Destructor.
+     */
+    ~Update_parser();
+
+    /**
+     * Parses the transferred message. The updates vector is cleared and then
+     * filled with one record per source element which has an id.
+     *
+     * @param     data            The message.
+     *
+     * @param     size            The length of the message.
+     *
+     * @param     updates         The vector the records are written to.
+     *
+     * @return    true if the message is a well formed update message, false
+     *            otherwise. Records parsed before an error was found are
+     *            kept.
+     */
+    bool parse(const char* data, const std::size_t size, std::vector<SSR::Source_update>& updates);
+
+    /**
+     * Appends the transferred span of the transferred message to the
+     * transferred string and resolves the predefined XML entities and
+     * numeric character references.
+     *
+     * @param     data            The message the span refers to.
+     *
+     * @param     span            The span.
+     *
+     * @param     output          The string the text is appended to.
+     */
+    static void append_text(const char* data, const SSR::Text_span& span, std::string& output);
+
+    /**
+     * Parses a decimal floating point number (with optional sign, fraction
+     * and exponent) independent of the current locale.
+     *
+     * @param     begin           The first character.
+     *
+     * @param     end             One past the last character.
+     *
+     * @param     value           Will be set to the parsed number.
+     *
+     * @return    true if the whole range is a number, false otherwise.
+     */
+    static bool parse_float(const char* begin, const char* end, float& value);
+
+  private:
+
+    /**
+     * The kinds of tokens the parser distinguishes.
+     */
+    enum Token {
+      start_tag,
+      empty_tag,
+      end_tag,
+      end_of_input,
+      error
+    };
+
+    /**
+     * Skips text, comments and processing instructions and reads the next
+     * tag name. The attributes of a start tag are read with next_attribute,
+     * the tag is finished by finish_tag.
+     *
+     * @return    the kind of the tag, end_of_input or error.
+     */
+    Token next_tag();
+
+    /**
+     * Reads the next attribute of the current start tag.
+     *
+     * @return    true if an attribute was read, false at the end of the tag.
+     */
+    bool next_attribute();
+
+    /**
+     * Reads the end of the current start tag.
+     *
+     * @return    empty_tag if the tag closes itself, start_tag otherwise or
+     *            error.
+     */
+    Token finish_tag();
+
+    /**
+     * Skips the content and the end tag of the element whose start tag was
+     * read last.
+     *
+     * @return    true on success.
+     */
+    bool skip_element();
+
+    /**
+     * Reads the text content of the element whose start tag was read last up
+     * to its first child tag and skips the rest of the element.
+     *
+     * @param     text            Will be set to the text.
+     *
+     * @return    true on success.
+     */
+    bool read_text(SSR::Text_span& text);
+
+    /**
+     * Parses the attributes and children of a source element.
+     *
+     * @param     update          The record which shall be filled.
+     *
+     * @param     has_id          Will be set to true if the element has an
+     *                            id attribute.
+     *
+     * @return    true on success.
+     */
+    bool parse_source(SSR::Source_update& update, bool& has_id);
+
+    /**
+     * Parses the attributes and children of a delete element and appends a
+     * record marked as deleted for each source element with an id.
+     *
+     * @param     updates         The vector the records are appended to.
+     *
+     * @return    true on success.
+     */
+    bool parse_delete(std::vector<SSR::Source_update>& updates);
+
+    /**
+     * Returns true if the current name equals the transferred literal.
+     */
+    bool name_is(const char* literal) const;
+
+    /**
+     * Returns true if the current attribute value is a boolean true
+     * (starting with 1, t, T, y or Y).
+     */
+    bool value_is_true() const;
+
+    /**
+     * Parses the current attribute value as float.
+     */
+    bool value_as_float(float& value) const;
+
+    /**
+     * Parses the current attribute value as unsigned integer.
+     */
+    bool value_as_unsigned(unsigned int& value) const;
+
+    /**
+     * Returns the current attribute value as span.
+     */
+    SSR::Text_span value_span() const;
+
+    /**
+     * Skips whitespace.
+     */
+    void skip_whitespace();
+
+  private:
+
+    /**
+     * The message which is parsed.
+     */
+    const char* begin;
+
+    /**
+     * The current position.
+     */
+    const char* current;
+
+    /**
+     * One past the last character of the message.
+     */
+    const char* end;
+
+    /**
+     * The name of the current tag or attribute.
+     */
+    const char* name_begin;
+
+    /**
+     * One past the name of the current tag or attribute.
+     */
+    const char* name_end;
+
+    /**
+     * The value of the current attribute.
+     */
+    const char* value_begin;
+
+    /**
+     * One past the value of the current attribute.
+     */
+    const char* value_end;
+
+    /**
+     * True if the message turned out to be malformed.
+     */
+    bool failed;
+
+  };
+
+}
+
+#endif
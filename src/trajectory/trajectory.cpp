@@ -0,0 +1,262 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/trajectory/trajectory.h>
+
+//C++ Libs
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+//Boost Libs
+#include <boost/math/constants/constants.hpp>
+
+//============================================================================
+// PUBLIC
+
+SSR::Trajectory::Trajectory(const Shape shape, std::vector<Keyframe> keyframes)
+: shape(shape)
+, keyframes(std::move(keyframes))
+, orbit()
+{
+  if (!is_keyframed(shape)) {
+      throw std::invalid_argument("Trajectory: shape is not keyframed!");
+  }
+
+  if (this->keyframes.empty()) {
+      throw std::invalid_argument("Trajectory: no keyframes!");
+  }
+
+  std::stable_sort(this->keyframes.begin(), this->keyframes.end(), [](const Keyframe& lhs, const Keyframe& rhs) {
+    return lhs.time_in_seconds < rhs.time_in_seconds;
+  });
+}
+
+SSR::Trajectory::Trajectory(const Shape shape, const Orbit& orbit)
+: shape(shape)
+, keyframes()
+, orbit(orbit)
+{
+  if (shape != Shape::circle && shape != Shape::figure_eight) {
+      throw std::invalid_argument("Trajectory: shape is not parametric!");
+  }
+
+  if (orbit.period_in_seconds == 0.0) {
+      throw std::invalid_argument("Trajectory: period must not be 0!");
+  }
+
+  if (orbit.end_time_in_seconds < orbit.start_time_in_seconds) {
+      throw std::invalid_argument("Trajectory: end is before start!");
+  }
+}
+
+SSR::Trajectory::~Trajectory()
+{
+
+}
+
+SSR::Trajectory SSR::Trajectory::from_keyframes(const Shape shape, std::vector<Keyframe> keyframes)
+{
+  if (is_keyframed(shape)) {
+      return Trajectory(shape, std::move(keyframes));
+  }
+
+  if (keyframes.size() < 2) {
+      throw std::invalid_argument("Trajectory: an orbit needs two keyframes!");
+  }
+
+  std::stable_sort(keyframes.begin(), keyframes.end(), [](const Keyframe& lhs, const Keyframe& rhs) {
+    return lhs.time_in_seconds < rhs.time_in_seconds;
+  });
+
+  const Keyframe& center = keyframes[0];
+  const Keyframe& start = keyframes[1];
+  const double delta_x = start.x - center.x;
+  const double delta_y = start.y - center.y;
+  const float radius = static_cast<float>(std::sqrt(delta_x * delta_x + delta_y * delta_y));
+
+  Orbit orbit;
+  orbit.center_x = center.x;
+  orbit.center_y = center.y;
+  orbit.radius_x = radius;
+  orbit.radius_y = radius;
+  orbit.period_in_seconds = start.time_in_seconds - center.time_in_seconds;
+  orbit.phase_in_degrees = (shape == Shape::circle) ? static_cast<float>(std::atan2(delta_y, delta_x) * 180.0 / boost::math::double_constants::pi) : 0.0f;
+  orbit.start_time_in_seconds = start.time_in_seconds;
+  orbit.end_time_in_seconds = std::max(keyframes.back().time_in_seconds, start.time_in_seconds + orbit.period_in_seconds);
+
+  return Trajectory(shape, orbit);
+}
+
+bool SSR::Trajectory::is_keyframed(const Shape shape)
+{
+  return shape == Shape::linear || shape == Shape::catmull_rom || shape == Shape::bezier;
+}
+
+bool SSR::Trajectory::evaluate(const double time_in_seconds, float& x, float& y) const
+{
+  const double start_time = get_start_time();
+  const double end_time = get_end_time();
+  const double clamped_time = std::min(std::max(time_in_seconds, start_time), end_time);
+
+  if (shape == Shape::circle || shape == Shape::figure_eight) {
+      orbit_position(clamped_time, x, y);
+  } else {
+
+      // The first keyframe with a time greater than clamped_time ends the
+      // segment; at the end time the last segment is used.
+      auto next = std::upper_bound(keyframes.begin(), keyframes.end(), clamped_time, [](const double time, const Keyframe& keyframe) {
+        return time < keyframe.time_in_seconds;
+      });
+
+      const std::size_t last = last_anchor();
+
+      if (next == keyframes.begin() || last == 0) {
+          x = keyframes.front().x;
+          y = keyframes.front().y;
+      } else {
+
+          std::size_t index = static_cast<std::size_t>(next - keyframes.begin()) - 1;
+
+          // A Bezier segment starts at every third keyframe.
+          if (shape == Shape::bezier) {
+              index -= index % 3;
+          }
+
+          if (index >= last) {
+              x = keyframes[last].x;
+              y = keyframes[last].y;
+          } else if (shape == Shape::bezier) {
+              bezier_position(index, clamped_time, x, y);
+          } else {
+              interpolate(index, clamped_time, x, y);
+          }
+
+      }
+
+  }
+
+  return time_in_seconds >= start_time && time_in_seconds <= end_time;
+}
+
+SSR::Trajectory::Shape SSR::Trajectory::get_shape() const
+{
+  return shape;
+}
+
+const std::vector<SSR::Trajectory::Keyframe>& SSR::Trajectory::get_keyframes() const
+{
+  return keyframes;
+}
+
+const SSR::Trajectory::Orbit& SSR::Trajectory::get_orbit() const
+{
+  return orbit;
+}
+
+double SSR::Trajectory::get_start_time() const
+{
+  return keyframes.empty() ? orbit.start_time_in_seconds : keyframes.front().time_in_seconds;
+}
+
+double SSR::Trajectory::get_end_time() const
+{
+  return keyframes.empty() ? orbit.end_time_in_seconds : keyframes[last_anchor()].time_in_seconds;
+}
+
+//============================================================================
+// PRIVATE
+
+void SSR::Trajectory::interpolate(const std::size_t index, const double time_in_seconds, float& x, float& y) const
+{
+  const Keyframe& from = keyframes[index];
+  const Keyframe& to = keyframes[index + 1];
+  const double duration = to.time_in_seconds - from.time_in_seconds;
+  const double u = (duration > 0.0) ? (time_in_seconds - from.time_in_seconds) / duration : 1.0;
+
+  if (shape == Shape::linear) {
+      x = static_cast<float>(from.x + (to.x - from.x) * u);
+      y = static_cast<float>(from.y + (to.y - from.y) * u);
+      return;
+  }
+
+  // Catmull-Rom tangents (in units per second) of both ends of the segment.
+  const Keyframe& before = keyframes[(index > 0) ? index - 1 : index];
+  const Keyframe& after = keyframes[(index + 2 < keyframes.size()) ? index + 2 : index + 1];
+
+  const double in_span = to.time_in_seconds - before.time_in_seconds;
+  const double out_span = after.time_in_seconds - from.time_in_seconds;
+
+  const double from_tangent_x = (in_span > 0.0) ? (to.x - before.x) / in_span : 0.0;
+  const double from_tangent_y = (in_span > 0.0) ? (to.y - before.y) / in_span : 0.0;
+  const double to_tangent_x = (out_span > 0.0) ? (after.x - from.x) / out_span : 0.0;
+  const double to_tangent_y = (out_span > 0.0) ? (after.y - from.y) / out_span : 0.0;
+
+  // Cubic Hermite basis functions.
+  const double u2 = u * u;
+  const double u3 = u2 * u;
+  const double h00 = 2.0 * u3 - 3.0 * u2 + 1.0;
+  const double h10 = u3 - 2.0 * u2 + u;
+  const double h01 = -2.0 * u3 + 3.0 * u2;
+  const double h11 = u3 - u2;
+
+  x = static_cast<float>(h00 * from.x + h10 * duration * from_tangent_x + h01 * to.x + h11 * duration * to_tangent_x);
+  y = static_cast<float>(h00 * from.y + h10 * duration * from_tangent_y + h01 * to.y + h11 * duration * to_tangent_y);
+}
+
+void SSR::Trajectory::bezier_position(const std::size_t anchor, const double time_in_seconds, float& x, float& y) const
+{
+  const Keyframe& from = keyframes[anchor];
+  const Keyframe& from_control = keyframes[anchor + 1];
+  const Keyframe& to_control = keyframes[anchor + 2];
+  const Keyframe& to = keyframes[anchor + 3];
+  const double duration = to.time_in_seconds - from.time_in_seconds;
+  const double u = (duration > 0.0) ? (time_in_seconds - from.time_in_seconds) / duration : 1.0;
+
+  // Cubic Bernstein basis functions.
+  const double v = 1.0 - u;
+  const double b0 = v * v * v;
+  const double b1 = 3.0 * v * v * u;
+  const double b2 = 3.0 * v * u * u;
+  const double b3 = u * u * u;
+
+  x = static_cast<float>(b0 * from.x + b1 * from_control.x + b2 * to_control.x + b3 * to.x);
+  y = static_cast<float>(b0 * from.y + b1 * from_control.y + b2 * to_control.y + b3 * to.y);
+}
+
+std::size_t SSR::Trajectory::last_anchor() const
+{
+  if (keyframes.empty()) {
+      return 0;
+  }
+
+  const std::size_t last = keyframes.size() - 1;
+
+  return (shape == Shape::bezier) ? last - last % 3 : last;
+}
+
+void SSR::Trajectory::orbit_position(const double time_in_seconds, float& x, float& y) const
+{
+  const double two_pi = 2.0 * boost::math::double_constants::pi;
+  const double elapsed = time_in_seconds - orbit.start_time_in_seconds;
+  const double angle = two_pi * elapsed / orbit.period_in_seconds + orbit.phase_in_degrees * two_pi / 360.0;
+
+  if (shape == Shape::circle) {
+      x = static_cast<float>(orbit.center_x + orbit.radius_x * std::cos(angle));
+      y = static_cast<float>(orbit.center_y + orbit.radius_y * std::sin(angle));
+  } else {
+      // Lemniscate of Gerono: both loops are passed once per period.
+      x = static_cast<float>(orbit.center_x + orbit.radius_x * std::sin(angle));
+      y = static_cast<float>(orbit.center_y + orbit.radius_y * std::sin(angle) * std::cos(angle));
+  }
+}
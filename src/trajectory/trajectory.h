@@ -0,0 +1,289 @@
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <cstddef>
+#include <vector>
+
+namespace SSR
+{
+
+  /**
+   * This class represents the path of a source along the host timeline.
+   *
+   * A trajectory is either keyframed or parametric:
+   *
+   * - linear: straight lines between the keyframes,
+   * - catmull_rom: a smooth curve through all keyframes (cubic Hermite
+   *   segments with Catmull-Rom tangents scaled to the keyframe times),
+   * - bezier: cubic Bezier segments. Every third keyframe (by time, starting
+   *   with the first) is an anchor the curve passes through at its time, the
+   *   two keyframes between two anchors are the control points of the
+   *   segment. Control points after the last anchor are kept but not used.
+   * - circle: an orbit (circle or ellipse) around a center,
+   * - figure_eight: a lemniscate around a center.
+   *
+   * A trajectory is active between its start and end time. Evaluating it
+   * never allocates memory, so it may be done on the audio thread.
+   */
+  class Trajectory
+  {
+
+  public:
+
+    /**
+     * The shapes a trajectory can have.
+     */
+    enum class Shape {
+      linear,
+      catmull_rom,
+      circle,
+      figure_eight,
+      bezier
+    };
+
+    /**
+     * A position of the source at a position of the host timeline.
+     */
+    struct Keyframe
+    {
+
+      /**
+       * The host timeline position in seconds.
+       */
+      double time_in_seconds;
+
+      /**
+       * The discrete X position.
+       */
+      float x;
+
+      /**
+       * The discrete Y position.
+       */
+      float y;
+
+    };
+
+    /**
+     * The parameters of the parametric shapes.
+     */
+    struct Orbit
+    {
+
+      /**
+       * The discrete X position of the center.
+       */
+      float center_x;
+
+      /**
+       * The discrete Y position of the center.
+       */
+      float center_y;
+
+      /**
+       * The radius along the X axis.
+       */
+      float radius_x;
+
+      /**
+       * The radius along the Y axis.
+       */
+      float radius_y;
+
+      /**
+       * The time in seconds for one revolution, negative values reverse the
+       * direction.
+       */
+      double period_in_seconds;
+
+      /**
+       * The angle in degrees at the start time.
+       */
+      float phase_in_degrees;
+
+      /**
+       * The host timeline position in seconds where the orbit starts.
+       */
+      double start_time_in_seconds;
+
+      /**
+       * The host timeline position in seconds where the orbit ends.
+       */
+      double end_time_in_seconds;
+
+    };
+
+    /**
+     * Constructor creating a keyframed trajectory. The keyframes are sorted
+     * by time.
+     *
+     * @param     shape           Shape::linear, Shape::catmull_rom or
+     *                            Shape::bezier.
+     *
+     * @param     keyframes       The keyframes, at least one.
+     *
+     * @throws    invalid_argument If the shape is not keyframed or there are
+     *                            no keyframes.
+     */
+    Trajectory(const Shape shape, std::vector<Keyframe> keyframes);
+
+    /**
+     * Constructor creating a parametric trajectory.
+     *
+     * @param     shape           Shape::circle or Shape::figure_eight.
+     *
+     * @param     orbit           The parameters of the shape.
+     *
+     * @throws    invalid_argument If the shape is not parametric, the period
+     *                            is 0 or the end is before the start.
+     */
+    Trajectory(const Shape shape, const Orbit& orbit);
+
+    /**
+     * Destructor.
+     */
+    ~Trajectory();
+
+    /**
+     * Creates a trajectory of the transferred shape from recorded keyframes.
+     *
+     * Keyframed shapes use the keyframes as they are. The parametric shapes
+     * orbit around the first keyframe (by time) with the distance to the
+     * second one as radius, taking the time between both for one revolution.
+     * The orbit starts at the time of the second keyframe (a circle passes
+     * through it, a figure eight starts in its center) and ends at the time
+     * of the last one, but not before one revolution.
+     *
+     * @param     shape           The shape.
+     *
+     * @param     keyframes       The keyframes, at least one for keyframed
+     *                            and two for parametric shapes.
+     *
+     * @return    the trajectory.
+     *
+     * @throws    invalid_argument If there are too few keyframes or the first
+     *                            two have the same time.
+     */
+    static Trajectory from_keyframes(const Shape shape, std::vector<Keyframe> keyframes);
+
+    /**
+     * Returns true if the transferred shape is defined by keyframes.
+     *
+     * @param     shape           The shape.
+     *
+     * @return    true for Shape::linear, Shape::catmull_rom and
+     *            Shape::bezier.
+     */
+    static bool is_keyframed(const Shape shape);
+
+    /**
+     * Computes the position at the transferred time. Outside of the active
+     * range the position at the start or end time is returned.
+     *
+     * @param     time_in_seconds The host timeline position in seconds.
+     *
+     * @param     x               Will be set to the discrete X position.
+     *
+     * @param     y               Will be set to the discrete Y position.
+     *
+     * @return    true if the time is inside the active range.
+     */
+    bool evaluate(const double time_in_seconds, float& x, float& y) const;
+
+    /**
+     * Returns the shape.
+     *
+     * @return the shape.
+     */
+    Shape get_shape() const;
+
+    /**
+     * Returns the keyframes, empty for parametric shapes.
+     *
+     * @return the keyframes.
+     */
+    const std::vector<Keyframe>& get_keyframes() const;
+
+    /**
+     * Returns the orbit parameters, only meaningful for parametric shapes.
+     *
+     * @return the orbit parameters.
+     */
+    const Orbit& get_orbit() const;
+
+    /**
+     * Returns the host timeline position in seconds where the trajectory
+     * starts.
+     *
+     * @return the start time in seconds.
+     */
+    double get_start_time() const;
+
+    /**
+     * Returns the host timeline position in seconds where the trajectory
+     * ends.
+     *
+     * @return the end time in seconds.
+     */
+    double get_end_time() const;
+
+  private:
+
+    /**
+     * Interpolates between the keyframes at the transferred index and the
+     * next one.
+     */
+    void interpolate(const std::size_t index, const double time_in_seconds, float& x, float& y) const;
+
+    /**
+     * Computes the position on the Bezier segment starting at the anchor at
+     * the transferred index.
+     */
+    void bezier_position(const std::size_t anchor, const double time_in_seconds, float& x, float& y) const;
+
+    /**
+     * Returns the index of the last keyframe the curve passes through, the
+     * last anchor for Shape::bezier.
+     */
+    std::size_t last_anchor() const;
+
+    /**
+     * Computes the position of a parametric shape.
+     */
+    void orbit_position(const double time_in_seconds, float& x, float& y) const;
+
+  private:
+
+    /**
+     * The shape.
+     */
+    Shape shape;
+
+    /**
+     * The keyframes sorted by time.
+     */
+    std::vector<Keyframe> keyframes;
+
+    /**
+     * The parameters of the parametric shapes.
+     */
+    Orbit orbit;
+
+  };
+
+}
+
+#endif
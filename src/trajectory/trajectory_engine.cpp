@@ -0,0 +1,282 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/trajectory/trajectory_engine.h>
+
+//C++ Libs
+#include <algorithm>
+#include <stdexcept>
+
+//Own Libs
+#include <src/utils/state_stream.h>
+
+//============================================================================
+// PUBLIC
+
+SSR::Trajectory_engine::Trajectory_engine()
+: lock()
+, bindings()
+, positions()
+, sample_rate(44100.0)
+, max_rate_in_hz(0)
+, samples_until_pass(0.0)
+{
+  bindings.reserve(max_trajectories);
+  positions.reserve(max_trajectories);
+}
+
+SSR::Trajectory_engine::~Trajectory_engine()
+{
+
+}
+
+bool SSR::Trajectory_engine::set_trajectory(const unsigned int source_id, const SSR::Trajectory& trajectory)
+{
+  const juce::SpinLock::ScopedLockType scoped_lock(lock);
+
+  auto binding = std::find_if(bindings.begin(), bindings.end(), [source_id](const Binding& b) { return b.source_id == source_id; });
+
+  if (binding != bindings.end()) {
+      binding->trajectory = trajectory;
+      binding->was_active = false;
+      binding->has_position = false;
+      return true;
+  }
+
+  if (bindings.size() == max_trajectories) {
+      return false;
+  }
+
+  Binding new_binding = { source_id, trajectory, false, false, true, 0.0f, 0.0f };
+  bindings.push_back(new_binding);
+
+  return true;
+}
+
+bool SSR::Trajectory_engine::remove_trajectory(const unsigned int source_id)
+{
+  const juce::SpinLock::ScopedLockType scoped_lock(lock);
+
+  auto binding = std::find_if(bindings.begin(), bindings.end(), [source_id](const Binding& b) { return b.source_id == source_id; });
+
+  if (binding == bindings.end()) {
+      return false;
+  }
+
+  bindings.erase(binding);
+
+  return true;
+}
+
+void SSR::Trajectory_engine::clear()
+{
+  const juce::SpinLock::ScopedLockType scoped_lock(lock);
+  bindings.clear();
+}
+
+std::vector< std::pair<unsigned int, SSR::Trajectory> > SSR::Trajectory_engine::get_trajectories() const
+{
+  const juce::SpinLock::ScopedLockType scoped_lock(lock);
+
+  std::vector< std::pair<unsigned int, SSR::Trajectory> > trajectories;
+
+  for (const Binding& binding : bindings) {
+      trajectories.push_back(std::make_pair(binding.source_id, binding.trajectory));
+  }
+
+  return trajectories;
+}
+
+void SSR::Trajectory_engine::set_max_rate(const unsigned int max_rate_in_hz)
+{
+  const juce::SpinLock::ScopedLockType scoped_lock(lock);
+  this->max_rate_in_hz = max_rate_in_hz;
+}
+
+void SSR::Trajectory_engine::prepare(const double sample_rate)
+{
+  const juce::SpinLock::ScopedLockType scoped_lock(lock);
+  this->sample_rate = (sample_rate > 0.0) ? sample_rate : 44100.0;
+  samples_until_pass = 0.0;
+}
+
+std::size_t SSR::Trajectory_engine::process(const double time_in_seconds, const int sample_count, const Position*& positions)
+{
+  positions = this->positions.data();
+
+  const juce::GenericScopedTryLock<juce::SpinLock> try_lock(lock);
+
+  if (!try_lock.isLocked()) {
+      return 0;
+  }
+
+  samples_until_pass -= sample_count;
+
+  if (samples_until_pass > 0.0) {
+      return 0;
+  }
+
+  const double samples_per_pass = (max_rate_in_hz == 0) ? 0.0 : sample_rate / max_rate_in_hz;
+  samples_until_pass = std::max(samples_until_pass + samples_per_pass, 0.0);
+
+  this->positions.clear();
+
+  for (Binding& binding : bindings) {
+
+      float x = 0.0f;
+      float y = 0.0f;
+
+      const bool active = binding.trajectory.evaluate(time_in_seconds, x, y);
+
+      if (!active && !binding.was_active) {
+          continue;
+      }
+
+      binding.was_active = active;
+
+      if (binding.has_position && x == binding.last_x && y == binding.last_y) {
+          continue;
+      }
+
+      binding.has_position = true;
+      binding.position_taken = false;
+      binding.last_x = x;
+      binding.last_y = y;
+
+      Position position = { binding.source_id, x, y };
+      this->positions.push_back(position);
+  }
+
+  return this->positions.size();
+}
+
+bool SSR::Trajectory_engine::take_positions(std::vector<Position>& positions)
+{
+  const juce::SpinLock::ScopedLockType scoped_lock(lock);
+
+  bool taken = false;
+
+  for (Binding& binding : bindings) {
+
+      if (!binding.position_taken) {
+          Position position = { binding.source_id, binding.last_x, binding.last_y };
+          positions.push_back(position);
+          binding.position_taken = true;
+          taken = true;
+      }
+
+  }
+
+  return taken;
+}
+
+void SSR::Trajectory_engine::write_state(juce::OutputStream& output) const
+{
+  const std::vector< std::pair<unsigned int, SSR::Trajectory> > trajectories = get_trajectories();
+
+  output.writeInt(static_cast<int>(trajectories.size()));
+
+  for (const auto& source_and_trajectory : trajectories) {
+      output.writeInt(static_cast<int>(source_and_trajectory.first));
+      write_trajectory(output, source_and_trajectory.second);
+  }
+}
+
+void SSR::Trajectory_engine::read_state(juce::InputStream& input)
+{
+  // Source id, shape and keyframe count.
+  const juce::uint32 count = SSR::state_stream::read_count(input, 12);
+
+  if (count > max_trajectories) {
+      throw std::runtime_error("Plugin state has too many trajectories!");
+  }
+
+  std::vector<Binding> restored_bindings;
+  restored_bindings.reserve(max_trajectories);
+
+  for (juce::uint32 index = 0; index < count; index++) {
+      const unsigned int source_id = SSR::state_stream::read_uint32(input);
+      Binding binding = { source_id, read_trajectory(input), false, false, true, 0.0f, 0.0f };
+      restored_bindings.push_back(binding);
+  }
+
+  const juce::SpinLock::ScopedLockType scoped_lock(lock);
+  bindings.swap(restored_bindings);
+}
+
+//============================================================================
+// PRIVATE
+
+void SSR::Trajectory_engine::write_trajectory(juce::OutputStream& output, const SSR::Trajectory& trajectory)
+{
+  output.writeInt(static_cast<int>(trajectory.get_shape()));
+
+  const std::vector<SSR::Trajectory::Keyframe>& keyframes = trajectory.get_keyframes();
+  output.writeInt(static_cast<int>(keyframes.size()));
+
+  for (const SSR::Trajectory::Keyframe& keyframe : keyframes) {
+      output.writeDouble(keyframe.time_in_seconds);
+      output.writeFloat(keyframe.x);
+      output.writeFloat(keyframe.y);
+  }
+
+  if (keyframes.empty()) {
+      const SSR::Trajectory::Orbit& orbit = trajectory.get_orbit();
+      output.writeFloat(orbit.center_x);
+      output.writeFloat(orbit.center_y);
+      output.writeFloat(orbit.radius_x);
+      output.writeFloat(orbit.radius_y);
+      output.writeDouble(orbit.period_in_seconds);
+      output.writeFloat(orbit.phase_in_degrees);
+      output.writeDouble(orbit.start_time_in_seconds);
+      output.writeDouble(orbit.end_time_in_seconds);
+  }
+}
+
+SSR::Trajectory SSR::Trajectory_engine::read_trajectory(juce::InputStream& input)
+{
+  typedef SSR::Trajectory::Shape Shape;
+
+  const juce::uint32 shape = SSR::state_stream::read_uint32(input);
+
+  if (shape > static_cast<juce::uint32>(Shape::bezier)) {
+      throw std::runtime_error("Plugin state has an unknown trajectory shape!");
+  }
+
+  // Time, X and Y.
+  const juce::uint32 keyframe_count = SSR::state_stream::read_count(input, 16);
+
+  if (keyframe_count > 0) {
+
+      std::vector<SSR::Trajectory::Keyframe> keyframes(keyframe_count);
+
+      for (SSR::Trajectory::Keyframe& keyframe : keyframes) {
+          keyframe.time_in_seconds = SSR::state_stream::read_double(input);
+          keyframe.x = SSR::state_stream::read_float(input);
+          keyframe.y = SSR::state_stream::read_float(input);
+      }
+
+      return SSR::Trajectory(static_cast<Shape>(shape), std::move(keyframes));
+  }
+
+  SSR::Trajectory::Orbit orbit;
+  orbit.center_x = SSR::state_stream::read_float(input);
+  orbit.center_y = SSR::state_stream::read_float(input);
+  orbit.radius_x = SSR::state_stream::read_float(input);
+  orbit.radius_y = SSR::state_stream::read_float(input);
+  orbit.period_in_seconds = SSR::state_stream::read_double(input);
+  orbit.phase_in_degrees = SSR::state_stream::read_float(input);
+  orbit.start_time_in_seconds = SSR::state_stream::read_double(input);
+  orbit.end_time_in_seconds = SSR::state_stream::read_double(input);
+
+  return SSR::Trajectory(static_cast<Shape>(shape), orbit);
+}
@@ -0,0 +1,253 @@
+#ifndef TRAJECTORY_ENGINE_H
+#define TRAJECTORY_ENGINE_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+//Own Libs
+#include <src/trajectory/trajectory.h>
+
+//JUCE Lib
+#include <JUCE/JuceHeader.h>
+
+namespace SSR
+{
+
+  /**
+   * This class evaluates the trajectories of all sources in one pass per
+   * audio block, driven by the host timeline position.
+   *
+   * Trajectories are assigned on the message thread, process is called on
+   * the audio thread. The audio thread only try-locks: if the message thread
+   * is changing the trajectories, the block is skipped instead of waiting.
+   * All storage is reserved up front, so process never allocates.
+   *
+   * Passes are bounded to max_rate per second of audio. A pass reports only
+   * sources whose position changed since the last pass. When a trajectory
+   * becomes inactive its position at the start or end time is reported once,
+   * so the source lands exactly on it.
+   */
+  class Trajectory_engine
+  {
+
+  public:
+
+    /**
+     * The evaluated position of one source.
+     */
+    struct Position
+    {
+
+      /**
+       * The SSR id of the source.
+       */
+      unsigned int source_id;
+
+      /**
+       * The discrete X position.
+       */
+      float x;
+
+      /**
+       * The discrete Y position.
+       */
+      float y;
+
+    };
+
+    /**
+     * The maximum number of sources with a trajectory.
+     */
+    static const std::size_t max_trajectories = 256;
+
+    /**
+     * Constructor.
+     */
+    Trajectory_engine();
+
+    /**
+     * Destructor.
+     */
+    ~Trajectory_engine();
+
+    /**
+     * Assigns the transferred trajectory to the source with the transferred
+     * id, replacing its previous trajectory.
+     *
+     * Must be called from the message thread.
+     *
+     * @param     source_id       The SSR id of the source.
+     *
+     * @param     trajectory      The trajectory.
+     *
+     * @return    false if max_trajectories sources already have one.
+     */
+    bool set_trajectory(const unsigned int source_id, const SSR::Trajectory& trajectory);
+
+    /**
+     * Removes the trajectory of the source with the transferred id.
+     *
+     * Must be called from the message thread.
+     *
+     * @param     source_id       The SSR id of the source.
+     *
+     * @return    true if the source had a trajectory.
+     */
+    bool remove_trajectory(const unsigned int source_id);
+
+    /**
+     * Removes all trajectories.
+     *
+     * Must be called from the message thread.
+     */
+    void clear();
+
+    /**
+     * Returns a copy of all trajectories with the ids of their sources.
+     *
+     * @return all trajectories with the ids of their sources.
+     */
+    std::vector< std::pair<unsigned int, SSR::Trajectory> > get_trajectories() const;
+
+    /**
+     * Sets the maximum number of passes per second of audio.
+     *
+     * @param     max_rate_in_hz  The maximum rate, 0 evaluates every block.
+     */
+    void set_max_rate(const unsigned int max_rate_in_hz);
+
+    /**
+     * Sets the sample rate used to convert block sizes into time.
+     *
+     * @param     sample_rate     The sample rate in Hz.
+     */
+    void prepare(const double sample_rate);
+
+    /**
+     * Advances by one audio block and evaluates all trajectories if a pass is
+     * due.
+     *
+     * Must be called from the audio thread.
+     *
+     * @param     time_in_seconds The host timeline position of the block.
+     *
+     * @param     sample_count    The number of samples of the block.
+     *
+     * @param     positions       Will point to the changed positions, valid
+     *                            until the next call.
+     *
+     * @return    the number of changed positions.
+     */
+    std::size_t process(const double time_in_seconds, const int sample_count, const Position*& positions);
+
+    /**
+     * Moves the positions of the latest passes which were not yet taken into
+     * the transferred vector (the latest position per source).
+     *
+     * Must be called from the message thread.
+     *
+     * @param     positions       The vector the positions are appended to.
+     *
+     * @return    true if there was at least one position.
+     */
+    bool take_positions(std::vector<Position>& positions);
+
+    /**
+     * Writes all trajectories with the ids of their sources to the
+     * transferred stream.
+     *
+     * @param     output          The stream the trajectories are written to.
+     */
+    void write_state(juce::OutputStream& output) const;
+
+    /**
+     * Replaces all trajectories by the ones written by write_state. The
+     * trajectories are only changed if the whole section could be read.
+     *
+     * Must be called from the message thread.
+     *
+     * @param     input           The stream the trajectories are read from.
+     *
+     * @throws    runtime_error     If the section is truncated or has more
+     *                              than max_trajectories trajectories.
+     *
+     * @throws    invalid_argument  If a trajectory is invalid.
+     */
+    void read_state(juce::InputStream& input);
+
+  private:
+
+    /**
+     * Writes one trajectory of the state section.
+     */
+    static void write_trajectory(juce::OutputStream& output, const SSR::Trajectory& trajectory);
+
+    /**
+     * Reads one trajectory of the state section.
+     */
+    static SSR::Trajectory read_trajectory(juce::InputStream& input);
+
+    /**
+     * A trajectory bound to a source.
+     */
+    struct Binding
+    {
+      unsigned int source_id;
+      SSR::Trajectory trajectory;
+      bool was_active;
+      bool has_position;
+      bool position_taken;
+      float last_x;
+      float last_y;
+    };
+
+    /**
+     * Guards bindings and the settings.
+     */
+    juce::SpinLock lock;
+
+    /**
+     * The trajectories and their evaluation state.
+     */
+    std::vector<Binding> bindings;
+
+    /**
+     * The changed positions of the current pass, only touched by the audio
+     * thread.
+     */
+    std::vector<Position> positions;
+
+    /**
+     * The sample rate in Hz.
+     */
+    double sample_rate;
+
+    /**
+     * The maximum number of passes per second.
+     */
+    unsigned int max_rate_in_hz;
+
+    /**
+     * The number of samples until the next pass is due.
+     */
+    double samples_until_pass;
+
+  };
+
+}
+
+#endif
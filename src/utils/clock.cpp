@@ -22,9 +22,14 @@
 
 std::string SSR::compute_current_time()
 {
-    std::time_t now_c = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    return format_time(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()));
+}
 
-    struct tm* parts = std::localtime(&now_c);
+std::string SSR::format_time(const std::time_t time)
+{
+    // localtime_r instead of localtime, the logger formats on its own thread.
+    struct tm local_time;
+    struct tm* parts = localtime_r(&time, &local_time);
 
     std::unique_ptr<std::stringstream> ss(new std::stringstream(std::string("")));
 
@@ -13,6 +13,7 @@
  * For more detailed information, please read the license.txt in the root directory.
  */
 
+#include <ctime>
 #include <string>
 
 namespace SSR
@@ -30,6 +31,15 @@ namespace SSR
      */
     std::string compute_current_time();
 
+    /**
+     * Formats the transferred time like compute_current_time().
+     *
+     * @param   time    The time which shall be formatted.
+     *
+     * @return the formatted time.
+     */
+    std::string format_time(const std::time_t time);
+
 }
 
 
@@ -0,0 +1,53 @@
+#ifndef CONNECTION_STATE_H
+#define CONNECTION_STATE_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+namespace SSR
+{
+
+  /**
+   * The states of the connection to the SSR:
+   *
+   * - disconnected: there is no connection,
+   * - connecting: the connection is being established,
+   * - syncing: the connection is established and the SSR sends its scene,
+   * - live: the scene is in sync, updates go back and forth.
+   */
+  enum class Connection_state {
+    disconnected,
+    connecting,
+    syncing,
+    live
+  };
+
+  /**
+   * Returns a human readable name of the transferred state.
+   *
+   * @param     state           The connection state.
+   *
+   * @return the name of the state.
+   */
+  inline const char* to_string(const Connection_state state)
+  {
+    switch (state) {
+      case Connection_state::connecting:    return "Connecting...";
+      case Connection_state::syncing:       return "Syncing...";
+      case Connection_state::live:          return "Connected";
+      default:                              return "Disconnected";
+    }
+  }
+
+}
+
+#endif
@@ -0,0 +1,209 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/echo_filter.h>
+
+//C++ Libs
+#include <algorithm>
+#include <cmath>
+
+//Own Libs
+#include <src/utils/update_specificator.h>
+
+//============================================================================
+// PUBLIC
+
+SSR::Echo_filter::Echo_filter(SSR::Latency_probe* probe)
+: sources()
+, suppressed_fields(0)
+, round_trip_in_msec(-1.0)
+, probe(probe)
+{
+
+}
+
+SSR::Echo_filter::~Echo_filter()
+{
+
+}
+
+void SSR::Echo_filter::sent(const SSR::Outbound_update& update, const double now_in_msec)
+{
+  typedef SSR::Update_specificator::Specificators specificators;
+
+  if (update.changed.contains(specificators::new_source)) {
+      return;
+  }
+
+  auto found = sources.find(update.source_id);
+
+  if (found == sources.end()) {
+      found = sources.insert(std::make_pair(update.source_id, Source_channels())).first;
+      found->second.known_fixed = unknown;
+  }
+
+  std::array<In_flight, channel_count>& channels = found->second.channels;
+
+  if (update.changed.contains(specificators::position)) {
+      push(channels[position], update.x_position, update.y_position, now_in_msec);
+  }
+
+  if (update.changed.contains(specificators::gain)) {
+      push(channels[volume], update.gain_in_db, 0.0f, now_in_msec);
+  }
+
+  if (update.changed.contains(specificators::mute)) {
+      push(channels[mute], update.mute ? 1.0f : 0.0f, 0.0f, now_in_msec);
+  }
+
+  if (update.changed.contains(specificators::fixed)) {
+      push(channels[fixed], update.fixed ? 1.0f : 0.0f, 0.0f, now_in_msec);
+      found->second.known_fixed = update.fixed ? 1 : 0;
+  }
+
+  if (update.changed.contains(specificators::model)) {
+      push(channels[model], update.model_point ? 1.0f : 0.0f, 0.0f, now_in_msec);
+  }
+}
+
+bool SSR::Echo_filter::filter(SSR::Source_update& update, const double now_in_msec)
+{
+  typedef SSR::Source_update field;
+
+  auto found = sources.find(update.id);
+
+  if (found == sources.end()) {
+      return true;
+  }
+
+  if (update.deleted) {
+      sources.erase(found);
+      return true;
+  }
+
+  std::array<In_flight, channel_count>& channels = found->second.channels;
+  const unsigned int fields_before = update.fields;
+
+  if (update.has(field::x_position) && update.has(field::y_position)) {
+
+      if (acknowledge(position, channels[position], update.x, update.y, now_in_msec)) {
+          update.clear(field::x_position);
+          update.clear(field::y_position);
+      }
+
+  } else if (update.has(field::x_position) || update.has(field::y_position)) {
+      channels[position].count = 0;
+  }
+
+  if (update.has(field::volume) && acknowledge(volume, channels[volume], update.volume_in_db, 0.0f, now_in_msec)) {
+      update.clear(field::volume);
+  }
+
+  if (update.has(field::mute) && acknowledge(mute, channels[mute], update.is_muted ? 1.0f : 0.0f, 0.0f, now_in_msec)) {
+      update.clear(field::mute);
+  }
+
+  if (update.has(field::fixed)) {
+
+      const int known_fixed = found->second.known_fixed;
+      found->second.known_fixed = update.is_fixed ? 1 : 0;
+
+      if (acknowledge(fixed, channels[fixed], update.is_fixed ? 1.0f : 0.0f, 0.0f, now_in_msec) || known_fixed == found->second.known_fixed) {
+          update.clear(field::fixed);
+      }
+
+  }
+
+  if (update.has(field::model) && acknowledge(model, channels[model], update.model_point ? 1.0f : 0.0f, 0.0f, now_in_msec)) {
+      update.clear(field::model);
+  }
+
+  if (update.fields != fields_before) {
+      suppressed_fields++;
+  }
+
+  return update.fields != 0;
+}
+
+void SSR::Echo_filter::clear()
+{
+  sources.clear();
+}
+
+unsigned long SSR::Echo_filter::get_suppressed_fields() const
+{
+  return suppressed_fields;
+}
+
+double SSR::Echo_filter::get_round_trip_in_msec() const
+{
+  return std::max(round_trip_in_msec, 0.0);
+}
+
+//============================================================================
+// PRIVATE
+
+void SSR::Echo_filter::push(In_flight& in_flight, const float first, const float second, const double now_in_msec)
+{
+  if (in_flight.count == max_in_flight) {
+      std::move(in_flight.values.begin() + 1, in_flight.values.end(), in_flight.values.begin());
+      in_flight.count--;
+  }
+
+  Value& value = in_flight.values[in_flight.count++];
+  value.first = first;
+  value.second = second;
+  value.sent_in_msec = now_in_msec;
+}
+
+bool SSR::Echo_filter::acknowledge(const Channel channel, In_flight& in_flight, const float first, const float second, const double now_in_msec)
+{
+  for (std::size_t index = 0; index < in_flight.count; index++) {
+
+      const Value& value = in_flight.values[index];
+
+      if (now_in_msec - value.sent_in_msec > expiry_in_msec) {
+          continue;
+      }
+
+      if (matches(value.first, first) && matches(value.second, second)) {
+
+          // Smoothed like the RTT estimate of TCP (RFC 6298).
+          const double sample_in_msec = now_in_msec - value.sent_in_msec;
+          round_trip_in_msec = (round_trip_in_msec < 0.0) ? sample_in_msec : round_trip_in_msec + (sample_in_msec - round_trip_in_msec) / 8.0;
+
+          if (probe != nullptr) {
+              probe->record_round_trip(static_cast<SSR::Latency_probe::Kind>(channel), sample_in_msec * 1000.0);
+          }
+
+          // The SSR handles requests in order, so all older values are
+          // acknowledged, too.
+          std::move(in_flight.values.begin() + index + 1, in_flight.values.begin() + in_flight.count, in_flight.values.begin());
+          in_flight.count -= index + 1;
+
+          return true;
+      }
+
+  }
+
+  in_flight.count = 0;
+
+  return false;
+}
+
+bool SSR::Echo_filter::matches(const float sent, const float received)
+{
+  // The SSR writes 6 significant digits.
+  const float tolerance = std::max(0.0001f, std::abs(sent) * 0.00001f);
+
+  return std::abs(sent - received) <= tolerance;
+}
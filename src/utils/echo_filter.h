@@ -0,0 +1,229 @@
+#ifndef ECHO_FILTER_H
+#define ECHO_FILTER_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+
+//Own Libs
+#include <src/utils/outbound_update.h>
+#include <src/utils/latency_probe.h>
+#include <src/scene/update_parser.h>
+
+//JUCE Lib
+#include <JUCE/JuceHeader.h>
+
+namespace SSR
+{
+
+  /**
+   * This class recognizes the updates the SSR echoes for the requests of
+   * this plugin.
+   *
+   * The SSR answers every request by broadcasting the resulting update to
+   * all clients, including the one which sent it. Applying these echoes
+   * again does not change anything in the best case, and in the worst case
+   * sets a source back to an older value while newer ones are still in
+   * flight, which lets the source jump back and forth during fast
+   * automation.
+   *
+   * Per source and field (position, volume, mute, fixed, model) the filter
+   * keeps the values which were sent but not yet echoed, oldest first. An
+   * incoming value which matches one of them is an echo: it and all older
+   * values are acknowledged and the field is removed from the update. A
+   * value which matches none was changed by someone else, the pending
+   * values of that field are forgotten so the following echoes are applied
+   * again. Values which are not echoed within expiry_in_msec are forgotten
+   * as well.
+   *
+   * The time from sending a value until its echo arrives is the round trip
+   * to the SSR, which the filter smoothes over the acknowledged values and
+   * records per field in the Latency_probe, if one is given.
+   *
+   * The SSR reports the fixed flag with every position, so the filter also
+   * remembers the last known fixed flag of a source and drops a fixed field
+   * which repeats it.
+   *
+   * Not thread safe, used by the network thread only.
+   */
+  class Echo_filter
+  {
+
+  public:
+
+    /**
+     * The maximum number of values in flight per source and field, older
+     * ones are forgotten.
+     */
+    static const std::size_t max_in_flight = 8;
+
+    /**
+     * Time in milliseconds after which a sent value is not expected to be
+     * echoed anymore.
+     */
+    static const juce::uint32 expiry_in_msec = 2000;
+
+    /**
+     * Constructor.
+     *
+     * @param     probe           The probe the round trips are recorded in,
+     *                            or nullptr. Must outlive the filter.
+     */
+    explicit Echo_filter(SSR::Latency_probe* probe = nullptr);
+
+    /**
+     * Destructor.
+     */
+    ~Echo_filter();
+
+    /**
+     * Records the changed fields of the transferred update as in flight.
+     * Updates creating a new source are ignored since its id is not known
+     * yet.
+     *
+     * @param     update          The update which is sent to the SSR.
+     *
+     * @param     now_in_msec     The current time in milliseconds
+     *                            (juce::Time::getMillisecondCounterHiRes).
+     */
+    void sent(const SSR::Outbound_update& update, const double now_in_msec);
+
+    /**
+     * Removes the fields of the transferred record which are echoes of
+     * values in flight.
+     *
+     * @param     update          The record parsed from a message of the SSR.
+     *
+     * @param     now_in_msec     The current time in milliseconds
+     *                            (juce::Time::getMillisecondCounterHiRes).
+     *
+     * @return    true if the record still changes anything, false if it was
+     *            an echo only.
+     */
+    bool filter(SSR::Source_update& update, const double now_in_msec);
+
+    /**
+     * Forgets all values in flight, e.g. after the connection was lost.
+     */
+    void clear();
+
+    /**
+     * Returns the number of fields removed as echoes so far.
+     *
+     * @return the number of fields removed as echoes so far.
+     */
+    unsigned long get_suppressed_fields() const;
+
+    /**
+     * Returns the smoothed round trip time to the SSR, measured from sending
+     * a value to receiving its echo.
+     *
+     * @return the round trip time in milliseconds, 0 until the first echo.
+     */
+    double get_round_trip_in_msec() const;
+
+  private:
+
+    /**
+     * The fields the SSR echoes, in the order of Latency_probe::Kind.
+     */
+    enum Channel {
+      position,
+      volume,
+      mute,
+      fixed,
+      model,
+      channel_count
+    };
+
+    /**
+     * A value in flight, booleans are stored as 0 and 1.
+     */
+    struct Value
+    {
+      float first;
+      float second;
+      double sent_in_msec;
+    };
+
+    /**
+     * The values of one field in flight, oldest first.
+     */
+    struct In_flight
+    {
+      std::array<Value, max_in_flight> values;
+      std::size_t count;
+    };
+
+    /**
+     * The known_fixed of a source whose fixed flag was not seen yet.
+     */
+    static const int unknown = -1;
+
+    /**
+     * The values in flight of one source, and its last known fixed flag.
+     */
+    struct Source_channels
+    {
+      std::array<In_flight, channel_count> channels;
+      int known_fixed;
+    };
+
+    /**
+     * Appends the transferred value to the values in flight.
+     */
+    static void push(In_flight& in_flight, const float first, const float second, const double now_in_msec);
+
+    /**
+     * Acknowledges the transferred value of the transferred channel if it
+     * is in flight and takes its round trip time.
+     *
+     * @return    true if the value was in flight.
+     */
+    bool acknowledge(const Channel channel, In_flight& in_flight, const float first, const float second, const double now_in_msec);
+
+    /**
+     * Returns true if the transferred values are equal within the precision
+     * the SSR writes numbers with.
+     */
+    static bool matches(const float sent, const float received);
+
+    /**
+     * The values in flight per source id.
+     */
+    std::unordered_map<unsigned int, Source_channels> sources;
+
+    /**
+     * The number of fields removed as echoes.
+     */
+    unsigned long suppressed_fields;
+
+    /**
+     * The smoothed round trip time in milliseconds, negative until the first
+     * echo.
+     */
+    double round_trip_in_msec;
+
+    /**
+     * Where the round trips are recorded, may be nullptr.
+     */
+    SSR::Latency_probe* probe;
+
+  };
+
+}
+
+#endif
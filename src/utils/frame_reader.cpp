@@ -0,0 +1,151 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/frame_reader.h>
+
+//C++ Libs
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+//============================================================================
+// PUBLIC
+
+SSR::Frame_reader::Frame_reader(const char delimiter, std::size_t initial_capacity)
+: delimiter(delimiter)
+, read_position(0)
+, write_position(0)
+, scan_position(0)
+, pending_release(0)
+{
+  std::size_t capacity = 64;
+
+  while (capacity < initial_capacity) {
+      capacity <<= 1;
+  }
+
+  ring.resize(capacity);
+}
+
+SSR::Frame_reader::~Frame_reader()
+{
+
+}
+
+char* SSR::Frame_reader::prepare_write(std::size_t& available)
+{
+  read_position += pending_release;
+  pending_release = 0;
+
+  // An empty ring starts over at its beginning so frames stay contiguous.
+  if (read_position == write_position) {
+      read_position = write_position = scan_position = 0;
+  }
+
+  if (write_position - read_position == ring.size()) {
+      grow();
+  }
+
+  const std::size_t mask = ring.size() - 1;
+  const std::size_t write_index = write_position & mask;
+  const std::size_t read_index = read_position & mask;
+
+  if (write_index < read_index) {
+      available = read_index - write_index;
+  } else {
+      available = ring.size() - write_index;
+  }
+
+  return &ring[write_index];
+}
+
+void SSR::Frame_reader::commit(const std::size_t bytes)
+{
+  write_position += bytes;
+}
+
+bool SSR::Frame_reader::next_frame(Frame& frame)
+{
+  read_position += pending_release;
+  pending_release = 0;
+
+  const std::size_t mask = ring.size() - 1;
+
+  while (scan_position < write_position) {
+
+      const std::size_t scan_index = scan_position & mask;
+      const std::size_t length = std::min(write_position - scan_position, ring.size() - scan_index);
+
+      const char* found = static_cast<const char*>(std::memchr(&ring[scan_index], delimiter, length));
+
+      if (found == nullptr) {
+          scan_position += length;
+          continue;
+      }
+
+      const std::size_t delimiter_position = scan_position + (found - &ring[scan_index]);
+      const std::size_t read_index = read_position & mask;
+
+      frame.size = delimiter_position - read_position;
+
+      if (read_index + frame.size <= ring.size()) {
+          frame.data = &ring[read_index];
+      } else {
+          const std::size_t first_part = ring.size() - read_index;
+
+          scratch.resize(frame.size);
+          std::memcpy(&scratch[0], &ring[read_index], first_part);
+          std::memcpy(&scratch[first_part], &ring[0], frame.size - first_part);
+
+          frame.data = &scratch[0];
+      }
+
+      scan_position = delimiter_position + 1;
+      pending_release = frame.size + 1;
+
+      return true;
+  }
+
+  return false;
+}
+
+void SSR::Frame_reader::clear()
+{
+  read_position = write_position = scan_position = pending_release = 0;
+}
+
+std::size_t SSR::Frame_reader::size() const
+{
+  return write_position - read_position;
+}
+
+//============================================================================
+// PRIVATE
+
+void SSR::Frame_reader::grow()
+{
+  const std::size_t mask = ring.size() - 1;
+  const std::size_t used = write_position - read_position;
+  const std::size_t read_index = read_position & mask;
+  const std::size_t first_part = std::min(used, ring.size() - read_index);
+
+  std::vector<char> bigger(ring.size() * 2);
+
+  std::memcpy(&bigger[0], &ring[read_index], first_part);
+  std::memcpy(&bigger[first_part], &ring[0], used - first_part);
+
+  scan_position -= read_position;
+  read_position = 0;
+  write_position = used;
+
+  ring.swap(bigger);
+}
@@ -0,0 +1,175 @@
+#ifndef FRAME_READER_H
+#define FRAME_READER_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace SSR
+{
+
+  /**
+   * A non owning view on one complete message (without its delimiter).
+   */
+  struct Frame
+  {
+
+    /**
+     * Pointer to the first character of the message.
+     */
+    const char* data;
+
+    /**
+     * Number of characters of the message.
+     */
+    std::size_t size;
+
+    /**
+     * Returns a copy of the viewed message.
+     *
+     * @return a copy of the viewed message.
+     */
+    std::string to_string() const { return std::string(data, size); }
+
+  };
+
+  /**
+   * This class splits a byte stream into delimiter separated frames.
+   *
+   * Incoming bytes are written directly into a growable ring buffer (see
+   * prepare_write and commit), delimiters are searched block wise with
+   * std::memchr and complete frames are handed out as views into the buffer.
+   * Only a frame which wraps around the end of the ring is copied (once) into
+   * a scratch buffer so that it can be viewed contiguously.
+   *
+   * Bytes already scanned are not scanned again when more data arrives.
+   */
+  class Frame_reader
+  {
+
+  public:
+
+    /**
+     * Constructor.
+     *
+     * @param     delimiter               The character separating two frames.
+     *
+     * @param     initial_capacity        The initial capacity of the ring
+     *                                    buffer, rounded up to a power of two.
+     */
+    Frame_reader(const char delimiter, std::size_t initial_capacity = 4096);
+
+    /**
+     * Destructor.
+     */
+    ~Frame_reader();
+
+    /**
+     * Returns a pointer to the contiguous free space of the ring buffer into
+     * which new bytes can be written. The buffer grows if it is full.
+     *
+     * @param     available       Will be set to the number of bytes that may
+     *                            be written to the returned pointer.
+     *
+     * @return    a pointer to the free space of the ring buffer.
+     */
+    char* prepare_write(std::size_t& available);
+
+    /**
+     * Marks the transferred number of bytes written to the pointer returned
+     * by prepare_write as readable.
+     *
+     * @param     bytes           Number of bytes which have been written.
+     */
+    void commit(const std::size_t bytes);
+
+    /**
+     * Releases the previously returned frame and searches the next complete
+     * frame.
+     *
+     * The returned view stays valid until the next call of next_frame,
+     * prepare_write or clear.
+     *
+     * @param     frame           Will be set to the next complete frame.
+     *
+     * @return    true if there was a complete frame, false otherwise.
+     */
+    bool next_frame(Frame& frame);
+
+    /**
+     * Discards all buffered bytes.
+     */
+    void clear();
+
+    /**
+     * Returns the number of buffered bytes including the released ones of
+     * the frame returned last.
+     *
+     * @return the number of buffered bytes.
+     */
+    std::size_t size() const;
+
+  private:
+
+    /**
+     * Doubles the capacity of the ring buffer and linearizes its content.
+     */
+    void grow();
+
+  private:
+
+    /**
+     * The character separating two frames.
+     */
+    char delimiter;
+
+    /**
+     * The ring buffer, its size is always a power of two.
+     */
+    std::vector<char> ring;
+
+    /**
+     * Buffer for frames wrapping around the end of the ring.
+     */
+    std::vector<char> scratch;
+
+    /**
+     * Absolute position of the first unread byte.
+     */
+    std::size_t read_position;
+
+    /**
+     * Absolute position of the next byte to write.
+     */
+    std::size_t write_position;
+
+    /**
+     * Absolute position up to which the buffer has been searched for the
+     * delimiter.
+     */
+    std::size_t scan_position;
+
+    /**
+     * Number of bytes (including the delimiter) of the frame returned last
+     * which will be released by the next call of next_frame.
+     */
+    std::size_t pending_release;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,122 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/host_clock.h>
+
+//C++ Libs
+#include <algorithm>
+#include <cmath>
+
+//============================================================================
+// PUBLIC
+
+SSR::Host_clock::Host_clock()
+: sequence(0)
+, sample_position(-1)
+, block_size(0)
+, playing(false)
+, realtime(true)
+, start_in_msec(0.0)
+, sample_rate(44100.0)
+{
+
+}
+
+SSR::Host_clock::~Host_clock()
+{
+
+}
+
+void SSR::Host_clock::prepare(const double new_sample_rate)
+{
+  sequence.fetch_add(1, std::memory_order_acq_rel);
+  sample_rate.store(new_sample_rate, std::memory_order_relaxed);
+  sequence.fetch_add(1, std::memory_order_release);
+}
+
+void SSR::Host_clock::start_block(const long long new_sample_position, const int new_block_size, const bool new_realtime, const double now_in_msec)
+{
+  sequence.fetch_add(1, std::memory_order_acq_rel);
+  sample_position.store(new_sample_position, std::memory_order_relaxed);
+  block_size.store(new_block_size, std::memory_order_relaxed);
+  playing.store(true, std::memory_order_relaxed);
+  realtime.store(new_realtime, std::memory_order_relaxed);
+  start_in_msec.store(now_in_msec, std::memory_order_relaxed);
+  sequence.fetch_add(1, std::memory_order_release);
+}
+
+void SSR::Host_clock::stop()
+{
+  if (!playing.load(std::memory_order_relaxed)) {
+      return;
+  }
+
+  sequence.fetch_add(1, std::memory_order_acq_rel);
+  playing.store(false, std::memory_order_relaxed);
+  sequence.fetch_add(1, std::memory_order_release);
+}
+
+SSR::Host_stamp SSR::Host_clock::stamp_block(const int sample_offset) const
+{
+  return stamp(read_block(), sample_offset);
+}
+
+SSR::Host_stamp SSR::Host_clock::stamp_now(const double now_in_msec) const
+{
+  const Block block = read_block();
+  const double elapsed_in_msec = std::max(now_in_msec - block.start_in_msec, 0.0);
+
+  return stamp(block, std::floor(elapsed_in_msec * block.sample_rate / 1000.0));
+}
+
+//============================================================================
+// PRIVATE
+
+SSR::Host_clock::Block SSR::Host_clock::read_block() const
+{
+  Block block;
+  unsigned int before = 0;
+
+  do {
+      before = sequence.load(std::memory_order_acquire);
+
+      block.sample_position = sample_position.load(std::memory_order_relaxed);
+      block.block_size = block_size.load(std::memory_order_relaxed);
+      block.playing = playing.load(std::memory_order_relaxed);
+      block.realtime = realtime.load(std::memory_order_relaxed);
+      block.start_in_msec = start_in_msec.load(std::memory_order_relaxed);
+      block.sample_rate = sample_rate.load(std::memory_order_relaxed);
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+  } while ((before & 1) != 0 || before != sequence.load(std::memory_order_relaxed));
+
+  return block;
+}
+
+SSR::Host_stamp SSR::Host_clock::stamp(const Block& block, const double sample_offset)
+{
+  SSR::Host_stamp host_stamp;
+
+  if (!block.playing) {
+      return host_stamp;
+  }
+
+  host_stamp.sample_position = block.sample_position + static_cast<long long>(sample_offset);
+  host_stamp.playing = true;
+
+  // Offline rendering is not related to the wall clock.
+  if (block.realtime && block.sample_rate > 0.0) {
+      host_stamp.due_in_msec = block.start_in_msec + (sample_offset + block.block_size) * 1000.0 / block.sample_rate;
+  }
+
+  return host_stamp;
+}
@@ -0,0 +1,149 @@
+#ifndef HOST_CLOCK_H
+#define HOST_CLOCK_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <atomic>
+
+//Own Libs
+#include <src/utils/outbound_update.h>
+
+namespace SSR
+{
+
+  /**
+   * This class maps the sample positions of the host to the time at which
+   * they are audible, so changes can be stamped with the position they
+   * belong to (see Host_stamp).
+   *
+   * The audio thread starts every block with the play head position of the
+   * host. The audio of a block is computed one block before it is played, so
+   * a sample is expected to be audible one block after its block started
+   * plus its offset in the block. Changes made outside of processBlock (host
+   * automation) are placed by the time elapsed since the last block started.
+   *
+   * While the transport is stopped or the host renders offline, the stamps
+   * carry no due time and changes are sent at once.
+   *
+   * There is one writer, the audio thread. Stamps may be taken on any thread
+   * and never block or allocate: the block is published with a sequence
+   * counter and readers retry if it changed while they read.
+   */
+  class Host_clock
+  {
+
+  public:
+
+    /**
+     * Constructor, the transport is stopped.
+     */
+    Host_clock();
+
+    /**
+     * Destructor.
+     */
+    ~Host_clock();
+
+    /**
+     * Sets the sample rate of the following blocks.
+     *
+     * @param     sample_rate     The sample rate in Hz.
+     */
+    void prepare(const double sample_rate);
+
+    /**
+     * Starts a block while the transport is playing. Only called by the audio
+     * thread.
+     *
+     * @param     sample_position The sample position of the host at the start
+     *                            of the block.
+     *
+     * @param     block_size      The number of samples of the block.
+     *
+     * @param     realtime        False if the host renders offline.
+     *
+     * @param     now_in_msec     The current time
+     *                            (juce::Time::getMillisecondCounterHiRes).
+     */
+    void start_block(const long long sample_position, const int block_size, const bool realtime, const double now_in_msec);
+
+    /**
+     * Marks the transport as stopped. Only called by the audio thread.
+     */
+    void stop();
+
+    /**
+     * Returns the stamp of the sample at the transferred offset in the
+     * current block. Only called by the audio thread.
+     *
+     * @param     sample_offset   The offset of the sample in the block.
+     *
+     * @return    the stamp of the sample.
+     */
+    SSR::Host_stamp stamp_block(const int sample_offset) const;
+
+    /**
+     * Returns the stamp of a change made now, placed by the time elapsed
+     * since the current block started.
+     *
+     * @param     now_in_msec     The current time
+     *                            (juce::Time::getMillisecondCounterHiRes).
+     *
+     * @return    the stamp of the change.
+     */
+    SSR::Host_stamp stamp_now(const double now_in_msec) const;
+
+  private:
+
+    /**
+     * A consistent copy of the current block.
+     */
+    struct Block
+    {
+      long long sample_position;
+      int block_size;
+      bool playing;
+      bool realtime;
+      double start_in_msec;
+      double sample_rate;
+    };
+
+    /**
+     * Reads the current block, retrying while the audio thread writes it.
+     */
+    Block read_block() const;
+
+    /**
+     * Returns the stamp of the sample at the transferred offset from the
+     * start of the transferred block.
+     */
+    static SSR::Host_stamp stamp(const Block& block, const double sample_offset);
+
+    /**
+     * Odd while the audio thread writes the block.
+     */
+    std::atomic<unsigned int> sequence;
+
+    std::atomic<long long> sample_position;
+    std::atomic<int> block_size;
+    std::atomic<bool> playing;
+    std::atomic<bool> realtime;
+    std::atomic<double> start_in_msec;
+    std::atomic<double> sample_rate;
+
+  };
+
+}
+
+#endif
@@ -17,6 +17,9 @@
 #include <string>
 #include <memory>
 
+//Own Libs
+#include <src/utils/frame_reader.h>
+
 namespace SSR 
 {
 
@@ -62,6 +65,22 @@ public:
 	**/
 	virtual bool get_message(std::shared_ptr<std::string> new_message, int* wait_in_msec) = 0;
 
+	/**
+	* This method shall get a new message coming from the connected server
+	* as a view into the receive buffer, without copying it.
+	*
+	* @param 		frame 				Will be set to the new message from the
+	* 									connected server. Valid until the next
+	* 									call of get_frame or get_message.
+	* 
+	* @param 		wait_in_msec 		How many milliseconds this method shall
+	*									wait to receive a new message from the
+	* 									server.
+	*
+	* @return 		true if a new message was received, otherwise false.
+	**/
+	virtual bool get_frame(SSR::Frame& frame, int* wait_in_msec) = 0;
+
 	/**
 	* This method shall send a message to the connected server.
 	*
@@ -86,6 +105,16 @@ public:
 	* 				false. 
 	**/	
 	virtual bool is_connected() const = 0;	
+
+	/**
+	* This method shall return the round trip time of the transport as far
+	* as the operating system knows it, without the time the server needs to
+	* answer.
+	*
+	* @return		the round trip time in milliseconds, negative if it is
+	* 				not known.
+	**/
+	inline virtual double get_transport_round_trip_in_msec() const { return -1.0; };
 	
 };
 
@@ -0,0 +1,186 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/inbound_coalescer.h>
+
+//C++ Libs
+#include <utility>
+
+//============================================================================
+// PUBLIC
+
+SSR::Inbound_coalescer::Inbound_coalescer()
+: updates()
+, update_index()
+, texts()
+, collapsed_updates(0)
+, sync_finished(false)
+, synced_source_ids()
+{
+
+}
+
+SSR::Inbound_coalescer::~Inbound_coalescer()
+{
+
+}
+
+void SSR::Inbound_coalescer::add(const SSR::Source_update& update, const char* message)
+{
+  typedef SSR::Source_update field;
+
+  std::unordered_map<unsigned int, std::size_t>::iterator found = update_index.find(update.id);
+
+  if (found == update_index.end()) {
+
+      update_index.insert(std::make_pair(update.id, updates.size()));
+      updates.push_back(update);
+
+      SSR::Source_update& entry = updates.back();
+
+      if (entry.has(field::name)) {
+          copy_text(entry.name_text, message);
+      }
+
+      if (entry.has(field::properties_file)) {
+          copy_text(entry.properties_file_text, message);
+      }
+
+      if (entry.has(field::port)) {
+          copy_text(entry.port_text, message);
+      }
+
+      return;
+  }
+
+  collapsed_updates++;
+
+  SSR::Source_update& entry = updates[found->second];
+
+  if (update.deleted) {
+      entry.deleted = true;
+      entry.fields = 0;
+      return;
+  }
+
+  if (update.has(field::x_position)) {
+      entry.x = update.x;
+  }
+
+  if (update.has(field::y_position)) {
+      entry.y = update.y;
+  }
+
+  if (update.has(field::orientation)) {
+      entry.azimuth = update.azimuth;
+  }
+
+  if (update.has(field::volume)) {
+      entry.volume_in_db = update.volume_in_db;
+  }
+
+  if (update.has(field::fixed)) {
+      entry.is_fixed = update.is_fixed;
+  }
+
+  if (update.has(field::mute)) {
+      entry.is_muted = update.is_muted;
+  }
+
+  if (update.has(field::model)) {
+      entry.model_point = update.model_point;
+  }
+
+  if (update.has(field::name)) {
+      entry.name_text = update.name_text;
+      copy_text(entry.name_text, message);
+  }
+
+  if (update.has(field::properties_file)) {
+      entry.properties_file_text = update.properties_file_text;
+      copy_text(entry.properties_file_text, message);
+  }
+
+  if (update.has(field::port)) {
+      entry.port_text = update.port_text;
+      copy_text(entry.port_text, message);
+  }
+
+  entry.fields |= update.fields;
+}
+
+void SSR::Inbound_coalescer::finish_sync(const std::vector<unsigned int>& source_ids)
+{
+  sync_finished = true;
+  synced_source_ids = source_ids;
+}
+
+bool SSR::Inbound_coalescer::empty() const
+{
+  return updates.empty() && !sync_finished;
+}
+
+bool SSR::Inbound_coalescer::is_sync_finished() const
+{
+  return sync_finished;
+}
+
+const std::vector<unsigned int>& SSR::Inbound_coalescer::get_synced_source_ids() const
+{
+  return synced_source_ids;
+}
+
+const std::vector<SSR::Source_update>& SSR::Inbound_coalescer::get_updates() const
+{
+  return updates;
+}
+
+const char* SSR::Inbound_coalescer::get_texts() const
+{
+  return texts.data();
+}
+
+std::size_t SSR::Inbound_coalescer::get_collapsed_updates() const
+{
+  return collapsed_updates;
+}
+
+void SSR::Inbound_coalescer::clear()
+{
+  updates.clear();
+  update_index.clear();
+  texts.clear();
+  collapsed_updates = 0;
+  sync_finished = false;
+  synced_source_ids.clear();
+}
+
+void SSR::Inbound_coalescer::swap(Inbound_coalescer& other)
+{
+  updates.swap(other.updates);
+  update_index.swap(other.update_index);
+  texts.swap(other.texts);
+  std::swap(collapsed_updates, other.collapsed_updates);
+  std::swap(sync_finished, other.sync_finished);
+  synced_source_ids.swap(other.synced_source_ids);
+}
+
+//============================================================================
+// PRIVATE
+
+void SSR::Inbound_coalescer::copy_text(SSR::Text_span& span, const char* message)
+{
+  const std::size_t offset = texts.size();
+
+  texts.append(message + span.offset, span.length);
+  span.offset = offset;
+}
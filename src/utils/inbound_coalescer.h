@@ -0,0 +1,186 @@
+#ifndef INBOUND_COALESCER_H
+#define INBOUND_COALESCER_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+//Own Libs
+#include <src/scene/update_parser.h>
+
+namespace SSR
+{
+
+  /**
+   * This class merges the records parsed from the messages of the SSR until
+   * the scene applies them.
+   *
+   * Per source id it keeps one Source_update holding the newest value of
+   * every field received so far, so a burst of positions for one source is
+   * applied as a single position. The texts of the records are copied into
+   * an own buffer and the text spans of the merged records refer to it.
+   *
+   * A delete drops the fields received before it. Fields received after a
+   * delete are kept, the scene removes the source first and applies them
+   * afterwards, just as it would have done message by message.
+   *
+   * When the network thread finished a sync, it hands over the ids of all
+   * sources the SSR has, so the scene can drop the sources the SSR does not
+   * know (for example sources restored from the DAW session).
+   *
+   * The class is not thread safe.
+   */
+  class Inbound_coalescer
+  {
+
+  public:
+
+    /**
+     * Constructor.
+     */
+    Inbound_coalescer();
+
+    /**
+     * Destructor.
+     */
+    ~Inbound_coalescer();
+
+    /**
+     * Merges the transferred record into the record of its source.
+     *
+     * @param     update          The parsed record.
+     *
+     * @param     message         The message the text spans of the record
+     *                            refer to.
+     */
+    void add(const SSR::Source_update& update, const char* message);
+
+    /**
+     * Records that a sync finished and the SSR has exactly the sources with
+     * the transferred ids.
+     *
+     * @param     source_ids      The ids of all sources of the SSR.
+     */
+    void finish_sync(const std::vector<unsigned int>& source_ids);
+
+    /**
+     * Returns true if no record was added and no sync finished since the
+     * last clear.
+     *
+     * @return true if there is nothing to apply.
+     */
+    bool empty() const;
+
+    /**
+     * Returns true if a sync finished since the last clear.
+     *
+     * @return true if a sync finished since the last clear.
+     */
+    bool is_sync_finished() const;
+
+    /**
+     * Returns the ids of all sources of the SSR at the end of the last sync.
+     *
+     * @return the ids of the synced sources.
+     */
+    const std::vector<unsigned int>& get_synced_source_ids() const;
+
+    /**
+     * Returns the merged records, one per source in the order the sources
+     * were first seen.
+     *
+     * @return the merged records.
+     */
+    const std::vector<SSR::Source_update>& get_updates() const;
+
+    /**
+     * Returns the buffer the text spans of the merged records refer to.
+     *
+     * @return the text buffer.
+     */
+    const char* get_texts() const;
+
+    /**
+     * Returns the number of records merged into the record of a source which
+     * was already pending since the last clear.
+     *
+     * @return the number of collapsed records.
+     */
+    std::size_t get_collapsed_updates() const;
+
+    /**
+     * Removes all records but keeps the allocated memory.
+     */
+    void clear();
+
+    /**
+     * Exchanges the records with the transferred coalescer.
+     *
+     * @param     other           The coalescer to swap with.
+     */
+    void swap(Inbound_coalescer& other);
+
+  private:
+
+    /**
+     * Copies the transferred text from the message into texts and sets the
+     * span to the copy.
+     *
+     * @param     span            The span of the text, relative to message
+     *                            before and to texts after the call.
+     *
+     * @param     message         The message the span refers to.
+     */
+    void copy_text(SSR::Text_span& span, const char* message);
+
+  private:
+
+    /**
+     * The merged records.
+     */
+    std::vector<SSR::Source_update> updates;
+
+    /**
+     * Maps a source id to its index in updates.
+     */
+    std::unordered_map<unsigned int, std::size_t> update_index;
+
+    /**
+     * The raw texts the merged records refer to.
+     */
+    std::string texts;
+
+    /**
+     * Number of records merged into a pending one.
+     */
+    std::size_t collapsed_updates;
+
+    /**
+     * True if a sync finished since the last clear.
+     */
+    bool sync_finished;
+
+    /**
+     * The ids of all sources of the SSR at the end of the last sync.
+     */
+    std::vector<unsigned int> synced_source_ids;
+
+  };
+
+}
+
+#endif
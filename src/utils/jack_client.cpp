@@ -10,12 +10,11 @@
  * For more detailed information, please read the license.txt in the root directory.
  */
 
-#include <memory>
-
 #include <src/utils/jack_client.h>
 
 SSR::Jack_client::Jack_client()
 : client(nullptr)
+, output_ports(JackPortIsOutput)
 {   
   status = JackFailure;
 }
@@ -23,7 +22,7 @@ SSR::Jack_client::Jack_client()
 SSR::Jack_client::~Jack_client()
 {
 
-  if (status & JackServerStarted) {
+  if (client != nullptr) {
       jack_client_close(client);
   }
 
@@ -33,31 +32,21 @@ void SSR::Jack_client::register_client(const char* jack_client_name)
 {
   client = jack_client_open(jack_client_name, JackNoStartServer, &status);
 
-  if (status & JackServerFailed) {
+  if (client == nullptr || (status & JackServerFailed)) {
+      client = nullptr;
       throw jack_server_not_running_exception();
   }
 
+  output_ports.attach(client);
+  jack_activate(client);
 }
 
-std::vector<std::string> SSR::Jack_client::look_up_jack_ports(unsigned long flags)
+std::shared_ptr<const SSR::Jack_port_snapshot> SSR::Jack_client::get_output_ports() const
 {
-  if (status & JackFailure) {
-      throw jack_server_not_running_exception();
-  }
-
-  const char **ports = jack_get_ports(client, NULL, NULL, flags);
-
-  if (NULL == ports) {
-      throw no_jack_ports_available_exception();
-  }
-
-  std::vector<std::string> v_ports;
-
-  for (int i = 0; ports[i] != NULL; i++) {
-      v_ports.push_back(ports[i]);
-  }
-
-  free(ports);
+  return output_ports.get_snapshot();
+}
 
-  return v_ports;
+unsigned long SSR::Jack_client::get_output_ports_version() const
+{
+  return output_ports.get_version();
 }
@@ -20,11 +20,14 @@
 #include <iostream>
 #include <string>
 #include <exception>
-#include <vector>
+#include <memory>
 
 //Jack Libs
 #include <jack/jack.h>
 
+//Own Libs
+#include <src/utils/jack_port_registry.h>
+
 namespace SSR 
 {
 
@@ -40,18 +43,6 @@ struct jack_server_not_running_exception : public std::exception
 
 };
 
-/**
- * Exception predicating that there are not jack ports available.
- */
-struct no_jack_ports_available_exception : public std::exception
-{
-
-  const char * what () const throw () {
-    return "Could not get any Jackports.";
-  }
-
-};
-
 /**
  * This is a client wrapper class for the jack audio server.
  **/
@@ -66,13 +57,15 @@ public:
 
   /**
    * Destructor deregistering this jack client from the jack server (if
-   * the client has been registered before).
+   * the client has been registered before). The client is closed before
+   * output_ports is destroyed, so no port callback outlives it.
    */
   ~Jack_client();
 
   /**
    * Registers this Jack client to the Jack Server with the transfered
-   * jack_client_name.
+   * jack_client_name, loads the output ports and activates the client so
+   * the server reports port changes.
    *
    * @param    jack_client_name   The name which identifies this client
    *                              on the Jack server.
@@ -84,23 +77,20 @@ public:
   void register_client(const char* jack_client_name);
 
   /**
-   * This method looks for all Jack Ports that match the flags parameter and
-   * returns them.
-   *
-   * @param  flags     See JackPortFlags (jack/types.h) for all flags you can
-   *                   set.
-   *
-   * @throws   no_jack_ports_available_exception     If there are no Jack Ports
-   *                                                 available matching the
-   *                                                 transfered flags.
+   * Returns the current snapshot of all Jack output ports. The list is loaded
+   * when the client is registered and kept current by the Jack server, the
+   * snapshot is empty (version 0) before.
    *
-   * @throws   jack_server_not_running_exception     If this jack client is not
-   *                                                 connected to the Jack
-   *                                                 server.
+   * @return   the current snapshot of the Jack output ports.
+   **/
+  std::shared_ptr<const SSR::Jack_port_snapshot> get_output_ports() const;
+
+  /**
+   * Returns the version of the current snapshot of the Jack output ports.
    *
-   * @return   all Jack Ports that matched the flags.
+   * @return   the version of the output port snapshot.
    **/
-  std::vector<std::string> look_up_jack_ports(unsigned long flags);
+  unsigned long get_output_ports_version() const;
 
 private:
 
@@ -114,6 +104,11 @@ private:
    */
   jack_status_t status;
 
+  /**
+   * The Jack output ports, kept current while the client is open.
+   */
+  SSR::Jack_port_registry output_ports;
+
 };
 
 }
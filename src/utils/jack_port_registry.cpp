@@ -0,0 +1,158 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/jack_port_registry.h>
+
+//C++ Libs
+#include <algorithm>
+#include <utility>
+
+//============================================================================
+// Jack_port_snapshot
+
+SSR::Jack_port_snapshot::Jack_port_snapshot(const unsigned long version, std::vector<std::string> names)
+: version(version)
+, names(std::move(names))
+, indices()
+{
+  indices.reserve(this->names.size());
+
+  for (std::size_t index = 0; index < this->names.size(); index++) {
+      indices.insert(std::make_pair(this->names[index], index));
+  }
+}
+
+unsigned long SSR::Jack_port_snapshot::get_version() const
+{
+  return version;
+}
+
+const std::vector<std::string>& SSR::Jack_port_snapshot::get_names() const
+{
+  return names;
+}
+
+std::size_t SSR::Jack_port_snapshot::index_of(const std::string& name) const
+{
+  auto found = indices.find(name);
+  return (found == indices.end()) ? npos : found->second;
+}
+
+//============================================================================
+// Jack_port_registry PUBLIC
+
+SSR::Jack_port_registry::Jack_port_registry(const unsigned long flags)
+: flags(flags)
+, client(nullptr)
+, names()
+, snapshot(new SSR::Jack_port_snapshot(0, std::vector<std::string>()))
+, version(0)
+, lock()
+{
+
+}
+
+SSR::Jack_port_registry::~Jack_port_registry()
+{
+
+}
+
+void SSR::Jack_port_registry::attach(jack_client_t* new_client)
+{
+  client = new_client;
+
+  jack_set_port_registration_callback(client, &Jack_port_registry::port_registered, this);
+  jack_set_port_rename_callback(client, &Jack_port_registry::port_renamed, this);
+
+  const char** ports = jack_get_ports(client, NULL, NULL, flags);
+
+  std::lock_guard<std::mutex> guard(lock);
+  names.clear();
+
+  if (ports != NULL) {
+
+      for (int i = 0; ports[i] != NULL; i++) {
+          names.push_back(ports[i]);
+      }
+
+      jack_free(ports);
+  }
+
+  publish();
+}
+
+std::shared_ptr<const SSR::Jack_port_snapshot> SSR::Jack_port_registry::get_snapshot() const
+{
+  std::lock_guard<std::mutex> guard(lock);
+  return snapshot;
+}
+
+unsigned long SSR::Jack_port_registry::get_version() const
+{
+  return version;
+}
+
+//============================================================================
+// Jack_port_registry PRIVATE
+
+void SSR::Jack_port_registry::port_registered(jack_port_id_t port_id, int registered, void* registry)
+{
+  Jack_port_registry* self = static_cast<Jack_port_registry*>(registry);
+  const jack_port_t* port = jack_port_by_id(self->client, port_id);
+
+  if (port == NULL || !self->is_listed(port)) {
+      return;
+  }
+
+  const std::string name = jack_port_name(port);
+
+  std::lock_guard<std::mutex> guard(self->lock);
+  auto found = std::find(self->names.begin(), self->names.end(), name);
+
+  if (registered && found == self->names.end()) {
+      self->names.push_back(name);
+  } else if (!registered && found != self->names.end()) {
+      self->names.erase(found);
+  } else {
+      return;
+  }
+
+  self->publish();
+}
+
+void SSR::Jack_port_registry::port_renamed(jack_port_id_t /*port_id*/, const char* old_name, const char* new_name, void* registry)
+{
+  Jack_port_registry* self = static_cast<Jack_port_registry*>(registry);
+
+  std::lock_guard<std::mutex> guard(self->lock);
+  auto found = std::find(self->names.begin(), self->names.end(), std::string(old_name));
+
+  if (found == self->names.end()) {
+      return;
+  }
+
+  *found = new_name;
+  self->publish();
+}
+
+bool SSR::Jack_port_registry::is_listed(const jack_port_t* port) const
+{
+  return (static_cast<unsigned long>(jack_port_flags(port)) & flags) == flags;
+}
+
+void SSR::Jack_port_registry::publish()
+{
+  const unsigned long next_version = version + 1;
+
+  snapshot = std::make_shared<const SSR::Jack_port_snapshot>(next_version, names);
+  version = next_version;
+}
@@ -0,0 +1,209 @@
+#ifndef JACK_PORT_REGISTRY_H
+#define JACK_PORT_REGISTRY_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//Jack Libs
+#include <jack/jack.h>
+
+namespace SSR
+{
+
+  /**
+   * An immutable list of JACK port names with an index by name.
+   *
+   * Snapshots are shared between threads and never change, a new version of
+   * the port list is a new snapshot.
+   */
+  class Jack_port_snapshot
+  {
+
+  public:
+
+    /**
+     * Returned by index_of for names which are not in the snapshot.
+     */
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    /**
+     * Constructor indexing the transferred names.
+     *
+     * @param     version         The version of the port list.
+     *
+     * @param     names           The port names.
+     */
+    Jack_port_snapshot(const unsigned long version, std::vector<std::string> names);
+
+    /**
+     * Returns the version of the port list, 0 before the ports were loaded.
+     *
+     * @return the version of the port list.
+     */
+    unsigned long get_version() const;
+
+    /**
+     * Returns the port names in the order JACK reported them.
+     *
+     * @return the port names.
+     */
+    const std::vector<std::string>& get_names() const;
+
+    /**
+     * Returns the index of the transferred name in get_names().
+     *
+     * @param     name            The port name.
+     *
+     * @return    the index or npos if there is no such port.
+     */
+    std::size_t index_of(const std::string& name) const;
+
+  private:
+
+    /**
+     * The version of the port list.
+     */
+    const unsigned long version;
+
+    /**
+     * The port names.
+     */
+    const std::vector<std::string> names;
+
+    /**
+     * The index of every port name in names.
+     */
+    std::unordered_map<std::string, std::size_t> indices;
+
+  };
+
+  /**
+   * This class keeps the list of JACK ports having certain flags.
+   *
+   * The list is loaded once when the registry is attached to a client and
+   * kept current by the port registration and rename callbacks of JACK, so
+   * the GUI never has to ask the server for the ports. Every change publishes
+   * a new Jack_port_snapshot with the next version number, readers compare
+   * versions to find out whether anything changed.
+   *
+   * The callbacks run on the notification thread of JACK, the snapshots may
+   * be taken on any thread.
+   */
+  class Jack_port_registry
+  {
+
+  public:
+
+    /**
+     * Constructor.
+     *
+     * @param     flags           The flags (JackPortFlags) a port must have
+     *                            to be listed.
+     */
+    explicit Jack_port_registry(const unsigned long flags);
+
+    /**
+     * Destructor.
+     */
+    ~Jack_port_registry();
+
+    /**
+     * Sets the callbacks at the transferred client and loads the ports. Must
+     * be called before the client is activated, and the client must be
+     * closed before the registry is destroyed.
+     *
+     * @param     client          The opened JACK client.
+     */
+    void attach(jack_client_t* client);
+
+    /**
+     * Returns the current snapshot of the ports.
+     *
+     * @return the current snapshot, never nullptr.
+     */
+    std::shared_ptr<const SSR::Jack_port_snapshot> get_snapshot() const;
+
+    /**
+     * Returns the version of the current snapshot without taking it.
+     *
+     * @return the version of the current snapshot.
+     */
+    unsigned long get_version() const;
+
+  private:
+
+    /**
+     * JackPortRegistrationCallback: adds or removes the port.
+     */
+    static void port_registered(jack_port_id_t port_id, int registered, void* registry);
+
+    /**
+     * JackPortRenameCallback: renames the port.
+     */
+    static void port_renamed(jack_port_id_t port_id, const char* old_name, const char* new_name, void* registry);
+
+    /**
+     * Returns true if the transferred port has the flags of this registry.
+     */
+    bool is_listed(const jack_port_t* port) const;
+
+    /**
+     * Publishes names as the next snapshot. The lock must be held.
+     */
+    void publish();
+
+  private:
+
+    /**
+     * The flags a port must have to be listed.
+     */
+    const unsigned long flags;
+
+    /**
+     * The client the registry is attached to.
+     */
+    jack_client_t* client;
+
+    /**
+     * The current port names, guarded by lock.
+     */
+    std::vector<std::string> names;
+
+    /**
+     * The current snapshot, guarded by lock.
+     */
+    std::shared_ptr<const SSR::Jack_port_snapshot> snapshot;
+
+    /**
+     * The version of the current snapshot.
+     */
+    std::atomic<unsigned long> version;
+
+    /**
+     * Guards names and snapshot.
+     */
+    mutable std::mutex lock;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/latency_histogram.h>
+
+//C++ Libs
+#include <algorithm>
+#include <cmath>
+
+//============================================================================
+// PUBLIC
+
+SSR::Latency_histogram::Latency_histogram()
+: count(0)
+, max(0)
+{
+  for (std::atomic<unsigned long long>& bucket : buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+SSR::Latency_histogram::~Latency_histogram()
+{
+
+}
+
+void SSR::Latency_histogram::record(const double value_in_usec)
+{
+  const double clamped = std::min(std::max(value_in_usec, 0.0), static_cast<double>(max_value_in_usec));
+  const unsigned long long value = static_cast<unsigned long long>(std::llround(clamped));
+
+  buckets[index_of(value)].fetch_add(1, std::memory_order_relaxed);
+  count.fetch_add(1, std::memory_order_relaxed);
+
+  unsigned long long current_max = max.load(std::memory_order_relaxed);
+
+  while (value > current_max && !max.compare_exchange_weak(current_max, value, std::memory_order_relaxed)) {
+  }
+}
+
+unsigned long long SSR::Latency_histogram::get_count() const
+{
+  return count.load(std::memory_order_relaxed);
+}
+
+unsigned long long SSR::Latency_histogram::get_max() const
+{
+  return max.load(std::memory_order_relaxed);
+}
+
+unsigned long long SSR::Latency_histogram::get_percentile(const double percentile) const
+{
+  const unsigned long long total = get_count();
+
+  if (total == 0) {
+      return 0;
+  }
+
+  const double share = std::min(std::max(percentile, 0.0), 100.0) / 100.0;
+  const unsigned long long rank = std::max(1ULL, static_cast<unsigned long long>(std::ceil(share * total)));
+  unsigned long long seen = 0;
+
+  for (std::size_t index = 0; index < bucket_count; index++) {
+
+      seen += buckets[index].load(std::memory_order_relaxed);
+
+      if (seen >= rank) {
+          return std::min(highest_value_of(index), get_max());
+      }
+
+  }
+
+  return get_max();
+}
+
+//============================================================================
+// PRIVATE
+
+std::size_t SSR::Latency_histogram::index_of(const unsigned long long value)
+{
+  if (value < 2 * sub_bucket_count) {
+      return static_cast<std::size_t>(value);
+  }
+
+  // The highest set bit selects the power of two, the next sub_bucket_bits
+  // bits the linear bucket within it.
+  const int highest_bit = 63 - __builtin_clzll(value);
+  const int shift = highest_bit - sub_bucket_bits;
+  const std::size_t sub_bucket = static_cast<std::size_t>(value >> shift) - sub_bucket_count;
+
+  return 2 * sub_bucket_count + (highest_bit - sub_bucket_bits - 1) * sub_bucket_count + sub_bucket;
+}
+
+unsigned long long SSR::Latency_histogram::highest_value_of(const std::size_t index)
+{
+  if (index < 2 * sub_bucket_count) {
+      return index;
+  }
+
+  const std::size_t offset = index - 2 * sub_bucket_count;
+  const int shift = static_cast<int>(offset / sub_bucket_count) + 1;
+  const unsigned long long sub_bucket = offset % sub_bucket_count + sub_bucket_count;
+
+  return ((sub_bucket + 1) << shift) - 1;
+}
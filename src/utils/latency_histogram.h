@@ -0,0 +1,125 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace SSR
+{
+
+  /**
+   * A histogram of latencies in microseconds with a bounded relative error,
+   * in the style of HdrHistogram.
+   *
+   * Values below 64 us have a bucket each. Above, every power of two is
+   * split into 32 linear buckets, so a recorded value is off by at most
+   * 1/32 (3 %) from the value reported for its bucket. Values of more than
+   * max_value_in_usec (about 71 minutes) are counted as max_value_in_usec.
+   *
+   * All counters are atomics: one thread may record while any other thread
+   * reads percentiles, neither blocks nor allocates. A reader running while
+   * values are recorded may see a count which is a few values ahead of the
+   * buckets.
+   */
+  class Latency_histogram
+  {
+
+  public:
+
+    /**
+     * The largest value kept apart, in microseconds.
+     */
+    static const unsigned long long max_value_in_usec = (1ULL << 32) - 1;
+
+    /**
+     * Constructor.
+     */
+    Latency_histogram();
+
+    /**
+     * Destructor.
+     */
+    ~Latency_histogram();
+
+    /**
+     * Counts the transferred latency.
+     *
+     * @param     value_in_usec   The latency in microseconds, negative values
+     *                            count as 0.
+     */
+    void record(const double value_in_usec);
+
+    /**
+     * Returns the number of recorded values.
+     *
+     * @return the number of recorded values.
+     */
+    unsigned long long get_count() const;
+
+    /**
+     * Returns the largest recorded value.
+     *
+     * @return the largest recorded value in microseconds, 0 if there is none.
+     */
+    unsigned long long get_max() const;
+
+    /**
+     * Returns the value below or at which the transferred percentage of the
+     * recorded values lie, as the highest value of its bucket.
+     *
+     * @param     percentile      The percentile from 0 to 100.
+     *
+     * @return    the value in microseconds, 0 if nothing was recorded.
+     */
+    unsigned long long get_percentile(const double percentile) const;
+
+  private:
+
+    /**
+     * The number of linear buckets per power of two (2^sub_bucket_bits).
+     */
+    static const int sub_bucket_bits = 5;
+
+    static const std::size_t sub_bucket_count = 1 << sub_bucket_bits;
+
+    /**
+     * 2 * sub_bucket_count values with a bucket each, then sub_bucket_count
+     * buckets for every further power of two up to 2^31.
+     */
+    static const std::size_t bucket_count = 2 * sub_bucket_count + (31 - sub_bucket_bits) * sub_bucket_count;
+
+    /**
+     * Returns the index of the bucket counting the transferred value.
+     */
+    static std::size_t index_of(const unsigned long long value);
+
+    /**
+     * Returns the highest value counted by the transferred bucket.
+     */
+    static unsigned long long highest_value_of(const std::size_t index);
+
+    std::array<std::atomic<unsigned long long>, bucket_count> buckets;
+
+    std::atomic<unsigned long long> count;
+
+    std::atomic<unsigned long long> max;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,137 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/latency_probe.h>
+
+//C++ Libs
+#include <cstdio>
+
+namespace
+{
+
+  void append_line(std::string& report, const char* name, const SSR::Latency_histogram& histogram)
+  {
+    char line[160];
+
+    std::snprintf(line, sizeof(line), "%-12s %10llu %10.3f %10.3f %10.3f %10.3f\n",
+                  name,
+                  histogram.get_count(),
+                  histogram.get_percentile(50.0) / 1000.0,
+                  histogram.get_percentile(95.0) / 1000.0,
+                  histogram.get_percentile(99.0) / 1000.0,
+                  histogram.get_max() / 1000.0);
+
+    report += line;
+  }
+
+}
+
+//============================================================================
+// PUBLIC
+
+SSR::Latency_probe::Latency_probe()
+: plugin()
+, network()
+, round_trips()
+{
+
+}
+
+SSR::Latency_probe::~Latency_probe()
+{
+
+}
+
+void SSR::Latency_probe::record_plugin(const double value_in_usec)
+{
+  plugin.record(value_in_usec);
+}
+
+void SSR::Latency_probe::record_network(const double value_in_usec)
+{
+  network.record(value_in_usec);
+}
+
+void SSR::Latency_probe::record_round_trip(const Kind kind, const double value_in_usec)
+{
+  round_trips[kind].record(value_in_usec);
+}
+
+const SSR::Latency_histogram& SSR::Latency_probe::get_plugin() const
+{
+  return plugin;
+}
+
+const SSR::Latency_histogram& SSR::Latency_probe::get_network() const
+{
+  return network;
+}
+
+const SSR::Latency_histogram& SSR::Latency_probe::get_round_trip(const Kind kind) const
+{
+  return round_trips[kind];
+}
+
+unsigned long long SSR::Latency_probe::get_ssr_percentile(const double percentile) const
+{
+  // The kind with the most echoes stands for all kinds.
+  const SSR::Latency_histogram* busiest = &round_trips[position];
+
+  for (const SSR::Latency_histogram& round_trip : round_trips) {
+
+      if (round_trip.get_count() > busiest->get_count()) {
+          busiest = &round_trip;
+      }
+
+  }
+
+  const unsigned long long round_trip = busiest->get_percentile(percentile);
+  const unsigned long long network_round_trip = network.get_percentile(percentile);
+
+  return (round_trip > network_round_trip) ? round_trip - network_round_trip : 0;
+}
+
+std::string SSR::Latency_probe::get_report() const
+{
+  std::string report;
+  char line[160];
+
+  std::snprintf(line, sizeof(line), "%-12s %10s %10s %10s %10s %10s\n", "stage [ms]", "count", "p50", "p95", "p99", "max");
+  report += line;
+
+  append_line(report, "plugin", plugin);
+  append_line(report, "network", network);
+
+  for (int kind = 0; kind < kind_count; kind++) {
+      append_line(report, get_name(static_cast<Kind>(kind)), round_trips[kind]);
+  }
+
+  std::snprintf(line, sizeof(line), "%-12s %10s %10.3f %10.3f %10.3f\n", "ssr", "",
+                get_ssr_percentile(50.0) / 1000.0,
+                get_ssr_percentile(95.0) / 1000.0,
+                get_ssr_percentile(99.0) / 1000.0);
+  report += line;
+
+  return report;
+}
+
+const char* SSR::Latency_probe::get_name(const Kind kind)
+{
+  switch (kind) {
+    case position:      return "position";
+    case gain:          return "gain";
+    case mute:          return "mute";
+    case fixed:         return "fixed";
+    case model:         return "model";
+    default:            return "unknown";
+  }
+}
@@ -0,0 +1,157 @@
+#ifndef LATENCY_PROBE_H
+#define LATENCY_PROBE_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <array>
+#include <string>
+
+//Own Libs
+#include <src/utils/latency_histogram.h>
+
+namespace SSR
+{
+
+  /**
+   * This class measures where the time between a change in the plugin and
+   * its confirmation by the SSR goes.
+   *
+   * - plugin: from entering the outbound queues (or being released by the
+   *   scheduler) until the request carrying it is written to the socket.
+   * - network: the round trip time of the transport, as estimated by the
+   *   TCP stack (see IConnection::get_transport_round_trip_in_msec()).
+   * - round trip per kind: from writing the request until the SSR echoes
+   *   the value, matched by the Echo_filter per source and field.
+   *
+   * The round trip minus the network round trip is the time the SSR takes
+   * to handle a request.
+   *
+   * The network thread records, any thread may read (see
+   * Latency_histogram).
+   */
+  class Latency_probe
+  {
+
+  public:
+
+    /**
+     * The kinds of changes the SSR echoes.
+     */
+    enum Kind {
+      position,
+      gain,
+      mute,
+      fixed,
+      model,
+      kind_count
+    };
+
+    /**
+     * Constructor.
+     */
+    Latency_probe();
+
+    /**
+     * Destructor.
+     */
+    ~Latency_probe();
+
+    /**
+     * Records the time a change spent in the plugin before it was sent.
+     *
+     * @param     value_in_usec   The time in microseconds.
+     */
+    void record_plugin(const double value_in_usec);
+
+    /**
+     * Records the round trip time of the transport.
+     *
+     * @param     value_in_usec   The time in microseconds.
+     */
+    void record_network(const double value_in_usec);
+
+    /**
+     * Records the time from sending a change of the transferred kind until
+     * its echo arrived.
+     *
+     * @param     kind            The kind of the change.
+     *
+     * @param     value_in_usec   The time in microseconds.
+     */
+    void record_round_trip(const Kind kind, const double value_in_usec);
+
+    /**
+     * Returns the histogram of the time changes spend in the plugin.
+     *
+     * @return the plugin histogram.
+     */
+    const SSR::Latency_histogram& get_plugin() const;
+
+    /**
+     * Returns the histogram of the round trip time of the transport.
+     *
+     * @return the network histogram.
+     */
+    const SSR::Latency_histogram& get_network() const;
+
+    /**
+     * Returns the histogram of the round trips of the transferred kind.
+     *
+     * @param     kind            The kind of the change.
+     *
+     * @return the round trip histogram of the kind.
+     */
+    const SSR::Latency_histogram& get_round_trip(const Kind kind) const;
+
+    /**
+     * Returns an estimate of the time the SSR needs to handle a request: the
+     * transferred percentile of the round trips of the most frequent kind
+     * minus the same percentile of the network round trips.
+     *
+     * @param     percentile      The percentile from 0 to 100.
+     *
+     * @return    the time in microseconds, 0 if nothing was measured.
+     */
+    unsigned long long get_ssr_percentile(const double percentile) const;
+
+    /**
+     * Returns a text table with count, p50, p95, p99 and max of every
+     * histogram, one line each.
+     *
+     * @return the report.
+     */
+    std::string get_report() const;
+
+    /**
+     * Returns the name of the transferred kind.
+     *
+     * @param     kind            The kind.
+     *
+     * @return    the name of the kind.
+     */
+    static const char* get_name(const Kind kind);
+
+  private:
+
+    SSR::Latency_histogram plugin;
+
+    SSR::Latency_histogram network;
+
+    std::array<SSR::Latency_histogram, kind_count> round_trips;
+
+  };
+
+}
+
+#endif
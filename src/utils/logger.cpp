@@ -11,65 +11,173 @@
  */
 
 //C++ Libs
-#include <memory>
-#include <sstream>
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <string>
 
 //Own Libs
 #include <src/utils/logger.h>
 #include <src/utils/clock.h>
 
-void SSR::Logger::log(Logger::Level level, std::string message, bool log_in_file) {
-        sstream->str(std::string(""));
-
-        append_current_time();
-        append_log_level(level);
+// Bound to const references by std::min and std::chrono, so they need a
+// definition.
+const std::size_t SSR::Logger::max_message_length;
+const int SSR::Logger::flush_interval_in_msec;
 
-        *sstream << message << std::endl;
-
-        if (log_in_file) {
-            logfile << sstream->str();
-        } else {
-            std::cerr << sstream->str();
-        }
-
-    }
+unsigned long SSR::Logger::get_dropped_records() const
+{
+  return dropped_records;
+}
 
+unsigned long SSR::Logger::get_truncated_records() const
+{
+  return truncated_records;
+}
 
 SSR::Logger::~Logger()
 {
+  {
+      std::lock_guard<std::mutex> lock(wake_mutex);
+      running = false;
+  }
+
+  wake.notify_one();
+  writer.join();
+
+  write_batch();
   logfile.close();
 }
 
-
 SSR::Logger::Logger(std::string filename)
 : logfile(filename, std::fstream::out | std::fstream::trunc)
-, sstream(new std::stringstream(std::string("")))
+, records()
+, dropped_records(0)
+, truncated_records(0)
+, reported_dropped_records(0)
+, popped_record()
+, file_batch()
+, cerr_batch()
+, last_time(0)
+, last_formatted_time("")
+, running(true)
+, wake_mutex()
+, wake()
+, writer()
+{
+  writer = std::thread(&SSR::Logger::run, this);
+}
+
+void SSR::Logger::enqueue(Level level, const char* message, std::size_t length, bool log_in_file)
 {
+  Record record;
+  record.level = level;
+  record.log_in_file = log_in_file;
+  record.truncated = length > max_message_length;
+  record.time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+  record.length = std::min(length, max_message_length);
+  std::memcpy(record.message, message, record.length);
+
+  if (record.truncated) {
+      truncated_records++;
+  }
+
+  if (!records.try_push(record)) {
+      dropped_records++;
+  }
+}
+
+void SSR::Logger::run()
+{
+  std::unique_lock<std::mutex> lock(wake_mutex);
+
+  while (running) {
+      wake.wait_for(lock, std::chrono::milliseconds(flush_interval_in_msec));
 
+      lock.unlock();
+      write_batch();
+      lock.lock();
+  }
 }
 
-void SSR::Logger::append_current_time()
+void SSR::Logger::write_batch()
 {
-  *sstream << "[" << SSR::compute_current_time() << "] ";
+  file_batch.clear();
+  cerr_batch.clear();
+
+  while (records.try_pop(popped_record)) {
+      append_record(popped_record, popped_record.log_in_file ? file_batch : cerr_batch);
+  }
+
+  const unsigned long dropped = dropped_records;
+
+  if (dropped != reported_dropped_records) {
+      Record report;
+      report.level = error;
+      report.log_in_file = true;
+      report.truncated = false;
+      report.time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+
+      const std::string message = "Logger dropped " + std::to_string(dropped - reported_dropped_records) + " records, the ring was full";
+      report.length = std::min(message.size(), max_message_length);
+      std::memcpy(report.message, message.data(), report.length);
+
+      append_record(report, file_batch);
+      reported_dropped_records = dropped;
+  }
+
+  if (!file_batch.empty()) {
+      logfile << file_batch;
+      logfile.flush();
+  }
+
+  if (!cerr_batch.empty()) {
+      std::cerr << cerr_batch;
+  }
 }
 
+void SSR::Logger::append_record(const Record& record, std::string& batch)
+{
+  if (record.time != last_time || last_formatted_time.empty()) {
+      last_time = record.time;
+      last_formatted_time = SSR::format_time(record.time);
+  }
+
+  batch += "[";
+  batch += last_formatted_time;
+  batch += "] ";
 
-void SSR::Logger::append_log_level(SSR::Logger::Level level)
+  append_log_level(record.level, batch);
+
+  batch.append(record.message, record.length);
+
+  if (record.truncated) {
+      batch += " [...]";
+  }
+
+  batch += "\n";
+}
+
+void SSR::Logger::append_log_level(SSR::Logger::Level level, std::string& batch)
 {
   switch (level) {
 
-    case INFO:
-      *sstream << "[INFO] ";
+    case debug:
+      batch += "[DEBUG] ";
+      break;
+
+    case info:
+      batch += "[INFO] ";
       break;
 
-    case ERROR:
-      *sstream << "[ERROR] ";
+    case error:
+      batch += "[ERROR] ";
       break;
 
     default:
-      *sstream << "[UNKNOWN LOG LEVEL] ";
+      batch += "[UNKNOWN LOG LEVEL] ";
       break;
 
   }
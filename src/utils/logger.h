@@ -14,12 +14,30 @@
  */
 
 //C++ Libs
-#include <memory>
-#include <sstream>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <ctime>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 
 //Own Libs
 #include <src/utils/helper.h>
+#include <src/utils/mpsc_ring.h>
+
+/**
+ * The lowest level which is logged (0 = debug, 1 = info, 2 = error). Messages
+ * of lower levels are dropped by Logger::log before they are queued. The
+ * level is a compile time constant, so the check itself is folded away, but
+ * the message passed to log() is still built by the caller.
+ */
+#ifndef SSR_LOG_MIN_LEVEL
+#define SSR_LOG_MIN_LEVEL 1
+#endif
 
 namespace SSR
 {
@@ -29,6 +47,13 @@ namespace SSR
    * a file or to the std::cerr. This class was design regarding the
    * singelton design pattern.
    *
+   * Logging is asynchronous: log() copies the message into a fixed-size
+   * record of a lock-free ring and returns, so it may be called from any
+   * thread including the audio and network threads. A background thread
+   * formats the records and writes them in batches. If the ring is full the
+   * record is dropped and counted, messages longer than a record are
+   * truncated and counted.
+   *
    * @since 2015-06-30
    */
   class Logger
@@ -40,10 +65,16 @@ namespace SSR
        * The log level.
        */
       enum Level {
-          INFO,
-          ERROR
+          debug,
+          info,
+          error
       };
 
+      /**
+       * The lowest level which is logged, see SSR_LOG_MIN_LEVEL.
+       */
+      static const Level min_level = static_cast<Level>(SSR_LOG_MIN_LEVEL);
+
       /**
        * Returns an instance of this class. This method was designed regarding
        * the singleton design pattern.
@@ -63,6 +94,9 @@ namespace SSR
        *
        * If log_in_file is false, the logging will be streamed to std::cerr.
        *
+       * The message is only enqueued, it is written by the background thread
+       * shortly after. Never blocks and never allocates.
+       *
        * CAUTION: This method will already add a linebreak at the end of the
        * message. So please do not append a linebreak at the end of the
        * message string!
@@ -73,18 +107,76 @@ namespace SSR
        *                              the logging message will be streamed
        *                              to std::cerr.
        */
-      void log(Logger::Level level, std::string message, bool log_in_file);
+      void log(Logger::Level level, const std::string& message, bool log_in_file)
+      {
+          if (level >= min_level) {
+              enqueue(level, message.data(), message.size(), log_in_file);
+          }
+      }
+
+      /**
+       * Like log(Level, const std::string&, bool), but without constructing
+       * a std::string from a literal.
+       */
+      void log(Logger::Level level, const char* message, bool log_in_file)
+      {
+          if (level >= min_level) {
+              enqueue(level, message, std::strlen(message), log_in_file);
+          }
+      }
+
+      /**
+       * Returns the number of records dropped because the ring was full.
+       *
+       * @return the number of dropped records.
+       */
+      unsigned long get_dropped_records() const;
+
+      /**
+       * Returns the number of messages truncated to the record size.
+       *
+       * @return the number of truncated messages.
+       */
+      unsigned long get_truncated_records() const;
 
       /**
-       * Destructor closing the logfile.
+       * Destructor writing the pending records and closing the logfile.
        */
       ~Logger();
 
   private:
 
+      /**
+       * The maximum length of a message in a record.
+       */
+      static const std::size_t max_message_length = 472;
+
+      /**
+       * The number of records the ring can hold.
+       */
+      static const std::size_t ring_capacity = 4096;
+
+      /**
+       * Time in milliseconds the background thread sleeps between batches.
+       */
+      static const int flush_interval_in_msec = 10;
+
+      /**
+       * A log message as it is handed to the background thread.
+       */
+      struct Record
+      {
+          Level level;
+          bool log_in_file;
+          bool truncated;
+          std::time_t time;
+          std::size_t length;
+          char message[max_message_length];
+      };
+
       /**
        * Constructor which transferred filename determines the filename of the
-       * logfile including its path.
+       * logfile including its path. Starts the background thread.
        *
        * The instantiated logfile will always be overwritten.
        *
@@ -109,17 +201,33 @@ namespace SSR
       Logger& operator=(const Logger& other) = delete;
 
       /**
-       * Appends the current time to the sstream object which will look as
-       * follows (mind the blank spaces):
+       * Copies the transferred message into a record and pushes it to the
+       * ring.
+       */
+      void enqueue(Level level, const char* message, std::size_t length, bool log_in_file);
+
+      /**
+       * The loop of the background thread.
+       */
+      void run();
+
+      /**
+       * Formats all records of the ring and writes them, one write per
+       * destination.
+       */
+      void write_batch();
+
+      /**
+       * Appends the formatted transferred record to the transferred batch:
        *
-       * ...[YYYY-MM-DD HH:mm:SS] ...
+       * [YYYY-MM-DD HH:mm:SS] [level] message
        */
-      void append_current_time();
+      void append_record(const Record& record, std::string& batch);
 
       /**
-       * Appends the log level to the sstream object.
+       * Appends the log level to the transferred batch.
        */
-      void append_log_level(Level level);
+      void append_log_level(Level level, std::string& batch);
 
   private:
 
@@ -129,9 +237,61 @@ namespace SSR
       std::ofstream logfile;
 
       /**
-       * The string stream object this class needs for string concatenation.
+       * The records which are not yet written.
+       */
+      SSR::Mpsc_ring<Record, ring_capacity> records;
+
+      /**
+       * Number of records dropped because the ring was full.
+       */
+      std::atomic<unsigned long> dropped_records;
+
+      /**
+       * Number of messages truncated to max_message_length.
+       */
+      std::atomic<unsigned long> truncated_records;
+
+      /**
+       * Number of dropped records already reported in the log.
+       */
+      unsigned long reported_dropped_records;
+
+      /**
+       * The record the background thread pops into.
+       */
+      Record popped_record;
+
+      /**
+       * The formatted records for the logfile, reused between batches.
+       */
+      std::string file_batch;
+
+      /**
+       * The formatted records for std::cerr, reused between batches.
+       */
+      std::string cerr_batch;
+
+      /**
+       * The last formatted time and the time it was formatted from.
+       */
+      std::time_t last_time;
+      std::string last_formatted_time;
+
+      /**
+       * True until the destructor stops the background thread.
+       */
+      bool running;
+
+      /**
+       * Guards running and wakes the background thread on shutdown.
+       */
+      std::mutex wake_mutex;
+      std::condition_variable wake;
+
+      /**
+       * The background thread.
        */
-      std::unique_ptr<std::stringstream> sstream;
+      std::thread writer;
 
   };
 
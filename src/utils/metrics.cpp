@@ -0,0 +1,148 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/metrics.h>
+
+//C++ Libs
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+
+  /**
+   * How a metric is written. Metrics with a help text start a new family
+   * (# HELP and # TYPE lines), the others belong to the family above.
+   */
+  struct Description
+  {
+    const char* name;
+    const char* family;
+    const char* type;
+    const char* help;
+    double scale;
+  };
+
+  const Description counter_descriptions[SSR::Metrics::counter_count] = {
+    {"messages_sent_total",               "messages_sent_total",      "counter", "Requests sent to the SSR.", 1.0},
+    {"bytes_sent_total",                  "bytes_sent_total",         "counter", "Bytes sent to the SSR.", 1.0},
+    {"messages_received_total",           "messages_received_total",  "counter", "Messages received from the SSR.", 1.0},
+    {"bytes_received_total",              "bytes_received_total",     "counter", "Bytes received from the SSR.", 1.0},
+    {"message_parse_seconds_sum",         "message_parse_seconds",    "summary", "Time spent parsing messages of the SSR.", 1e-6},
+    {"message_parse_seconds_count",       "message_parse_seconds",    "summary", nullptr, 1.0},
+    {"outbound_updates_total",            "outbound_updates_total",   "counter", "Changes handed to the network thread.", 1.0},
+    {"dropped_updates_total",             "dropped_updates_total",    "counter", "Changes dropped because an outbound queue was full.", 1.0},
+    {"coalesced_updates_total",           "coalesced_updates_total",  "counter", "Changes merged with another change of the same source.", 1.0},
+    {"suppressed_echoes_total",           "suppressed_echoes_total",  "counter", "Records of the SSR dropped as echoes of own requests.", 1.0},
+    {"suppressed_updates_total{reason=\"rate\"}",     "suppressed_updates_total", "counter", "Changes not sent by the send rate limiter.", 1.0},
+    {"suppressed_updates_total{reason=\"deadband\"}", "suppressed_updates_total", "counter", nullptr, 1.0},
+    {"reconnects_total",                  "reconnects_total",         "counter", "Reconnects after the connection to the SSR was lost.", 1.0},
+    {"gui_refresh_seconds_sum",           "gui_refresh_seconds",      "summary", "Time spent refreshing the editor.", 1e-6},
+    {"gui_refresh_seconds_count",         "gui_refresh_seconds",      "summary", nullptr, 1.0}
+  };
+
+  const Description gauge_descriptions[SSR::Metrics::gauge_count] = {
+    {"outbound_queue_depth",              "outbound_queue_depth",     "gauge",   "Changes waiting in the outbound queues when last drained.", 1.0},
+    {"held_updates",                      "held_updates",             "gauge",   "Stamped changes held back until the host plays them.", 1.0},
+    {"connected",                         "connected",                "gauge",   "1 if the connection to the SSR is established.", 1.0}
+  };
+
+  void append(std::string& text, const Description& description, const double value)
+  {
+    char line[256];
+
+    if (description.help != nullptr) {
+        std::snprintf(line, sizeof(line), "# HELP ssremote_%s %s\n# TYPE ssremote_%s %s\n",
+                      description.family, description.help, description.family, description.type);
+        text += line;
+    }
+
+    std::snprintf(line, sizeof(line), "ssremote_%s %.17g\n", description.name, value * description.scale);
+    text += line;
+  }
+
+}
+
+//============================================================================
+// PUBLIC
+
+SSR::Metrics& SSR::Metrics::get_instance()
+{
+  static Metrics instance;
+  return instance;
+}
+
+unsigned long long SSR::Metrics::get(const Counter counter) const
+{
+  return counters[counter].load(std::memory_order_relaxed);
+}
+
+long long SSR::Metrics::get(const Gauge gauge) const
+{
+  return gauges[gauge].load(std::memory_order_relaxed);
+}
+
+std::string SSR::Metrics::get_text() const
+{
+  std::string text;
+  text.reserve(4096);
+
+  for (int counter = 0; counter < counter_count; counter++) {
+      append(text, counter_descriptions[counter], static_cast<double>(get(static_cast<Counter>(counter))));
+  }
+
+  for (int gauge = 0; gauge < gauge_count; gauge++) {
+      append(text, gauge_descriptions[gauge], static_cast<double>(get(static_cast<Gauge>(gauge))));
+  }
+
+  return text;
+}
+
+bool SSR::Metrics::write_text_file(const std::string& path) const
+{
+  const std::string temporary_path = path + ".tmp";
+  const std::string text = get_text();
+
+  std::FILE* file = std::fopen(temporary_path.c_str(), "w");
+
+  if (file == nullptr) {
+      return false;
+  }
+
+  const bool written = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+
+  if (std::fclose(file) != 0 || !written) {
+      std::remove(temporary_path.c_str());
+      return false;
+  }
+
+  return std::rename(temporary_path.c_str(), path.c_str()) == 0;
+}
+
+unsigned long long SSR::Metrics::now_in_usec()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//============================================================================
+// PRIVATE
+
+SSR::Metrics::Metrics()
+{
+  for (std::atomic<unsigned long long>& counter : counters) {
+      counter.store(0, std::memory_order_relaxed);
+  }
+
+  for (std::atomic<long long>& gauge : gauges) {
+      gauge.store(0, std::memory_order_relaxed);
+  }
+}
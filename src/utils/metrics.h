@@ -0,0 +1,195 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <array>
+#include <atomic>
+#include <string>
+
+namespace SSR
+{
+
+  /**
+   * This class represents the runtime metrics of the control path: counters
+   * which only grow (messages, bytes, suppressed updates, ...) and gauges
+   * which hold the latest value (queue depth, ...).
+   *
+   * All metrics are atomics and the set of metrics is fixed at compile time,
+   * so counting never blocks and never allocates and may be done from any
+   * thread, including the audio thread. The instance is process wide like
+   * the Logger: with several plugin instances in one host the counters add
+   * up and the gauges show the instance which set them last.
+   *
+   * Durations are counted as a pair of counters, the sum of the durations in
+   * microseconds and the number of measurements, which get_text() writes as
+   * a Prometheus summary.
+   *
+   * @see Metrics_exporter
+   */
+  class Metrics
+  {
+
+  public:
+
+    /**
+     * The counters.
+     */
+    enum Counter {
+      messages_sent,
+      bytes_sent,
+      messages_received,
+      bytes_received,
+      parse_time_in_usec,
+      parsed_messages,
+      outbound_updates,
+      dropped_updates,
+      coalesced_updates,
+      suppressed_echoes,
+      suppressed_by_rate,
+      suppressed_by_deadband,
+      reconnects,
+      gui_refresh_time_in_usec,
+      gui_refreshes,
+      counter_count
+    };
+
+    /**
+     * The gauges.
+     */
+    enum Gauge {
+      outbound_queue_depth,
+      held_updates,
+      connected,
+      gauge_count
+    };
+
+    /**
+     * Returns the process wide instance. The instance is a static object,
+     * so the first call does not allocate either.
+     *
+     * @return the metrics.
+     */
+    static Metrics& get_instance();
+
+    /**
+     * Adds the transferred amount to the transferred counter.
+     *
+     * @param     counter         The counter.
+     *
+     * @param     amount          The amount which shall be added.
+     */
+    void add(const Counter counter, const unsigned long long amount = 1)
+    {
+      counters[counter].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * Adds a measured duration: the elapsed time since start_in_usec to the
+     * sum counter and 1 to the count counter.
+     *
+     * @param     sum             The counter of the summed durations.
+     *
+     * @param     count           The counter of the measurements.
+     *
+     * @param     start_in_usec   The start of the duration (now_in_usec()).
+     */
+    void add_duration(const Counter sum, const Counter count, const unsigned long long start_in_usec)
+    {
+      add(sum, now_in_usec() - start_in_usec);
+      add(count);
+    }
+
+    /**
+     * Sets the transferred gauge.
+     *
+     * @param     gauge           The gauge.
+     *
+     * @param     value           The new value.
+     */
+    void set(const Gauge gauge, const long long value)
+    {
+      gauges[gauge].store(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * Returns the value of the transferred counter.
+     *
+     * @param     counter         The counter.
+     *
+     * @return    the value of the counter.
+     */
+    unsigned long long get(const Counter counter) const;
+
+    /**
+     * Returns the value of the transferred gauge.
+     *
+     * @param     gauge           The gauge.
+     *
+     * @return    the value of the gauge.
+     */
+    long long get(const Gauge gauge) const;
+
+    /**
+     * Returns all metrics in the Prometheus text exposition format, with the
+     * prefix "ssremote_".
+     *
+     * @return the metrics as text.
+     */
+    std::string get_text() const;
+
+    /**
+     * Writes get_text() to the transferred file. The text is written to a
+     * temporary file next to it which is then renamed, so a collector
+     * reading the file never sees half of it.
+     *
+     * @param     path            The path of the file.
+     *
+     * @return    true if the file was written.
+     */
+    bool write_text_file(const std::string& path) const;
+
+    /**
+     * Returns a monotonic time in microseconds to measure durations with.
+     *
+     * @return the current time in microseconds.
+     */
+    static unsigned long long now_in_usec();
+
+  private:
+
+    /**
+     * Constructor setting all metrics to 0.
+     */
+    Metrics();
+
+    /**
+     * Copy constructor which is deleted (explicitly not implemented).
+     */
+    Metrics(const Metrics& other) = delete;
+
+    /**
+     * Assignment operator which is deleted (explicitly not implemented).
+     */
+    Metrics& operator=(const Metrics& other) = delete;
+
+    std::array<std::atomic<unsigned long long>, counter_count> counters;
+
+    std::array<std::atomic<long long>, gauge_count> gauges;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,67 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/metrics_exporter.h>
+
+//C++ Libs
+#include <algorithm>
+
+//Own Libs
+#include <src/utils/metrics.h>
+#include <src/utils/logger.h>
+
+//============================================================================
+// PUBLIC
+
+SSR::Metrics_exporter::Metrics_exporter()
+: juce::Thread("SSR Metrics")
+, path()
+, interval_in_msec(10000)
+{
+
+}
+
+SSR::Metrics_exporter::~Metrics_exporter()
+{
+  stopThread(2000);
+}
+
+void SSR::Metrics_exporter::configure(const std::string& new_path, const unsigned int new_interval_in_sec)
+{
+  stopThread(2000);
+
+  path = new_path;
+  interval_in_msec = static_cast<int>(std::max(new_interval_in_sec, 1u) * 1000);
+
+  if (!path.empty()) {
+      startThread(1);
+  }
+}
+
+void SSR::Metrics_exporter::run()
+{
+  bool failed = false;
+
+  while (!threadShouldExit()) {
+
+      wait(interval_in_msec);
+
+      // Only the first of a series of failures is logged.
+      const bool written = SSR::Metrics::get_instance().write_text_file(path);
+
+      if (!written && !failed) {
+          SSR::Logger::get_instance()->log(SSR::Logger::Level::error, "Could not write the metrics to " + path, true);
+      }
+
+      failed = !written;
+  }
+}
@@ -0,0 +1,80 @@
+#ifndef METRICS_EXPORTER_H
+#define METRICS_EXPORTER_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <string>
+
+//JUCE Lib
+#include <JUCE/JuceHeader.h>
+
+namespace SSR
+{
+
+  /**
+   * This class writes the Metrics to a file in the Prometheus text format at
+   * a fixed interval, e.g. for the textfile collector of the node exporter,
+   * so the numbers can be watched during a long show without opening the
+   * editor. The file is written once more when the thread stops.
+   */
+  class Metrics_exporter : public juce::Thread
+  {
+
+  public:
+
+    /**
+     * Constructor.
+     */
+    Metrics_exporter();
+
+    /**
+     * Destructor stopping the thread.
+     */
+    ~Metrics_exporter();
+
+    /**
+     * Stops the export, sets the file and the interval and restarts it.
+     * Nothing is exported if the path is empty.
+     *
+     * Must not be called from the thread itself.
+     *
+     * @param     new_path        The file the metrics are written to.
+     *
+     * @param     new_interval_in_sec   The time between two exports in
+     *                            seconds, at least 1.
+     */
+    void configure(const std::string& new_path, const unsigned int new_interval_in_sec);
+
+    /**
+     * Writes the file every interval until the thread is signalled to exit.
+     */
+    void run() override;
+
+  private:
+
+    /**
+     * The file the metrics are written to, empty if the export is off.
+     */
+    std::string path;
+
+    /**
+     * The time between two exports in milliseconds.
+     */
+    int interval_in_msec;
+
+  };
+
+}
+
+#endif
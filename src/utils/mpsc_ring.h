@@ -0,0 +1,164 @@
+#ifndef MPSC_RING_H
+#define MPSC_RING_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace SSR
+{
+
+  /**
+   * A bounded, lock-free multi producer / single consumer ring.
+   *
+   * Every cell carries a sequence number which tells producers whether the
+   * cell is free and the consumer whether it is filled, so producers only
+   * compete for the tail index (one compare-and-swap) and never wait for
+   * each other. All cells are allocated once on construction.
+   *
+   * Any number of threads may push, exactly one thread may pop.
+   *
+   * @param     T               The element type.
+   *
+   * @param     Capacity        The maximum number of elements, has to be a
+   *                            power of two.
+   */
+  template <typename T, std::size_t Capacity>
+  class Mpsc_ring
+  {
+
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity has to be a power of two.");
+
+  public:
+
+    /**
+     * Constructor allocating all cells of the ring.
+     */
+    Mpsc_ring()
+    : cells(new Cell[Capacity])
+    , head(0)
+    , tail(0)
+    {
+      for (std::size_t i = 0; i < Capacity; i++) {
+          cells[i].sequence.store(i, std::memory_order_relaxed);
+      }
+    }
+
+    /**
+     * Copies the transferred item into the ring.
+     *
+     * May be called by any thread.
+     *
+     * @param     item            The item which shall be enqueued.
+     *
+     * @return    true if the item was enqueued, false if the ring is full.
+     */
+    bool try_push(const T& item)
+    {
+      std::size_t position = tail.load(std::memory_order_relaxed);
+      Cell* cell = nullptr;
+
+      for (;;) {
+
+          cell = &cells[position & (Capacity - 1)];
+
+          const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+          const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+          if (difference == 0) {
+
+              if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                  break;
+              }
+
+          } else if (difference < 0) {
+              return false;
+          } else {
+              position = tail.load(std::memory_order_relaxed);
+          }
+
+      }
+
+      cell->item = item;
+      cell->sequence.store(position + 1, std::memory_order_release);
+
+      return true;
+    }
+
+    /**
+     * Moves the oldest element of the ring into the transferred item.
+     *
+     * Must only be called by the consumer thread.
+     *
+     * @param     item            The item the oldest element shall be moved
+     *                            to.
+     *
+     * @return    true if an element was dequeued, false if the ring is empty
+     *            (or the oldest element is not completely written yet).
+     */
+    bool try_pop(T& item)
+    {
+      const std::size_t position = head.load(std::memory_order_relaxed);
+      Cell& cell = cells[position & (Capacity - 1)];
+
+      if (cell.sequence.load(std::memory_order_acquire) != position + 1) {
+          return false;
+      }
+
+      item = std::move(cell.item);
+      cell.sequence.store(position + Capacity, std::memory_order_release);
+      head.store(position + 1, std::memory_order_relaxed);
+
+      return true;
+    }
+
+  private:
+
+    /**
+     * A cell of the ring.
+     */
+    struct Cell
+    {
+      std::atomic<std::size_t> sequence;
+      T item;
+    };
+
+    /**
+     * The ring of cells.
+     */
+    std::unique_ptr<Cell[]> cells;
+
+    /**
+     * Index of the next element to pop, only touched by the consumer.
+     */
+    std::atomic<std::size_t> head;
+
+    /**
+     * Keeps head and tail on different cache lines.
+     */
+    char padding[64];
+
+    /**
+     * Index of the next cell to fill, shared by all producers.
+     */
+    std::atomic<std::size_t> tail;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,598 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/network_thread.h>
+
+//C++ Libs
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <memory>
+#include <utility>
+
+//Own Libs
+#include <src/utils/logger.h>
+#include <src/utils/metrics.h>
+
+//JUCE Lib
+#include <JUCE/JuceHeader.h>
+
+// Bound to const references by std::min, so they need a definition.
+const int SSR::Network_thread::min_backoff_in_msec;
+const int SSR::Network_thread::max_backoff_in_msec;
+
+//============================================================================
+// PUBLIC
+
+SSR::Network_thread::Network_thread()
+: juce::Thread("SSR Network")
+, connection(nullptr)
+, coalescer()
+, scheduler()
+, last_flush_in_msec(0)
+, inbound_coalescer()
+, inbound_lock()
+, outgoing_message(new std::string(""))
+, state(SSR::Connection_state::disconnected)
+, sync_start_in_msec(0)
+, sync_message_received(false)
+, inbound_parser()
+, inbound_updates()
+, remote_sources()
+, latency_probe()
+, echo_filter(&latency_probe)
+, random()
+, reconnects(0)
+, dropped_updates(0)
+, collapsed_updates(0)
+, coalesced_updates(0)
+, suppressed_echoes(0)
+, round_trip_in_msec(0.0)
+, late_updates(0)
+{
+  outgoing_message->reserve(request_capacity);
+}
+
+SSR::Network_thread::~Network_thread()
+{
+  stopThread(1000);
+
+  if (connection) {
+      connection->disconnect();
+  }
+}
+
+void SSR::Network_thread::set_connection(std::unique_ptr<SSR::IConnection> new_connection)
+{
+  stopThread(1000);
+
+  if (connection) {
+      connection->disconnect();
+  }
+
+  state = SSR::Connection_state::disconnected;
+  connection = std::move(new_connection);
+
+  startThread();
+}
+
+bool SSR::Network_thread::push_update(Outbound_update update)
+{
+  juce::MessageManager* message_manager = juce::MessageManager::getInstanceWithoutCreating();
+
+  update.queued_in_msec = juce::Time::getMillisecondCounterHiRes();
+
+  bool pushed = false;
+
+  if (message_manager != nullptr && message_manager->isThisTheMessageThread()) {
+      pushed = editor_queue.try_push(update);
+  } else {
+      pushed = automation_queue.try_push(update);
+  }
+
+  if (!pushed) {
+      dropped_updates++;
+      SSR::Metrics::get_instance().add(SSR::Metrics::dropped_updates);
+  }
+
+  return pushed;
+}
+
+bool SSR::Network_thread::push_audio_update(Outbound_update update)
+{
+  update.queued_in_msec = juce::Time::getMillisecondCounterHiRes();
+
+  const bool pushed = audio_queue.try_push(update);
+
+  if (!pushed) {
+      dropped_updates++;
+      SSR::Metrics::get_instance().add(SSR::Metrics::dropped_updates);
+  }
+
+  return pushed;
+}
+
+bool SSR::Network_thread::take_updates(SSR::Inbound_coalescer& updates)
+{
+  updates.clear();
+
+  const juce::ScopedLock scoped_lock(inbound_lock);
+
+  if (inbound_coalescer.empty()) {
+      return false;
+  }
+
+  collapsed_updates += inbound_coalescer.get_collapsed_updates();
+  inbound_coalescer.swap(updates);
+
+  return true;
+}
+
+bool SSR::Network_thread::is_connected() const
+{
+  const SSR::Connection_state current_state = state;
+  return current_state == SSR::Connection_state::syncing || current_state == SSR::Connection_state::live;
+}
+
+SSR::Connection_state SSR::Network_thread::get_state() const
+{
+  return state;
+}
+
+unsigned long SSR::Network_thread::get_dropped_updates() const
+{
+  return dropped_updates;
+}
+
+unsigned long SSR::Network_thread::get_collapsed_updates() const
+{
+  return collapsed_updates;
+}
+
+unsigned long SSR::Network_thread::get_coalesced_updates() const
+{
+  return coalesced_updates;
+}
+
+unsigned long SSR::Network_thread::get_reconnects() const
+{
+  return reconnects;
+}
+
+unsigned long SSR::Network_thread::get_suppressed_echoes() const
+{
+  return suppressed_echoes;
+}
+
+double SSR::Network_thread::get_round_trip_in_msec() const
+{
+  return round_trip_in_msec;
+}
+
+unsigned long SSR::Network_thread::get_late_updates() const
+{
+  return late_updates;
+}
+
+const SSR::Latency_probe& SSR::Network_thread::get_latency_probe() const
+{
+  return latency_probe;
+}
+
+void SSR::Network_thread::run()
+{
+  if (!connection) {
+      return;
+  }
+
+  SSR::Metrics& metrics = SSR::Metrics::get_instance();
+
+  unsigned int failed_attempts = 0;
+  bool was_connected = false;
+
+  while (!threadShouldExit()) {
+
+      if (!connection->is_connected()) {
+
+          if (state == SSR::Connection_state::syncing || state == SSR::Connection_state::live) {
+              SSR::Logger::get_instance()->log(SSR::Logger::Level::error, "Connection to the SSR lost, reconnecting", true);
+              state = SSR::Connection_state::disconnected;
+              metrics.set(SSR::Metrics::connected, 0);
+          }
+
+          // Changes made while offline are kept in the coalescer.
+          collect_updates(editor_queue);
+          collect_updates(automation_queue);
+          collect_updates(audio_queue);
+          scheduler.release_all(coalescer);
+
+          if (failed_attempts > 0 && wait(backoff_in_msec(failed_attempts))) {
+              continue;
+          }
+
+          if (threadShouldExit()) {
+              break;
+          }
+
+          if (!establish_connection()) {
+
+              if (failed_attempts == 0) {
+                  SSR::Logger::get_instance()->log(SSR::Logger::Level::error, "Could not connect to the SSR", true);
+              }
+
+              failed_attempts++;
+              continue;
+          }
+
+          if (was_connected) {
+              reconnects++;
+              metrics.add(SSR::Metrics::reconnects);
+          }
+
+          metrics.set(SSR::Metrics::connected, 1);
+
+          was_connected = true;
+          failed_attempts = 0;
+      }
+
+      const std::size_t queue_depth = collect_updates(editor_queue) + collect_updates(automation_queue) + collect_updates(audio_queue);
+      metrics.set(SSR::Metrics::outbound_queue_depth, static_cast<long long>(queue_depth));
+
+      const double lead_in_msec = echo_filter.get_round_trip_in_msec() / 2.0;
+      const bool released = scheduler.release(juce::Time::getMillisecondCounterHiRes(), lead_in_msec, coalescer) > 0;
+
+      if (state == SSR::Connection_state::live) {
+          flush_updates(released);
+      }
+
+      read_messages();
+
+      round_trip_in_msec = echo_filter.get_round_trip_in_msec();
+      late_updates = scheduler.get_late_updates();
+      metrics.set(SSR::Metrics::held_updates, static_cast<long long>(scheduler.get_held_updates()));
+  }
+}
+
+//============================================================================
+// PRIVATE
+
+template <typename Queue>
+std::size_t SSR::Network_thread::collect_updates(Queue& queue)
+{
+  Outbound_update update;
+  std::size_t count = 0;
+
+  while (queue.try_pop(update)) {
+
+      if (!scheduler.hold(update)) {
+          coalescer.add(update);
+      }
+
+      count++;
+  }
+
+  return count;
+}
+
+void SSR::Network_thread::flush_updates(const bool released)
+{
+  const juce::uint32 now_in_msec = juce::Time::getMillisecondCounter();
+
+  if (!released && now_in_msec - last_flush_in_msec < flush_interval_in_msec) {
+      return;
+  }
+
+  if (!coalescer.has_pending()) {
+      return;
+  }
+
+  const double sent_in_msec = juce::Time::getMillisecondCounterHiRes();
+
+  coalescer.for_each_pending([this, sent_in_msec](const SSR::Outbound_update& update) {
+
+    echo_filter.sent(update, sent_in_msec);
+
+    if (update.queued_in_msec > 0.0) {
+        latency_probe.record_plugin((sent_in_msec - update.queued_in_msec) * 1000.0);
+    }
+
+  });
+
+  if (coalescer.flush(requester, *outgoing_message)) {
+      connection->send_message(outgoing_message, send_timeout_in_msec);
+      last_flush_in_msec = now_in_msec;
+
+      const unsigned long coalesced_total = coalescer.get_added_updates() - coalescer.get_flushed_elements();
+      SSR::Metrics::get_instance().add(SSR::Metrics::coalesced_updates, coalesced_total - coalesced_updates);
+      coalesced_updates = coalesced_total;
+
+      const double transport_round_trip_in_msec = connection->get_transport_round_trip_in_msec();
+
+      if (transport_round_trip_in_msec >= 0.0) {
+          latency_probe.record_network(transport_round_trip_in_msec * 1000.0);
+      }
+  }
+}
+
+void SSR::Network_thread::read_messages()
+{
+  int wait_in_msec = poll_interval_in_msec;
+  int message_count = 0;
+  SSR::Frame frame;
+
+  // Bounded, so steady traffic from the SSR cannot keep the thread from
+  // flushing.
+  while (message_count < max_messages_per_read && connection->get_frame(frame, &wait_in_msec)) {
+
+      receive_message(frame);
+
+      message_count++;
+      wait_in_msec = 0;
+  }
+
+  if (state != SSR::Connection_state::syncing) {
+      return;
+  }
+
+  const bool message_received = message_count > 0;
+  const bool timed_out = juce::Time::getMillisecondCounter() - sync_start_in_msec > sync_timeout_in_msec;
+
+  if (message_received) {
+      sync_message_received = true;
+  }
+
+  // The SSR sends its scene right after the connection is established. The
+  // sync is done once that burst is read and a poll stays quiet, or after
+  // the timeout if the SSR never stops sending (other clients, levels).
+  if ((sync_message_received && !message_received) || timed_out) {
+
+      discard_changes_in_sync();
+
+      // Without any message from the SSR there is no scene to compare with.
+      if (sync_message_received) {
+          finish_sync();
+      }
+
+      state = SSR::Connection_state::live;
+  }
+}
+
+bool SSR::Network_thread::establish_connection()
+{
+  state = SSR::Connection_state::connecting;
+
+  connection->disconnect();
+
+  if (!connection->connect()) {
+      state = SSR::Connection_state::disconnected;
+      return false;
+  }
+
+  sync_start_in_msec = juce::Time::getMillisecondCounter();
+  sync_message_received = false;
+  remote_sources.clear();
+  echo_filter.clear();
+  state = SSR::Connection_state::syncing;
+
+  return true;
+}
+
+int SSR::Network_thread::backoff_in_msec(const unsigned int attempt)
+{
+  const unsigned int exponent = std::min(attempt - 1, 5u);
+  const int backoff = std::min(min_backoff_in_msec << exponent, max_backoff_in_msec);
+
+  // Half of the backoff is fixed, the other half is random.
+  return backoff / 2 + random.nextInt(backoff / 2 + 1);
+}
+
+void SSR::Network_thread::receive_message(const SSR::Frame& message)
+{
+  inbound_updates.clear();
+
+  SSR::Metrics& metrics = SSR::Metrics::get_instance();
+  const unsigned long long start_in_usec = SSR::Metrics::now_in_usec();
+
+  // Records parsed before an error are still applied, as the scene always
+  // did, but only well formed messages count for the sync.
+  const bool well_formed = inbound_parser.parse(message.data, message.size, inbound_updates);
+
+  metrics.add_duration(SSR::Metrics::parse_time_in_usec, SSR::Metrics::parsed_messages, start_in_usec);
+
+  const bool syncing = state == SSR::Connection_state::syncing;
+
+  if (syncing && well_formed) {
+      merge_remote_sources(inbound_updates);
+  }
+
+  const double now_in_msec = juce::Time::getMillisecondCounterHiRes();
+  unsigned long echoes = 0;
+
+  const juce::ScopedLock scoped_lock(inbound_lock);
+
+  for (SSR::Source_update& update : inbound_updates) {
+
+      if (syncing && !keep_pending_changes(update)) {
+          continue;
+      }
+
+      if (!echo_filter.filter(update, now_in_msec)) {
+          echoes++;
+          continue;
+      }
+
+      inbound_coalescer.add(update, message.data);
+  }
+
+  suppressed_echoes += echoes;
+  metrics.add(SSR::Metrics::suppressed_echoes, echoes);
+}
+
+void SSR::Network_thread::merge_remote_sources(const std::vector<SSR::Source_update>& updates)
+{
+  for (const SSR::Source_update& update : updates) {
+
+      if (update.deleted) {
+          remote_sources.erase(update.id);
+          continue;
+      }
+
+      SSR::Source_update& remote = remote_sources[update.id];
+      remote.id = update.id;
+
+      if (update.has(SSR::Source_update::x_position)) {
+          remote.x = update.x;
+          remote.set(SSR::Source_update::x_position);
+      }
+
+      if (update.has(SSR::Source_update::y_position)) {
+          remote.y = update.y;
+          remote.set(SSR::Source_update::y_position);
+      }
+
+      if (update.has(SSR::Source_update::volume)) {
+          remote.volume_in_db = update.volume_in_db;
+          remote.set(SSR::Source_update::volume);
+      }
+
+      if (update.has(SSR::Source_update::mute)) {
+          remote.is_muted = update.is_muted;
+          remote.set(SSR::Source_update::mute);
+      }
+
+      if (update.has(SSR::Source_update::fixed)) {
+          remote.is_fixed = update.is_fixed;
+          remote.set(SSR::Source_update::fixed);
+      }
+
+      if (update.has(SSR::Source_update::model)) {
+          remote.model_point = update.model_point;
+          remote.set(SSR::Source_update::model);
+      }
+
+  }
+}
+
+bool SSR::Network_thread::keep_pending_changes(SSR::Source_update& update) const
+{
+  typedef SSR::Update_specificator::Specificators specificators;
+
+  if (update.deleted) {
+      return true;
+  }
+
+  const SSR::Update_specificator pending = coalescer.get_pending(update.id);
+
+  if (pending.empty()) {
+      return true;
+  }
+
+  if (pending.contains(specificators::position)) {
+      update.clear(SSR::Source_update::x_position);
+      update.clear(SSR::Source_update::y_position);
+  }
+
+  if (pending.contains(specificators::gain)) {
+      update.clear(SSR::Source_update::volume);
+  }
+
+  if (pending.contains(specificators::mute)) {
+      update.clear(SSR::Source_update::mute);
+  }
+
+  if (pending.contains(specificators::fixed)) {
+      update.clear(SSR::Source_update::fixed);
+  }
+
+  if (pending.contains(specificators::model)) {
+      update.clear(SSR::Source_update::model);
+  }
+
+  if (pending.contains(specificators::name)) {
+      update.clear(SSR::Source_update::name);
+  }
+
+  if (pending.contains(specificators::port)) {
+      update.clear(SSR::Source_update::port);
+  }
+
+  if (pending.contains(specificators::properties_file)) {
+      update.clear(SSR::Source_update::properties_file);
+  }
+
+  return update.fields != 0;
+}
+
+void SSR::Network_thread::finish_sync()
+{
+  std::vector<unsigned int> source_ids;
+  source_ids.reserve(remote_sources.size());
+
+  for (const std::pair<const unsigned int, SSR::Source_update>& remote : remote_sources) {
+      source_ids.push_back(remote.first);
+  }
+
+  const juce::ScopedLock scoped_lock(inbound_lock);
+  inbound_coalescer.finish_sync(source_ids);
+}
+
+void SSR::Network_thread::discard_changes_in_sync()
+{
+  typedef SSR::Update_specificator::Specificators specificators;
+
+  if (!coalescer.has_pending()) {
+      return;
+  }
+
+  const float tolerance = 0.0001f;
+
+  const std::size_t discarded = coalescer.discard_in_sync([this, tolerance](const SSR::Outbound_update& update) {
+
+    SSR::Update_specificator in_sync;
+
+    auto found = remote_sources.find(update.source_id);
+
+    if (found == remote_sources.end()) {
+        return in_sync;
+    }
+
+    const SSR::Source_update& remote = found->second;
+
+    if (remote.has(SSR::Source_update::x_position) && remote.has(SSR::Source_update::y_position)
+        && std::abs(remote.x - update.x_position) < tolerance && std::abs(remote.y - update.y_position) < tolerance) {
+        in_sync.add(specificators::position);
+    }
+
+    if (remote.has(SSR::Source_update::volume) && std::abs(remote.volume_in_db - update.gain_in_db) < tolerance) {
+        in_sync.add(specificators::gain);
+    }
+
+    if (remote.has(SSR::Source_update::mute) && remote.is_muted == update.mute) {
+        in_sync.add(specificators::mute);
+    }
+
+    if (remote.has(SSR::Source_update::fixed) && remote.is_fixed == update.fixed) {
+        in_sync.add(specificators::fixed);
+    }
+
+    if (remote.has(SSR::Source_update::model) && remote.model_point == update.model_point) {
+        in_sync.add(specificators::model);
+    }
+
+    return in_sync;
+  });
+
+  std::stringstream summary;
+  summary << "Resynchronised with the SSR, " << discarded << " offline changes were already applied";
+  SSR::Logger::get_instance()->log(SSR::Logger::Level::info, summary.str(), true);
+}
@@ -0,0 +1,531 @@
+#ifndef NETWORK_THREAD_H
+#define NETWORK_THREAD_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//Own Libs
+#include <src/utils/iconnection.h>
+#include <src/utils/spsc_queue.h>
+#include <src/utils/mpsc_ring.h>
+#include <src/utils/connection_state.h>
+#include <src/utils/outbound_update.h>
+#include <src/utils/ssr_requester.h>
+#include <src/utils/update_coalescer.h>
+#include <src/utils/release_scheduler.h>
+#include <src/utils/echo_filter.h>
+#include <src/utils/latency_probe.h>
+#include <src/utils/inbound_coalescer.h>
+#include <src/scene/update_parser.h>
+
+//JUCE Lib
+#include <JUCE/JuceHeader.h>
+
+namespace SSR
+{
+
+  /**
+   * This class represents the network worker thread which exclusively owns the
+   * connection to the SSR.
+   *
+   * Outbound updates are handed over through lock-free queues: a single
+   * producer queue fed by the message thread (the editor), one fed by the
+   * audio thread (trajectories) and a multi producer queue shared by all
+   * other threads, since hosts may call setParameter from several threads.
+   * Therefore neither the host nor the audio thread ever blocks on the socket
+   * or allocates a message string.
+   *
+   * Incoming messages are parsed by this thread and merged by an
+   * Inbound_coalescer, which the message thread takes over once per tick.
+   * However many messages the SSR sends, the message thread applies at most
+   * one record per source per tick and never falls behind.
+   *
+   * Outbound updates are merged by an Update_coalescer and flushed as one
+   * request at most once per flush interval. Updates stamped with the
+   * position of the host (see Host_clock) are held back by a
+   * Release_scheduler until the audio they belong to plays, minus half the
+   * round trip to the SSR, and flushed right when they are released.
+   *
+   * If the connection drops, the thread reconnects on its own with an
+   * exponential backoff plus jitter. Changes made while offline stay in the
+   * coalescer. After reconnecting, the scene the SSR sends is compared with
+   * them and only the changes the SSR does not already have are sent. Local
+   * sources the SSR does not have are dropped once the sync is done, and the
+   * fields changed offline keep their local value instead of the one in the
+   * scene the SSR sends.
+   *
+   * The SSR echoes every request back to all clients. Fields which only
+   * echo values this thread sent (see Echo_filter) are dropped before they
+   * are merged, so the message thread neither applies them nor repaints the
+   * GUI for them.
+   *
+   * Along the way the thread measures where the time goes (see
+   * Latency_probe): how long changes wait before they are sent, the round
+   * trip of the transport and the round trip until the SSR echoes them.
+   */
+  class Network_thread : public juce::Thread
+  {
+
+  public:
+
+    /**
+     * Queue type carrying outbound updates to the network thread.
+     */
+    typedef Spsc_queue<Outbound_update, 512> Outbound_queue;
+
+    /**
+     * Queue type carrying outbound updates of any number of threads to the
+     * network thread.
+     */
+    typedef Mpsc_ring<Outbound_update, 512> Shared_outbound_queue;
+
+    /**
+     * Constructor.
+     */
+    Network_thread();
+
+    /**
+     * Destructor stopping the thread and closing the connection.
+     */
+    ~Network_thread();
+
+    /**
+     * Stops the thread, replaces the current connection by the transferred
+     * one and restarts the thread which will then connect to the SSR.
+     *
+     * Must be called from the message thread.
+     *
+     * @param     new_connection  The connection which shall be used from now
+     *                            on.
+     */
+    void set_connection(std::unique_ptr<SSR::IConnection> new_connection);
+
+    /**
+     * Enqueues the transferred update for sending. The queue is chosen by the
+     * calling thread: the message thread uses the editor queue, every other
+     * thread the automation queue, which may be fed by several threads at
+     * once. The update is stamped with the time it
+     * was enqueued.
+     *
+     * Never blocks and never allocates.
+     *
+     * @param     update          The update which shall be sent to the SSR.
+     *
+     * @return    true if the update was enqueued, false if the queue was full
+     *            and the update was dropped.
+     */
+    bool push_update(Outbound_update update);
+
+    /**
+     * Enqueues the transferred update for sending on the audio queue, which
+     * is reserved for the audio thread (Controller::processBlock), so host
+     * automation and audio callbacks on different threads never share a
+     * queue.
+     *
+     * Never blocks and never allocates.
+     *
+     * @param     update          The update which shall be sent to the SSR.
+     *
+     * @return    true if the update was enqueued, false if the queue was full
+     *            and the update was dropped.
+     */
+    bool push_audio_update(Outbound_update update);
+
+    /**
+     * Takes over the records received from the SSR since the last call,
+     * merged per source. The transferred coalescer is cleared first and
+     * exchanged with the one of this thread, so neither side allocates once
+     * both have grown.
+     *
+     * Must only be called from the message thread.
+     *
+     * @param     updates         The coalescer the records shall be moved
+     *                            to.
+     *
+     * @return    true if there were records, false otherwise.
+     */
+    bool take_updates(SSR::Inbound_coalescer& updates);
+
+    /**
+     * Returns true if the connection to the SSR is established (syncing or
+     * live).
+     *
+     * @return true if the connection to the SSR is established.
+     */
+    bool is_connected() const;
+
+    /**
+     * Returns the state of the connection to the SSR.
+     *
+     * @return the connection state.
+     */
+    SSR::Connection_state get_state() const;
+
+    /**
+     * Returns the number of outbound updates dropped because a queue was full.
+     *
+     * @return the number of dropped outbound updates.
+     */
+    unsigned long get_dropped_updates() const;
+
+    /**
+     * Returns the number of incoming records which were merged with a newer
+     * one of the same source before the message thread applied them.
+     *
+     * @return the number of collapsed incoming records.
+     */
+    unsigned long get_collapsed_updates() const;
+
+    /**
+     * Returns the number of outbound updates merged by the coalescer.
+     *
+     * @return the number of outbound updates merged by the coalescer.
+     */
+    unsigned long get_coalesced_updates() const;
+
+    /**
+     * Returns the number of reconnects after the connection was lost.
+     *
+     * @return the number of reconnects.
+     */
+    unsigned long get_reconnects() const;
+
+    /**
+     * Returns the number of incoming records dropped because they only
+     * echoed values sent by this plugin.
+     *
+     * @return the number of suppressed echo records.
+     */
+    unsigned long get_suppressed_echoes() const;
+
+    /**
+     * Returns the smoothed round trip time to the SSR.
+     *
+     * @return the round trip time in milliseconds, 0 until it was measured.
+     */
+    double get_round_trip_in_msec() const;
+
+    /**
+     * Returns the number of stamped updates which reached the network thread
+     * too late to be released on time.
+     *
+     * @return the number of late updates.
+     */
+    unsigned long get_late_updates() const;
+
+    /**
+     * Returns the latency histograms of this thread. They are recorded by
+     * this thread and may be read from any thread.
+     *
+     * @return the latency probe.
+     */
+    const SSR::Latency_probe& get_latency_probe() const;
+
+    /**
+     * The thread loop: connects, sends the enqueued updates and reads incoming
+     * messages until the thread is signalled to exit.
+     */
+    void run() override;
+
+  private:
+
+    /**
+     * Moves all updates of the transferred queue into the coalescer, or into
+     * the scheduler if they are stamped.
+     *
+     * @param     queue           The queue which shall be drained, an
+     *                            Outbound_queue or a Shared_outbound_queue.
+     *
+     * @return    the number of updates which were in the queue.
+     */
+    template <typename Queue>
+    std::size_t collect_updates(Queue& queue);
+
+    /**
+     * Sends the pending changes of the coalescer as one request if the flush
+     * interval has elapsed since the last request was sent.
+     *
+     * @param     released        True if the scheduler just released
+     *                            updates, which are sent regardless of the
+     *                            flush interval.
+     */
+    void flush_updates(const bool released);
+
+    /**
+     * Reads the messages the SSR has sent, at most max_messages_per_read
+     * per call, and hands them to receive_message. While
+     * syncing, the state changes to live once the scene is read and a poll
+     * stays quiet, or once sync_timeout_in_msec has passed.
+     */
+    void read_messages();
+
+    /**
+     * Parses the transferred message of the SSR, removes the echoes of values
+     * in flight and merges the remaining records for the message thread.
+     * While syncing, the records are also merged into remote_sources.
+     *
+     * @param     message         The message of the SSR, a view into the
+     *                            receive buffer of the connection.
+     */
+    void receive_message(const SSR::Frame& message);
+
+    /**
+     * Connects the connection and resets the sync state.
+     *
+     * @return    true if the connection is established.
+     */
+    bool establish_connection();
+
+    /**
+     * Returns the time in milliseconds to wait before the transferred
+     * reconnect attempt: exponential backoff with jitter.
+     *
+     * @param     attempt         The number of failed attempts so far.
+     *
+     * @return    the time to wait in milliseconds.
+     */
+    int backoff_in_msec(const unsigned int attempt);
+
+    /**
+     * Merges the transferred records into remote_sources.
+     *
+     * @param     updates         The records parsed from a message of the
+     *                            SSR.
+     */
+    void merge_remote_sources(const std::vector<SSR::Source_update>& updates);
+
+    /**
+     * Removes the fields from the transferred record which have a pending
+     * local change in the coalescer. While syncing, the scene the SSR sends
+     * is older than the changes made offline, which are sent right after
+     * the sync and whose echoes the Echo_filter drops. Without this, the
+     * local scene would keep the values of the SSR.
+     *
+     * @param     update          The record received from the SSR.
+     *
+     * @return    true if the record still carries anything to apply.
+     */
+    bool keep_pending_changes(SSR::Source_update& update) const;
+
+    /**
+     * Drops the offline changes the SSR already has (according to
+     * remote_sources) from the coalescer, called when the sync is done.
+     */
+    void discard_changes_in_sync();
+
+    /**
+     * Hands the ids of all sources in remote_sources to the message thread,
+     * which then drops the local sources the SSR does not have. Called when
+     * the sync is done.
+     */
+    void finish_sync();
+
+  private:
+
+    /**
+     * Time in milliseconds the thread waits for incoming messages per loop.
+     */
+    static const int poll_interval_in_msec = 2;
+
+    /**
+     * Time in milliseconds the thread waits for the socket to become
+     * writable.
+     */
+    static const int send_timeout_in_msec = 100;
+
+    /**
+     * Minimum time in milliseconds between two flushed requests.
+     */
+    static const unsigned int flush_interval_in_msec = 10;
+
+    /**
+     * Time in milliseconds after which the connection is considered live
+     * even if the SSR did not send its scene or never stopped sending.
+     */
+    static const unsigned int sync_timeout_in_msec = 1000;
+
+    /**
+     * Maximum number of messages read per loop.
+     */
+    static const int max_messages_per_read = 256;
+
+    /**
+     * Time in milliseconds before the first reconnect attempt, doubled with
+     * every failed attempt.
+     */
+    static const int min_backoff_in_msec = 250;
+
+    /**
+     * Maximum time in milliseconds between two reconnect attempts.
+     */
+    static const int max_backoff_in_msec = 8000;
+
+    /**
+     * Initial capacity of the outgoing request in bytes, enough for a flush
+     * of 64 sources so encoding does not allocate.
+     */
+    static const std::size_t request_capacity = 16384;
+
+    /**
+     * The connection to the SSR, only touched by this thread while running.
+     */
+    std::unique_ptr<SSR::IConnection> connection;
+
+    /**
+     * Builds the XML requests, only used by this thread.
+     */
+    SSR::SSR_requester requester;
+
+    /**
+     * Merges the outbound updates between two flushes.
+     */
+    SSR::Update_coalescer coalescer;
+
+    /**
+     * Holds the stamped updates back until they are due.
+     */
+    SSR::Release_scheduler scheduler;
+
+    /**
+     * Time in milliseconds (juce::Time::getMillisecondCounter) when the last
+     * request was flushed.
+     */
+    juce::uint32 last_flush_in_msec;
+
+    /**
+     * Updates coming from the message thread.
+     */
+    Outbound_queue editor_queue;
+
+    /**
+     * Updates coming from the host, possibly from several threads at once.
+     */
+    Shared_outbound_queue automation_queue;
+
+    /**
+     * Updates coming from the audio thread.
+     */
+    Outbound_queue audio_queue;
+
+    /**
+     * The records received from the SSR which the message thread has not
+     * taken yet, guarded by inbound_lock.
+     */
+    SSR::Inbound_coalescer inbound_coalescer;
+
+    /**
+     * Guards inbound_coalescer, held only while merging or swapping.
+     */
+    juce::CriticalSection inbound_lock;
+
+    /**
+     * The message which is currently sent.
+     */
+    std::shared_ptr<std::string> outgoing_message;
+
+    /**
+     * The state of the connection.
+     */
+    std::atomic<SSR::Connection_state> state;
+
+    /**
+     * Time in milliseconds (juce::Time::getMillisecondCounter) when the
+     * state changed to syncing.
+     */
+    juce::uint32 sync_start_in_msec;
+
+    /**
+     * True if a message was received while syncing.
+     */
+    bool sync_message_received;
+
+    /**
+     * Parses the messages the SSR sends, used for the sync and the echo
+     * filter.
+     */
+    SSR::Update_parser inbound_parser;
+
+    /**
+     * The records of the last parsed message, reused between messages.
+     */
+    std::vector<SSR::Source_update> inbound_updates;
+
+    /**
+     * The sources as the SSR sent them while syncing, by id.
+     */
+    std::unordered_map<unsigned int, SSR::Source_update> remote_sources;
+
+    /**
+     * The latency histograms, declared before echo_filter which records
+     * into it.
+     */
+    SSR::Latency_probe latency_probe;
+
+    /**
+     * Tracks the values in flight and recognizes their echoes.
+     */
+    SSR::Echo_filter echo_filter;
+
+    /**
+     * Randomises the reconnect backoff, so many instances do not reconnect
+     * in lockstep.
+     */
+    juce::Random random;
+
+    /**
+     * Number of reconnects after the connection was lost.
+     */
+    std::atomic<unsigned long> reconnects;
+
+    /**
+     * Number of dropped outbound updates.
+     */
+    std::atomic<unsigned long> dropped_updates;
+
+    /**
+     * Number of incoming records merged with a newer one.
+     */
+    std::atomic<unsigned long> collapsed_updates;
+
+    /**
+     * Number of outbound updates which did not result in an own source
+     * element because they were merged with another one.
+     */
+    std::atomic<unsigned long> coalesced_updates;
+
+    /**
+     * Number of incoming records dropped as echoes.
+     */
+    std::atomic<unsigned long> suppressed_echoes;
+
+    /**
+     * The round trip time measured by the echo filter, in milliseconds.
+     */
+    std::atomic<double> round_trip_in_msec;
+
+    /**
+     * Number of stamped updates released too late.
+     */
+    std::atomic<unsigned long> late_updates;
+
+  };
+
+}
+
+#endif
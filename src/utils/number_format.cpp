@@ -0,0 +1,207 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/number_format.h>
+
+//C++ Libs
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+
+  /**
+   * The powers of ten which are exact as double.
+   */
+  const double exact_powers_of_ten[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+
+  const int max_exact_power = 22;
+
+  /**
+   * A float is always identified by 9 significant digits.
+   */
+  const int max_precision = 9;
+
+  const unsigned long long integer_powers_of_ten[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL
+  };
+
+  /**
+   * Returns value * 10^power, rounded once as long as the power of ten is
+   * exact.
+   */
+  double scale(double value, int power)
+  {
+    while (power > max_exact_power) {
+        value *= exact_powers_of_ten[max_exact_power];
+        power -= max_exact_power;
+    }
+
+    while (power < -max_exact_power) {
+        value /= exact_powers_of_ten[max_exact_power];
+        power += max_exact_power;
+    }
+
+    return (power >= 0) ? value * exact_powers_of_ten[power] : value / exact_powers_of_ten[-power];
+  }
+
+  std::size_t write_literal(const char* literal, char* output)
+  {
+    const std::size_t length = std::strlen(literal);
+    std::memcpy(output, literal, length);
+    return length;
+  }
+
+}
+
+std::size_t SSR::number_format::write_float(const float value, char* output)
+{
+  if (std::isnan(value)) {
+      return write_literal("nan", output);
+  }
+
+  if (std::isinf(value)) {
+      return write_literal(value < 0.0f ? "-inf" : "inf", output);
+  }
+
+  if (value == 0.0f) {
+      output[0] = '0';
+      return 1;
+  }
+
+  char* position = output;
+
+  if (value < 0.0f) {
+      *position++ = '-';
+  }
+
+  const float target = std::fabs(value);
+  const double magnitude = target;
+
+  // Decimal exponent of the leading digit, log10 may be off by one.
+  int exponent = static_cast<int>(std::floor(std::log10(magnitude)));
+
+  if (scale(magnitude, -exponent) >= 10.0) {
+      exponent++;
+  } else if (scale(magnitude, -exponent) < 1.0) {
+      exponent--;
+  }
+
+  // Try 1 to 9 significant digits and take the first which reads back as
+  // the same float.
+  unsigned long long digits = 0;
+  int digit_count = 0;
+  int decimal_exponent = exponent;
+
+  for (int precision = 1; precision <= max_precision; precision++) {
+
+      int candidate_exponent = exponent;
+      unsigned long long candidate = static_cast<unsigned long long>(std::llround(scale(magnitude, precision - 1 - exponent)));
+
+      // Rounding carried into a new digit, e.g. 9.96 with 2 digits.
+      if (candidate >= integer_powers_of_ten[precision]) {
+          candidate /= 10;
+          candidate_exponent++;
+      }
+
+      const float read_back = static_cast<float>(scale(static_cast<double>(candidate), candidate_exponent - precision + 1));
+
+      if (read_back == target || precision == max_precision) {
+          digits = candidate;
+          digit_count = precision;
+          decimal_exponent = candidate_exponent;
+          break;
+      }
+
+  }
+
+  while (digit_count > 1 && digits % 10 == 0) {
+      digits /= 10;
+      digit_count--;
+  }
+
+  char digit_text[max_precision];
+
+  for (int index = digit_count - 1; index >= 0; index--) {
+      digit_text[index] = static_cast<char>('0' + digits % 10);
+      digits /= 10;
+  }
+
+  if (decimal_exponent >= 21 || decimal_exponent < -7) {
+
+      *position++ = digit_text[0];
+
+      if (digit_count > 1) {
+          *position++ = '.';
+          std::memcpy(position, digit_text + 1, digit_count - 1);
+          position += digit_count - 1;
+      }
+
+      *position++ = 'e';
+
+      if (decimal_exponent < 0) {
+          *position++ = '-';
+          decimal_exponent = -decimal_exponent;
+      }
+
+      position += write_unsigned(static_cast<unsigned long long>(decimal_exponent), position);
+
+  } else if (decimal_exponent >= 0) {
+
+      const int integer_digits = decimal_exponent + 1;
+
+      for (int index = 0; index < integer_digits; index++) {
+          *position++ = (index < digit_count) ? digit_text[index] : '0';
+      }
+
+      if (digit_count > integer_digits) {
+          *position++ = '.';
+          std::memcpy(position, digit_text + integer_digits, digit_count - integer_digits);
+          position += digit_count - integer_digits;
+      }
+
+  } else {
+
+      *position++ = '0';
+      *position++ = '.';
+
+      for (int index = -1; index > decimal_exponent; index--) {
+          *position++ = '0';
+      }
+
+      std::memcpy(position, digit_text, digit_count);
+      position += digit_count;
+
+  }
+
+  return static_cast<std::size_t>(position - output);
+}
+
+std::size_t SSR::number_format::write_unsigned(unsigned long long value, char* output)
+{
+  char reversed[max_unsigned_length];
+  std::size_t length = 0;
+
+  do {
+      reversed[length++] = static_cast<char>('0' + value % 10);
+      value /= 10;
+  } while (value != 0);
+
+  for (std::size_t index = 0; index < length; index++) {
+      output[index] = reversed[length - 1 - index];
+  }
+
+  return length;
+}
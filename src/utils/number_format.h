@@ -0,0 +1,71 @@
+#ifndef NUMBER_FORMAT_H
+#define NUMBER_FORMAT_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <cstddef>
+
+namespace SSR
+{
+
+  /**
+   * Locale independent number formatting for the SSR requests. The output
+   * always uses '.' as decimal separator, whatever locale the host has set,
+   * and never allocates.
+   */
+  namespace number_format
+  {
+
+    /**
+     * The maximum number of characters write_float writes.
+     */
+    static const std::size_t max_float_length = 24;
+
+    /**
+     * The maximum number of characters write_unsigned writes.
+     */
+    static const std::size_t max_unsigned_length = 20;
+
+    /**
+     * Writes the shortest decimal representation of the transferred value
+     * which reads back as the same float, for example "0.1" instead of
+     * "0.100000001". Values from 1e-7 up to 1e21 are written without
+     * exponent, all others as for example "1.5e-9". Infinity and NaN are
+     * written as "inf", "-inf" and "nan". The output is not null terminated.
+     *
+     * @param     value           The value which shall be written.
+     *
+     * @param     output          At least max_float_length characters.
+     *
+     * @return    the number of characters written.
+     */
+    std::size_t write_float(const float value, char* output);
+
+    /**
+     * Writes the decimal representation of the transferred value. The output
+     * is not null terminated.
+     *
+     * @param     value           The value which shall be written.
+     *
+     * @param     output          At least max_unsigned_length characters.
+     *
+     * @return    the number of characters written.
+     */
+    std::size_t write_unsigned(unsigned long long value, char* output);
+
+  }
+
+}
+
+#endif
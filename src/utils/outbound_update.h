@@ -0,0 +1,158 @@
+#ifndef OUTBOUND_UPDATE_H
+#define OUTBOUND_UPDATE_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <algorithm>
+#include <array>
+#include <string>
+#include <cstring>
+
+//Own Libs
+#include <src/utils/update_specificator.h>
+
+namespace SSR
+{
+
+  /**
+   * Where a change belongs on the timeline of the host (see Host_clock).
+   * The default stamp means "send at once".
+   */
+  struct Host_stamp
+  {
+
+    /**
+     * The sample position of the host the change belongs to, -1 if unknown.
+     */
+    long long sample_position = -1;
+
+    /**
+     * True if the transport of the host was playing.
+     */
+    bool playing = false;
+
+    /**
+     * The time (juce::Time::getMillisecondCounterHiRes) at which the audio
+     * at sample_position is expected to be audible, 0 if the change shall be
+     * sent at once.
+     */
+    double due_in_msec = 0.0;
+
+  };
+
+  /**
+   * A fixed size record describing the changes of a source that shall be sent
+   * to the SSR. Only the fields named by the specificator are meaningful.
+   *
+   * The record is filled on the thread that changed the scene and rendered to
+   * XML on the network thread, so the (possibly real time) calling thread does
+   * not need to allocate any memory. Strings are therefore stored in fixed
+   * size buffers and truncated if they do not fit.
+   */
+  struct Outbound_update
+  {
+
+    /**
+     * Fixed size, null terminated text buffer.
+     */
+    typedef std::array<char, 256> Text;
+
+    /**
+     * Which parameters of the source changed.
+     */
+    Update_specificator changed;
+
+    /**
+     * The SSR id of the source.
+     */
+    unsigned int source_id;
+
+    /**
+     * The discrete X position.
+     */
+    float x_position;
+
+    /**
+     * The discrete Y position.
+     */
+    float y_position;
+
+    /**
+     * The gain in dB.
+     */
+    float gain_in_db;
+
+    /**
+     * True if the source is muted.
+     */
+    bool mute;
+
+    /**
+     * True if the source is fixed.
+     */
+    bool fixed;
+
+    /**
+     * True if the source is a point source, false if it is a plane wave.
+     */
+    bool model_point;
+
+    /**
+     * The name of the source.
+     */
+    Text name;
+
+    /**
+     * The jackport of the source.
+     */
+    Text port;
+
+    /**
+     * The properties file of the source.
+     */
+    Text properties_file;
+
+    /**
+     * When the change shall take effect, the Release_scheduler of the
+     * network thread holds it back until then.
+     */
+    Host_stamp stamp;
+
+    /**
+     * The time (juce::Time::getMillisecondCounterHiRes) at which the change
+     * entered the outbound queues, 0 if unknown. Measures how long changes
+     * wait in the plugin (see Latency_probe).
+     */
+    double queued_in_msec = 0.0;
+
+  };
+
+  /**
+   * Copies the transferred value into the transferred text buffer and
+   * truncates it if necessary. Does not allocate.
+   *
+   * @param     text            The text buffer which shall be set.
+   *
+   * @param     value           The value which shall be copied.
+   */
+  inline void set_text(Outbound_update::Text& text, const std::string& value)
+  {
+    const std::size_t length = std::min(value.size(), text.size() - 1);
+    std::memcpy(text.data(), value.data(), length);
+    text[length] = '\0';
+  }
+
+}
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/release_scheduler.h>
+
+//C++ Libs
+#include <algorithm>
+
+//============================================================================
+// PUBLIC
+
+SSR::Release_scheduler::Release_scheduler()
+: held()
+, late_updates(0)
+{
+  held.reserve(256);
+}
+
+SSR::Release_scheduler::~Release_scheduler()
+{
+
+}
+
+bool SSR::Release_scheduler::hold(const SSR::Outbound_update& update)
+{
+  if (!update.stamp.playing || update.stamp.due_in_msec <= 0.0) {
+      return false;
+  }
+
+  // Blocks arrive in order, so the update almost always goes to the back.
+  auto position = std::upper_bound(held.begin(), held.end(), update, [](const SSR::Outbound_update& lhs, const SSR::Outbound_update& rhs) {
+    return lhs.stamp.due_in_msec < rhs.stamp.due_in_msec;
+  });
+
+  held.insert(position, update);
+
+  return true;
+}
+
+std::size_t SSR::Release_scheduler::release(const double now_in_msec, const double lead_in_msec, SSR::Update_coalescer& coalescer)
+{
+  std::size_t count = 0;
+
+  while (count < held.size() && held[count].stamp.due_in_msec - lead_in_msec <= now_in_msec) {
+
+      if (now_in_msec - (held[count].stamp.due_in_msec - lead_in_msec) > late_tolerance_in_msec) {
+          late_updates++;
+      }
+
+      // Holding back is intended, the update waits from its release on.
+      held[count].queued_in_msec = now_in_msec;
+      coalescer.add(held[count]);
+      count++;
+  }
+
+  held.erase(held.begin(), held.begin() + count);
+
+  return count;
+}
+
+std::size_t SSR::Release_scheduler::release_all(SSR::Update_coalescer& coalescer)
+{
+  const std::size_t count = held.size();
+
+  for (const SSR::Outbound_update& update : held) {
+      coalescer.add(update);
+  }
+
+  held.clear();
+
+  return count;
+}
+
+std::size_t SSR::Release_scheduler::get_held_updates() const
+{
+  return held.size();
+}
+
+unsigned long SSR::Release_scheduler::get_late_updates() const
+{
+  return late_updates;
+}
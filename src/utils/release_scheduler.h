@@ -0,0 +1,131 @@
+#ifndef RELEASE_SCHEDULER_H
+#define RELEASE_SCHEDULER_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <cstddef>
+#include <vector>
+
+//Own Libs
+#include <src/utils/outbound_update.h>
+#include <src/utils/update_coalescer.h>
+
+namespace SSR
+{
+
+  /**
+   * This class holds back stamped outbound updates until they are due.
+   *
+   * An update stamped while the transport of the host was playing carries
+   * the time at which the audio it belongs to is audible (see Host_clock).
+   * It is released into the Update_coalescer when that time minus the lead
+   * has come. The lead is the time a request needs to reach the SSR (half
+   * the measured round trip), so the SSR applies the change when the audio
+   * plays instead of whenever the host or the socket delivered it. All
+   * updates of one block share a due time and are released together.
+   *
+   * Updates without a due time (editor changes, stopped transport, offline
+   * rendering) are not held.
+   *
+   * Not thread safe, used by the network thread only.
+   */
+  class Release_scheduler
+  {
+
+  public:
+
+    /**
+     * Constructor.
+     */
+    Release_scheduler();
+
+    /**
+     * Destructor.
+     */
+    ~Release_scheduler();
+
+    /**
+     * Holds the transferred update back if it has a due time.
+     *
+     * @param     update          The update.
+     *
+     * @return    true if the update is held, false if it shall be sent at
+     *            once.
+     */
+    bool hold(const SSR::Outbound_update& update);
+
+    /**
+     * Moves the held updates which are due into the transferred coalescer,
+     * in the order of their due times.
+     *
+     * @param     now_in_msec     The current time
+     *                            (juce::Time::getMillisecondCounterHiRes).
+     *
+     * @param     lead_in_msec    The time ahead of the due time an update is
+     *                            released.
+     *
+     * @param     coalescer       The coalescer the updates are added to.
+     *
+     * @return    the number of released updates.
+     */
+    std::size_t release(const double now_in_msec, const double lead_in_msec, SSR::Update_coalescer& coalescer);
+
+    /**
+     * Moves all held updates into the transferred coalescer, e.g. while the
+     * connection is down.
+     *
+     * @param     coalescer       The coalescer the updates are added to.
+     *
+     * @return    the number of released updates.
+     */
+    std::size_t release_all(SSR::Update_coalescer& coalescer);
+
+    /**
+     * Returns the number of updates held back.
+     *
+     * @return the number of updates held back.
+     */
+    std::size_t get_held_updates() const;
+
+    /**
+     * Returns the number of updates which were released after their due
+     * time minus the lead, i.e. arrived too late to be compensated.
+     *
+     * @return the number of late updates.
+     */
+    unsigned long get_late_updates() const;
+
+  private:
+
+    /**
+     * Time in milliseconds an update may be released after its release time
+     * without counting as late, the network thread polls every 2 ms.
+     */
+    static const int late_tolerance_in_msec = 5;
+
+    /**
+     * The held updates, ordered by due time.
+     */
+    std::vector<SSR::Outbound_update> held;
+
+    /**
+     * The number of late updates.
+     */
+    unsigned long late_updates;
+
+  };
+
+}
+
+#endif
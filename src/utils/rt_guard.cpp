@@ -0,0 +1,396 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/rt_guard.h>
+
+#ifdef SSR_RT_GUARD
+
+//C++ Libs
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+//C Libs
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <poll.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+// The allocator of glibc behind malloc and its relatives. They are used
+// instead of dlsym(RTLD_NEXT, ...) because dlsym itself allocates.
+extern "C" {
+  void* __libc_malloc(std::size_t size);
+  void* __libc_calloc(std::size_t count, std::size_t size);
+  void* __libc_realloc(void* pointer, std::size_t size);
+  void* __libc_memalign(std::size_t alignment, std::size_t size);
+  void __libc_free(void* pointer);
+}
+
+namespace
+{
+
+  /**
+   * The number of frames kept of a backtrace.
+   */
+  const int max_frames = 24;
+
+  /**
+   * The number of distinct call sites kept, further ones are only counted.
+   */
+  const std::size_t max_call_sites = 256;
+
+  /**
+   * A call made inside a scope, identified by the call and its backtrace.
+   */
+  struct Call_site
+  {
+    const char* call;
+    const char* scope;
+    void* frames[max_frames];
+    int frame_count;
+    std::size_t count;
+  };
+
+  // The records are static so recording never allocates.
+  Call_site call_sites[max_call_sites];
+  std::size_t call_site_count = 0;
+  std::size_t dropped_call_sites = 0;
+  std::atomic_flag call_sites_lock = ATOMIC_FLAG_INIT;
+  std::atomic<std::size_t> violations(0);
+
+  // Initial exec TLS never allocates on access, so the allocator may use it.
+  __attribute__((tls_model("initial-exec"))) thread_local int scope_depth = 0;
+  __attribute__((tls_model("initial-exec"))) thread_local const char* scope_name = nullptr;
+  __attribute__((tls_model("initial-exec"))) thread_local bool recording = false;
+
+  /**
+   * Records the transferred call with the backtrace of the caller if the
+   * calling thread is inside a scope. Calls made while recording (backtrace
+   * may allocate) are not recorded.
+   */
+  void record(const char* call)
+  {
+
+    if (scope_depth == 0 || recording) {
+        return;
+    }
+
+    recording = true;
+
+    void* frames[max_frames];
+    const int frame_count = backtrace(frames, max_frames);
+
+    violations++;
+
+    while (call_sites_lock.test_and_set(std::memory_order_acquire)) {
+    }
+
+    std::size_t index = 0;
+
+    for (; index < call_site_count; index++) {
+
+        const Call_site& site = call_sites[index];
+
+        if (site.call == call && site.frame_count == frame_count && std::memcmp(site.frames, frames, frame_count * sizeof(void*)) == 0) {
+            break;
+        }
+
+    }
+
+    if (index < call_site_count) {
+        call_sites[index].count++;
+    } else if (call_site_count < max_call_sites) {
+        Call_site& site = call_sites[call_site_count++];
+        site.call = call;
+        site.scope = scope_name;
+        std::memcpy(site.frames, frames, frame_count * sizeof(void*));
+        site.frame_count = frame_count;
+        site.count = 1;
+    } else {
+        dropped_call_sites++;
+    }
+
+    call_sites_lock.clear(std::memory_order_release);
+
+    recording = false;
+  }
+
+  /**
+   * Loads the unwinder before the first scope is entered (the first
+   * backtrace() loads libgcc_s) and writes the report when the process
+   * exits.
+   */
+  struct Reporter
+  {
+
+    Reporter()
+    {
+      void* frames[1];
+      backtrace(frames, 1);
+    }
+
+    ~Reporter()
+    {
+      SSR::Rt_guard::write_report(stderr);
+    }
+
+  } reporter;
+
+}
+
+/**
+ * Looks up the next definition of the transferred function once. A racing
+ * first lookup from two threads stores the same address twice.
+ */
+#define SSR_RT_GUARD_NEXT(function) \
+  static decltype(&function) next_##function = nullptr; \
+  if (next_##function == nullptr) { \
+      next_##function = reinterpret_cast<decltype(&function)>(dlsym(RTLD_NEXT, #function)); \
+  }
+
+#define SSR_RT_GUARD_EXPORT extern "C" __attribute__((visibility("default")))
+
+//============================================================================
+// Allocations
+
+SSR_RT_GUARD_EXPORT void* malloc(std::size_t size) throw()
+{
+  record("malloc");
+  return __libc_malloc(size);
+}
+
+SSR_RT_GUARD_EXPORT void* calloc(std::size_t count, std::size_t size) throw()
+{
+  record("calloc");
+  return __libc_calloc(count, size);
+}
+
+SSR_RT_GUARD_EXPORT void* realloc(void* pointer, std::size_t size) throw()
+{
+  record("realloc");
+  return __libc_realloc(pointer, size);
+}
+
+SSR_RT_GUARD_EXPORT void* memalign(std::size_t alignment, std::size_t size) throw()
+{
+  record("memalign");
+  return __libc_memalign(alignment, size);
+}
+
+SSR_RT_GUARD_EXPORT int posix_memalign(void** pointer, std::size_t alignment, std::size_t size) throw()
+{
+  record("posix_memalign");
+
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment % sizeof(void*) != 0) {
+      return EINVAL;
+  }
+
+  void* memory = __libc_memalign(alignment, size);
+
+  if (memory == nullptr) {
+      return ENOMEM;
+  }
+
+  *pointer = memory;
+  return 0;
+}
+
+SSR_RT_GUARD_EXPORT void free(void* pointer) throw()
+{
+
+  if (pointer != nullptr) {
+      record("free");
+  }
+
+  __libc_free(pointer);
+}
+
+//============================================================================
+// Locks
+
+SSR_RT_GUARD_EXPORT int pthread_mutex_lock(pthread_mutex_t* mutex) throw()
+{
+  record("pthread_mutex_lock");
+  SSR_RT_GUARD_NEXT(pthread_mutex_lock)
+  return next_pthread_mutex_lock(mutex);
+}
+
+SSR_RT_GUARD_EXPORT int pthread_cond_wait(pthread_cond_t* condition, pthread_mutex_t* mutex)
+{
+  record("pthread_cond_wait");
+  SSR_RT_GUARD_NEXT(pthread_cond_wait)
+  return next_pthread_cond_wait(condition, mutex);
+}
+
+SSR_RT_GUARD_EXPORT int sem_wait(sem_t* semaphore)
+{
+  record("sem_wait");
+  SSR_RT_GUARD_NEXT(sem_wait)
+  return next_sem_wait(semaphore);
+}
+
+//============================================================================
+// Blocking syscalls
+
+SSR_RT_GUARD_EXPORT ssize_t read(int fd, void* buffer, std::size_t size)
+{
+  record("read");
+  SSR_RT_GUARD_NEXT(read)
+  return next_read(fd, buffer, size);
+}
+
+SSR_RT_GUARD_EXPORT ssize_t write(int fd, const void* buffer, std::size_t size)
+{
+  record("write");
+  SSR_RT_GUARD_NEXT(write)
+  return next_write(fd, buffer, size);
+}
+
+SSR_RT_GUARD_EXPORT ssize_t send(int fd, const void* buffer, std::size_t size, int flags)
+{
+  record("send");
+  SSR_RT_GUARD_NEXT(send)
+  return next_send(fd, buffer, size, flags);
+}
+
+SSR_RT_GUARD_EXPORT ssize_t recv(int fd, void* buffer, std::size_t size, int flags)
+{
+  record("recv");
+  SSR_RT_GUARD_NEXT(recv)
+  return next_recv(fd, buffer, size, flags);
+}
+
+SSR_RT_GUARD_EXPORT int connect(int fd, const struct sockaddr* address, socklen_t length)
+{
+  record("connect");
+  SSR_RT_GUARD_NEXT(connect)
+  return next_connect(fd, address, length);
+}
+
+SSR_RT_GUARD_EXPORT int poll(struct pollfd* fds, nfds_t count, int timeout)
+{
+  record("poll");
+  SSR_RT_GUARD_NEXT(poll)
+  return next_poll(fds, count, timeout);
+}
+
+SSR_RT_GUARD_EXPORT int select(int count, fd_set* read_fds, fd_set* write_fds, fd_set* except_fds, struct timeval* timeout)
+{
+  record("select");
+  SSR_RT_GUARD_NEXT(select)
+  return next_select(count, read_fds, write_fds, except_fds, timeout);
+}
+
+SSR_RT_GUARD_EXPORT int fsync(int fd)
+{
+  record("fsync");
+  SSR_RT_GUARD_NEXT(fsync)
+  return next_fsync(fd);
+}
+
+SSR_RT_GUARD_EXPORT int nanosleep(const struct timespec* duration, struct timespec* remaining)
+{
+  record("nanosleep");
+  SSR_RT_GUARD_NEXT(nanosleep)
+  return next_nanosleep(duration, remaining);
+}
+
+SSR_RT_GUARD_EXPORT int usleep(useconds_t duration)
+{
+  record("usleep");
+  SSR_RT_GUARD_NEXT(usleep)
+  return next_usleep(duration);
+}
+
+//============================================================================
+// Rt_guard
+
+SSR::Rt_guard::Scope::Scope(const char* name)
+{
+
+  if (scope_depth++ == 0) {
+      scope_name = name;
+  }
+
+}
+
+SSR::Rt_guard::Scope::~Scope()
+{
+  scope_depth--;
+}
+
+std::size_t SSR::Rt_guard::get_violation_count()
+{
+  return violations;
+}
+
+void SSR::Rt_guard::write_report(std::FILE* file)
+{
+  // The report itself allocates, it must not be recorded.
+  const bool was_recording = recording;
+  recording = true;
+
+  while (call_sites_lock.test_and_set(std::memory_order_acquire)) {
+  }
+
+  std::fprintf(file, "Real-time guard: %zu calls at %zu call sites inside real-time scopes\n", static_cast<std::size_t>(violations), call_site_count + dropped_call_sites);
+
+  for (std::size_t index = 0; index < call_site_count; index++) {
+
+      const Call_site& site = call_sites[index];
+
+      std::fprintf(file, "\n%s in %s (%zu times)\n", site.call, site.scope, site.count);
+      std::fflush(file);
+
+      // The first frame is record() itself.
+      backtrace_symbols_fd(site.frames + 1, site.frame_count - 1, fileno(file));
+  }
+
+  if (dropped_call_sites > 0) {
+      std::fprintf(file, "\n%zu further call sites were not kept\n", dropped_call_sites);
+  }
+
+  std::fflush(file);
+
+  call_sites_lock.clear(std::memory_order_release);
+
+  recording = was_recording;
+}
+
+#else
+
+SSR::Rt_guard::Scope::Scope(const char* /*name*/)
+{
+
+}
+
+SSR::Rt_guard::Scope::~Scope()
+{
+
+}
+
+std::size_t SSR::Rt_guard::get_violation_count()
+{
+  return 0;
+}
+
+void SSR::Rt_guard::write_report(std::FILE* file)
+{
+  std::fprintf(file, "Real-time guard: not built with SSR_RT_GUARD\n");
+}
+
+#endif
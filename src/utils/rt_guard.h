@@ -0,0 +1,105 @@
+#ifndef RT_GUARD_H
+#define RT_GUARD_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <cstddef>
+#include <cstdio>
+
+/**
+ * Marks the rest of the enclosing block as real-time code named name.
+ *
+ * Expands to nothing unless the plugin is built with SSR_RT_GUARD defined
+ * (make SSR_RT_GUARD=1).
+ */
+#ifdef SSR_RT_GUARD
+#define SSR_RT_SCOPE(name) SSR::Rt_guard::Scope ssr_rt_scope(name)
+#else
+#define SSR_RT_SCOPE(name)
+#endif
+
+namespace SSR
+{
+
+  /**
+   * Instrumentation proving that the real-time path of the plugin does not
+   * allocate, lock or block.
+   *
+   * Built with SSR_RT_GUARD defined, rt_guard.cpp interposes malloc and its
+   * relatives, pthread_mutex_lock and the blocking syscalls of libc. While a
+   * thread is inside a Scope, every such call is recorded with the backtrace
+   * of its call site. Equal call sites are counted once, and the report is
+   * written to stderr when the process exits.
+   *
+   * Inside a host the interposition only takes effect if the plugin is loaded
+   * first, e.g. LD_PRELOAD=ssr_scene_automation_vst_plugin.so <host>. The
+   * rt_path_check program of the benchmarks links it into the executable.
+   *
+   * Without SSR_RT_GUARD nothing is interposed and no call is ever recorded.
+   */
+  class Rt_guard
+  {
+
+  public:
+
+    /**
+     * Marks the calling thread as running real-time code for the lifetime of
+     * the scope. Scopes may be nested, the outermost one names the records.
+     * A scope never allocates.
+     */
+    class Scope
+    {
+
+    public:
+
+      /**
+       * Constructor entering the real-time code.
+       *
+       * @param     name            The name of the real-time code, must be a
+       *                            string literal.
+       */
+      explicit Scope(const char* name);
+
+      /**
+       * Destructor leaving the real-time code.
+       */
+      ~Scope();
+
+    private:
+
+      Scope(const Scope&);
+      Scope& operator=(const Scope&);
+
+    };
+
+    /**
+     * Returns the number of calls recorded inside a scope so far.
+     *
+     * @return the number of recorded calls.
+     */
+    static std::size_t get_violation_count();
+
+    /**
+     * Writes every recorded call site with its count and symbolised
+     * backtrace to the transferred file.
+     *
+     * @param     file            The file to write the report to.
+     */
+    static void write_report(std::FILE* file);
+
+  };
+
+}
+
+#endif
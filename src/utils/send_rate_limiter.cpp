@@ -0,0 +1,187 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/send_rate_limiter.h>
+
+//C++ Libs
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+//Own Libs
+#include <src/utils/metrics.h>
+
+//============================================================================
+// PUBLIC
+
+SSR::Send_rate_limiter::Send_rate_limiter(const std::size_t channel_count)
+: channel_count(channel_count)
+, channels(new Channel[channel_count])
+, suppressed_by_rate(0)
+, suppressed_by_deadband(0)
+{
+  for (std::size_t index = 0; index < channel_count; index++) {
+      channels[index].busy = false;
+      channels[index].deadband = 0.0f;
+      channels[index].relative_deadband = 0.0f;
+      channels[index].min_interval_in_msec = 0;
+      channels[index].last_first = 0.0f;
+      channels[index].last_second = 0.0f;
+      channels[index].last_send_in_msec = 0;
+      channels[index].last_change_in_msec = 0;
+      channels[index].sent_once = false;
+      channels[index].pending = false;
+  }
+}
+
+SSR::Send_rate_limiter::~Send_rate_limiter()
+{
+
+}
+
+void SSR::Send_rate_limiter::set_max_rate(const std::size_t channel, const unsigned int max_rate_in_hz)
+{
+  if (channel < channel_count) {
+      Channel& state = channels[channel];
+      acquire(state);
+      state.min_interval_in_msec = (max_rate_in_hz == 0) ? 0 : 1000 / max_rate_in_hz;
+      release(state);
+  }
+}
+
+void SSR::Send_rate_limiter::set_deadband(const std::size_t channel, const float deadband, const float relative_deadband)
+{
+  if (channel < channel_count) {
+      Channel& state = channels[channel];
+      acquire(state);
+      state.deadband = std::fabs(deadband);
+      state.relative_deadband = std::fabs(relative_deadband);
+      release(state);
+  }
+}
+
+bool SSR::Send_rate_limiter::should_send(const std::size_t channel, const float first, const float second, const unsigned int now_in_msec)
+{
+  if (channel >= channel_count) {
+      return true;
+  }
+
+  Channel& state = channels[channel];
+
+  // The message thread is flushing this channel right now, sending one value
+  // too many is cheaper than waiting for it.
+  if (!try_acquire(state)) {
+      return true;
+  }
+
+  state.last_change_in_msec = now_in_msec;
+
+  if (state.sent_once) {
+
+      const float difference = std::max(std::fabs(first - state.last_first), std::fabs(second - state.last_second));
+
+      if (difference == 0.0f) {
+          // The SSR already has exactly this value.
+          state.pending = false;
+          release(state);
+          suppressed_by_deadband++;
+          SSR::Metrics::get_instance().add(SSR::Metrics::suppressed_by_deadband);
+          return false;
+      }
+
+      const float magnitude = std::sqrt(state.last_first * state.last_first + state.last_second * state.last_second);
+
+      if (difference < std::max(state.deadband, state.relative_deadband * magnitude)) {
+          state.pending = true;
+          release(state);
+          suppressed_by_deadband++;
+          SSR::Metrics::get_instance().add(SSR::Metrics::suppressed_by_deadband);
+          return false;
+      }
+
+      if (now_in_msec - state.last_send_in_msec < state.min_interval_in_msec) {
+          state.pending = true;
+          release(state);
+          suppressed_by_rate++;
+          SSR::Metrics::get_instance().add(SSR::Metrics::suppressed_by_rate);
+          return false;
+      }
+
+  }
+
+  record_sent(state, first, second, now_in_msec);
+  release(state);
+
+  return true;
+}
+
+bool SSR::Send_rate_limiter::take_pending(const std::size_t channel, const float first, const float second, const unsigned int now_in_msec)
+{
+  if (channel >= channel_count) {
+      return false;
+  }
+
+  Channel& state = channels[channel];
+
+  if (!try_acquire(state)) {
+      return false;
+  }
+
+  const bool due = state.pending && now_in_msec - state.last_change_in_msec >= idle_time_in_msec;
+
+  if (due) {
+      record_sent(state, first, second, now_in_msec);
+  }
+
+  release(state);
+
+  return due;
+}
+
+unsigned long SSR::Send_rate_limiter::get_suppressed_by_rate() const
+{
+  return suppressed_by_rate;
+}
+
+unsigned long SSR::Send_rate_limiter::get_suppressed_by_deadband() const
+{
+  return suppressed_by_deadband;
+}
+
+//============================================================================
+// PRIVATE
+
+bool SSR::Send_rate_limiter::try_acquire(Channel& state)
+{
+  return !state.busy.exchange(true, std::memory_order_acquire);
+}
+
+void SSR::Send_rate_limiter::acquire(Channel& state)
+{
+  while (!try_acquire(state)) {
+      std::this_thread::yield();
+  }
+}
+
+void SSR::Send_rate_limiter::release(Channel& state)
+{
+  state.busy.store(false, std::memory_order_release);
+}
+
+void SSR::Send_rate_limiter::record_sent(Channel& state, const float first, const float second, const unsigned int now_in_msec)
+{
+  state.last_first = first;
+  state.last_second = second;
+  state.last_send_in_msec = now_in_msec;
+  state.sent_once = true;
+  state.pending = false;
+}
@@ -0,0 +1,226 @@
+#ifndef SEND_RATE_LIMITER_H
+#define SEND_RATE_LIMITER_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace SSR
+{
+
+  /**
+   * This class decides whether a new value of a continuous parameter shall be
+   * sent to the SSR. Every parameter (channel) is filtered independently by
+   *
+   * - a rate cap: a value is not sent if the previous one of the same channel
+   *   was sent less than 1 / max_rate seconds ago, and
+   * - a deadband: a value is not sent if it differs from the last sent value
+   *   by less than the deadband of the channel. The deadband is the larger
+   *   of an absolute one and a relative one, a fraction of the magnitude of
+   *   the last sent value.
+   *
+   * A channel carries up to two values (e.g. the X and Y position) which are
+   * compared component wise; the magnitude of two values is their distance
+   * to the origin.
+   *
+   * Suppressed values leave the channel pending. take_pending reports a
+   * pending channel once no new value arrived for idle_time_in_msec, so the
+   * last value is flushed when the automation stops and the SSR ends up with
+   * the exact final state.
+   *
+   * should_send may be called from the host's automation thread while
+   * take_pending is called from the message thread. The whole state of a
+   * channel is guarded by a flag which both only try to acquire, so neither
+   * blocks nor allocates: if the other thread holds the channel, should_send
+   * lets the value through unfiltered and take_pending retries on its next
+   * call.
+   */
+  class Send_rate_limiter
+  {
+
+  public:
+
+    /**
+     * Constructor.
+     *
+     * @param     channel_count   The number of independent channels.
+     */
+    Send_rate_limiter(const std::size_t channel_count);
+
+    /**
+     * Destructor.
+     */
+    ~Send_rate_limiter();
+
+    /**
+     * Sets the maximum number of values per second of the transferred
+     * channel.
+     *
+     * @param     channel         The channel.
+     *
+     * @param     max_rate_in_hz  The maximum rate, 0 disables the rate cap.
+     */
+    void set_max_rate(const std::size_t channel, const unsigned int max_rate_in_hz);
+
+    /**
+     * Sets the deadband of the transferred channel.
+     *
+     * @param     channel         The channel.
+     *
+     * @param     deadband        The minimum absolute difference to the last
+     *                            sent value, 0 disables the deadband.
+     *
+     * @param     relative_deadband       The minimum difference as a
+     *                                    fraction of the magnitude of the
+     *                                    last sent value, 0 disables it.
+     */
+    void set_deadband(const std::size_t channel, const float deadband, const float relative_deadband = 0.0f);
+
+    /**
+     * Returns true if the transferred value shall be sent now. In that case
+     * the value is recorded as sent, otherwise the channel becomes pending
+     * and a suppression counter is incremented.
+     *
+     * @param     channel         The channel.
+     *
+     * @param     first           The (first) value.
+     *
+     * @param     second          The optional second value.
+     *
+     * @param     now_in_msec     The current time in milliseconds.
+     *
+     * @return    true if the value shall be sent now.
+     */
+    bool should_send(const std::size_t channel, const float first, const float second, const unsigned int now_in_msec);
+
+    /**
+     * Returns true if the transferred channel is pending and idle. In that
+     * case the transferred (latest) value is recorded as sent and the
+     * pending state is cleared.
+     *
+     * @param     channel         The channel.
+     *
+     * @param     first           The latest (first) value.
+     *
+     * @param     second          The optional latest second value.
+     *
+     * @param     now_in_msec     The current time in milliseconds.
+     *
+     * @return    true if the latest value of the channel shall be sent now.
+     */
+    bool take_pending(const std::size_t channel, const float first, const float second, const unsigned int now_in_msec);
+
+    /**
+     * Returns the number of values suppressed by the rate cap.
+     *
+     * @return the number of values suppressed by the rate cap.
+     */
+    unsigned long get_suppressed_by_rate() const;
+
+    /**
+     * Returns the number of values suppressed by the deadband.
+     *
+     * @return the number of values suppressed by the deadband.
+     */
+    unsigned long get_suppressed_by_deadband() const;
+
+  private:
+
+    /**
+     * Time in milliseconds without new values after which a channel is idle.
+     */
+    static const unsigned int idle_time_in_msec = 50;
+
+    /**
+     * The state of one channel. All members but busy are only accessed by
+     * the thread which acquired busy.
+     */
+    struct Channel
+    {
+      std::atomic<bool> busy;
+      float deadband;
+      float relative_deadband;
+      unsigned int min_interval_in_msec;
+      float last_first;
+      float last_second;
+      unsigned int last_send_in_msec;
+      unsigned int last_change_in_msec;
+      bool sent_once;
+      bool pending;
+    };
+
+    /**
+     * Acquires the transferred channel if no other thread holds it.
+     *
+     * @param     state           The channel.
+     *
+     * @return    true if the channel was acquired.
+     */
+    static bool try_acquire(Channel& state);
+
+    /**
+     * Acquires the transferred channel, yielding while another thread holds
+     * it. Only used by the setters, which are not called in real time.
+     *
+     * @param     state           The channel.
+     */
+    static void acquire(Channel& state);
+
+    /**
+     * Releases the transferred channel.
+     *
+     * @param     state           The channel.
+     */
+    static void release(Channel& state);
+
+    /**
+     * Records the transferred value as sent. The channel has to be acquired.
+     *
+     * @param     state           The channel.
+     *
+     * @param     first           The (first) value.
+     *
+     * @param     second          The optional second value.
+     *
+     * @param     now_in_msec     The current time in milliseconds.
+     */
+    static void record_sent(Channel& state, const float first, const float second, const unsigned int now_in_msec);
+
+    /**
+     * The number of channels.
+     */
+    std::size_t channel_count;
+
+    /**
+     * The channels.
+     */
+    std::unique_ptr<Channel[]> channels;
+
+    /**
+     * Number of values suppressed by the rate cap.
+     */
+    std::atomic<unsigned long> suppressed_by_rate;
+
+    /**
+     * Number of values suppressed by the deadband.
+     */
+    std::atomic<unsigned long> suppressed_by_deadband;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,282 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace SSR
+{
+
+  /**
+   * A container handing out stable handles (generational indices) for its
+   * elements.
+   *
+   * The elements are stored densely, so iterating over them is as fast as
+   * iterating over a std::vector. A handle refers to a slot which knows the
+   * current position of its element, therefore handles stay valid when other
+   * elements are inserted or erased. Erasing an element increments the
+   * generation of its slot, so old handles to it are detected as stale
+   * instead of referring to a later element reusing the slot.
+   *
+   * Insert, erase and lookup by handle are O(1).
+   *
+   * @param     T               The element type, has to be move assignable.
+   */
+  template <typename T>
+  class Slot_map
+  {
+
+  public:
+
+    /**
+     * A handle to an element of the slot map.
+     */
+    struct Handle
+    {
+
+      /**
+       * The slot of the element.
+       */
+      std::uint32_t index;
+
+      /**
+       * The generation of the slot when the element was inserted.
+       */
+      std::uint32_t generation;
+
+      /**
+       * Returns true if both handles refer to the same element.
+       */
+      bool operator==(const Handle& rhs) const
+      {
+        return index == rhs.index && generation == rhs.generation;
+      }
+
+      /**
+       * Returns true if the handles refer to different elements.
+       */
+      bool operator!=(const Handle& rhs) const
+      {
+        return !(*this == rhs);
+      }
+
+    };
+
+    typedef typename std::vector<T>::iterator iterator;
+
+    typedef typename std::vector<T>::const_iterator const_iterator;
+
+    /**
+     * Returns a handle which never refers to an element.
+     *
+     * @return a handle which never refers to an element.
+     */
+    static Handle invalid_handle()
+    {
+      Handle handle;
+      handle.index = no_slot;
+      handle.generation = 0;
+      return handle;
+    }
+
+    /**
+     * Inserts the transferred element.
+     *
+     * @param     value           The element.
+     *
+     * @return    the handle of the new element.
+     */
+    Handle insert(T value)
+    {
+      std::uint32_t index = free_slot;
+
+      if (index == no_slot) {
+          index = static_cast<std::uint32_t>(slots.size());
+          Slot slot;
+          slot.position = 0;
+          slot.generation = 0;
+          slots.push_back(slot);
+      } else {
+          free_slot = slots[index].position;
+      }
+
+      slots[index].position = static_cast<std::uint32_t>(values.size());
+      values.push_back(std::move(value));
+      value_slots.push_back(index);
+
+      Handle handle;
+      handle.index = index;
+      handle.generation = slots[index].generation;
+      return handle;
+    }
+
+    /**
+     * Erases the element the transferred handle refers to. The last element
+     * is moved into the gap, so the order of the elements changes.
+     *
+     * @param     handle          The handle.
+     *
+     * @return    true if the element was erased, false if the handle is
+     *            stale.
+     */
+    bool erase(const Handle handle)
+    {
+      if (!contains(handle)) {
+          return false;
+      }
+
+      const std::uint32_t position = slots[handle.index].position;
+      const std::uint32_t last_position = static_cast<std::uint32_t>(values.size() - 1);
+
+      if (position != last_position) {
+          values[position] = std::move(values[last_position]);
+          value_slots[position] = value_slots[last_position];
+          slots[value_slots[position]].position = position;
+      }
+
+      values.pop_back();
+      value_slots.pop_back();
+
+      slots[handle.index].generation++;
+      slots[handle.index].position = free_slot;
+      free_slot = handle.index;
+
+      return true;
+    }
+
+    /**
+     * Returns true if the transferred handle refers to an element.
+     *
+     * @param     handle          The handle.
+     *
+     * @return    true if the transferred handle refers to an element.
+     */
+    bool contains(const Handle handle) const
+    {
+      return handle.index < slots.size() && slots[handle.index].generation == handle.generation;
+    }
+
+    /**
+     * Returns the element the transferred handle refers to.
+     *
+     * @param     handle          The handle.
+     *
+     * @return    the element or nullptr if the handle is stale.
+     */
+    T* get(const Handle handle)
+    {
+      return contains(handle) ? &values[slots[handle.index].position] : nullptr;
+    }
+
+    /**
+     * Returns the element the transferred handle refers to.
+     *
+     * @param     handle          The handle.
+     *
+     * @return    the element or nullptr if the handle is stale.
+     */
+    const T* get(const Handle handle) const
+    {
+      return contains(handle) ? &values[slots[handle.index].position] : nullptr;
+    }
+
+    /**
+     * Returns the handle of the element at the transferred position of the
+     * dense storage.
+     *
+     * @param     position        The position, has to be less than size().
+     *
+     * @return    the handle of the element.
+     */
+    Handle handle_at(const std::size_t position) const
+    {
+      Handle handle;
+      handle.index = value_slots[position];
+      handle.generation = slots[handle.index].generation;
+      return handle;
+    }
+
+    /**
+     * Returns the number of elements.
+     *
+     * @return the number of elements.
+     */
+    std::size_t size() const
+    {
+      return values.size();
+    }
+
+    /**
+     * Returns true if there is no element.
+     *
+     * @return true if there is no element.
+     */
+    bool empty() const
+    {
+      return values.empty();
+    }
+
+    iterator begin() { return values.begin(); }
+
+    iterator end() { return values.end(); }
+
+    const_iterator begin() const { return values.begin(); }
+
+    const_iterator end() const { return values.end(); }
+
+  private:
+
+    /**
+     * Marks the end of the free list and invalid handles.
+     */
+    static const std::uint32_t no_slot = 0xFFFFFFFFu;
+
+    /**
+     * A slot stores the position of its element in the dense storage or, if
+     * it is free, the next free slot.
+     */
+    struct Slot
+    {
+      std::uint32_t position;
+      std::uint32_t generation;
+    };
+
+    /**
+     * The elements, stored densely.
+     */
+    std::vector<T> values;
+
+    /**
+     * The slot of each element of values.
+     */
+    std::vector<std::uint32_t> value_slots;
+
+    /**
+     * All slots ever used.
+     */
+    std::vector<Slot> slots;
+
+    /**
+     * The first free slot.
+     */
+    std::uint32_t free_slot = no_slot;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace SSR
+{
+
+  /**
+   * A bounded, lock-free single producer / single consumer queue.
+   *
+   * All slots are allocated once on construction, so neither try_push nor
+   * try_pop allocate memory on their own (as long as copying or moving T does
+   * not). Exactly one thread may push and exactly one (other) thread may pop.
+   *
+   * @param     T               The element type.
+   *
+   * @param     Capacity        The maximum number of elements, has to be a
+   *                            power of two.
+   */
+  template <typename T, std::size_t Capacity>
+  class Spsc_queue
+  {
+
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity has to be a power of two.");
+
+  public:
+
+    /**
+     * Constructor allocating all slots of the queue.
+     */
+    Spsc_queue()
+    : slots(new T[Capacity])
+    , head(0)
+    , tail(0)
+    {
+
+    }
+
+    /**
+     * Copies the transferred item into the queue.
+     *
+     * Must only be called by the producer thread.
+     *
+     * @param     item            The item which shall be enqueued.
+     *
+     * @return    true if the item was enqueued, false if the queue is full.
+     */
+    bool try_push(const T& item)
+    {
+      const std::size_t current_tail = tail.load(std::memory_order_relaxed);
+
+      if (current_tail - head.load(std::memory_order_acquire) == Capacity) {
+          return false;
+      }
+
+      slots[current_tail & (Capacity - 1)] = item;
+      tail.store(current_tail + 1, std::memory_order_release);
+
+      return true;
+    }
+
+    /**
+     * Moves the transferred item into the queue.
+     *
+     * Must only be called by the producer thread.
+     *
+     * @param     item            The item which shall be enqueued.
+     *
+     * @return    true if the item was enqueued, false if the queue is full.
+     */
+    bool try_push(T&& item)
+    {
+      const std::size_t current_tail = tail.load(std::memory_order_relaxed);
+
+      if (current_tail - head.load(std::memory_order_acquire) == Capacity) {
+          return false;
+      }
+
+      slots[current_tail & (Capacity - 1)] = std::move(item);
+      tail.store(current_tail + 1, std::memory_order_release);
+
+      return true;
+    }
+
+    /**
+     * Moves the oldest element of the queue into the transferred item.
+     *
+     * Must only be called by the consumer thread.
+     *
+     * @param     item            The item the oldest element shall be moved
+     *                            to.
+     *
+     * @return    true if an element was dequeued, false if the queue is empty.
+     */
+    bool try_pop(T& item)
+    {
+      const std::size_t current_head = head.load(std::memory_order_relaxed);
+
+      if (current_head == tail.load(std::memory_order_acquire)) {
+          return false;
+      }
+
+      item = std::move(slots[current_head & (Capacity - 1)]);
+      head.store(current_head + 1, std::memory_order_release);
+
+      return true;
+    }
+
+    /**
+     * Returns true if the queue is empty at the time of calling. The result
+     * is only reliable for the consumer thread.
+     *
+     * @return true if the queue is empty.
+     */
+    bool empty() const
+    {
+      return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+  private:
+
+    /**
+     * The ring of slots.
+     */
+    std::unique_ptr<T[]> slots;
+
+    /**
+     * Index of the next element to pop, only written by the consumer.
+     */
+    std::atomic<std::size_t> head;
+
+    /**
+     * Keeps head and tail on different cache lines.
+     */
+    char padding[64];
+
+    /**
+     * Index of the next free slot, only written by the producer.
+     */
+    std::atomic<std::size_t> tail;
+
+  };
+
+}
+
+#endif
@@ -12,74 +12,197 @@
 
 //C++ Libs
 #include <string>
-#include <sstream>
 
 //Own classes
 #include <src/utils/ssr_requester.h>
-#include <src/utils/helper.h>
+#include <src/utils/number_format.h>
+
+namespace
+{
+
+  /**
+   * Appends a pre-rendered fragment of the request, its size is known at
+   * compile time.
+   */
+  template <std::size_t Size>
+  void append_fragment(std::string& request, const char (&fragment)[Size])
+  {
+    request.append(fragment, Size - 1);
+  }
+
+}
 
 //++++++++++++++++++++++++++++++++++++
 // PUBLIC ++++++++++++++++++++++++++++
 //++++++++++++++++++++++++++++++++++++
 
-SSR::SSR_requester::SSR_requester() : request_ss(new std::stringstream(std::string())) { }
+SSR::SSR_requester::SSR_requester() { }
 
-SSR::SSR_requester::~SSR_requester() { delete request_ss; }
+SSR::SSR_requester::~SSR_requester() { }
 
-const std::string SSR::SSR_requester::build(Build_function bf)
+void SSR::SSR_requester::begin(std::string& request) const
 {
-  request_ss->str(std::string());
-
-  *request_ss << "<request>";
-
-  bf(request_ss);
-
-  *request_ss << "</request>";
-
-  return request_ss->str();
+  request.clear();
+  append_fragment(request, "<request>");
 }
 
-void SSR::request::source_position(std::ostream* output, const float source_id, const float x, const float y)
+void SSR::SSR_requester::append(std::string& request, const Outbound_update& update) const
 {
-  *output << "<source id=\"" << source_id << "\"><position x=\"" << x << "\" y=\"" << y << "\"/></source>";
+  if (update.changed.contains(SSR::Update_specificator::new_source)) {
+      append_new_source(request, update);
+  } else {
+      append_source_update(request, update);
+  }
 }
 
-void SSR::request::source_gain(std::ostream* output, const float source_id, const float gain_in_db)
+void SSR::SSR_requester::end(std::string& request) const
 {
-  *output << "<source id=\"" << source_id << "\" volume=\"" << gain_in_db << "\"/>";
+  append_fragment(request, "</request>");
 }
 
-void SSR::request::source_mute(std::ostream* output, const int source_id, const bool mute) 
-{   
-  *output << "<source id=\"" << source_id << "\" mute=\"" << mute << "\"/>";
+void SSR::SSR_requester::build(std::string& request, const Outbound_update& update) const
+{
+  begin(request);
+  append(request, update);
+  end(request);
 }
 
-void SSR::request::source_fixed(std::ostream* output, const int source_id, const bool fixed)
+//++++++++++++++++++++++++++++++++++++
+// PRIVATE +++++++++++++++++++++++++++
+//++++++++++++++++++++++++++++++++++++
+
+void SSR::SSR_requester::append_new_source(std::string& request, const Outbound_update& update)
 {
-  *output << "<source id=\"" << source_id << "\"><position fixed=\"" << fixed << "\"/></source>";
+  append_fragment(request, "<source new=\"true\" name=\"");
+  append_text(request, update.name.data());
+  append_fragment(request, "\" port=\"");
+  append_text(request, update.port.data());
+  append_fragment(request, "\"><position x=\"");
+  append_float(request, update.x_position);
+  append_fragment(request, "\" y=\"");
+  append_float(request, update.y_position);
+  append_fragment(request, "\"/></source>");
 }
 
-void SSR::request::source_model(std::ostream* output, const int source_id, const std::string model)
+void SSR::SSR_requester::append_source_update(std::string& request, const Outbound_update& update)
 {
-  *output << "<source id=\"" << source_id << "\" model=\"" << model << "\"/>";
+  typedef SSR::Update_specificator specificator;
+
+  append_fragment(request, "<source id=\"");
+  append_unsigned(request, update.source_id);
+  append_fragment(request, "\"");
+
+  if (update.changed.contains(specificator::gain)) {
+      append_fragment(request, " volume=\"");
+      append_float(request, update.gain_in_db);
+      append_fragment(request, "\"");
+  }
+
+  if (update.changed.contains(specificator::mute)) {
+      append_fragment(request, " mute=\"");
+      append_bool(request, update.mute);
+      append_fragment(request, "\"");
+  }
+
+  if (update.changed.contains(specificator::model)) {
+
+      if (update.model_point) {
+          append_fragment(request, " model=\"point\"");
+      } else {
+          append_fragment(request, " model=\"plane\"");
+      }
+
+  }
+
+  if (update.changed.contains(specificator::name)) {
+      append_fragment(request, " name=\"");
+      append_text(request, update.name.data());
+      append_fragment(request, "\"");
+  }
+
+  if (update.changed.contains(specificator::properties_file)) {
+      append_fragment(request, " properties_file=\"");
+      append_text(request, update.properties_file.data());
+      append_fragment(request, "\"");
+  }
+
+  if (update.changed.contains(specificator::port)) {
+      append_fragment(request, " port=\"");
+      append_text(request, update.port.data());
+      append_fragment(request, "\"");
+  }
+
+  const bool position = update.changed.contains(specificator::position);
+  const bool fixed = update.changed.contains(specificator::fixed);
+
+  if (!position && !fixed) {
+      append_fragment(request, "/>");
+      return;
+  }
+
+  append_fragment(request, "><position");
+
+  if (position) {
+      append_fragment(request, " x=\"");
+      append_float(request, update.x_position);
+      append_fragment(request, "\" y=\"");
+      append_float(request, update.y_position);
+      append_fragment(request, "\"");
+  }
+
+  if (fixed) {
+      append_fragment(request, " fixed=\"");
+      append_bool(request, update.fixed);
+      append_fragment(request, "\"");
+  }
+
+  append_fragment(request, "/></source>");
 }
 
-void SSR::request::source_name(std::ostream* output, const int source_id, const std::string name)
+void SSR::SSR_requester::append_float(std::string& request, const float value)
 {
-  *output << "<source id=\"" << source_id << "\" name=\"" << name << "\"/>";
+  char text[SSR::number_format::max_float_length];
+  request.append(text, SSR::number_format::write_float(value, text));
 }
 
-void SSR::request::source_properties_file(std::ostream* output, const int source_id, const std::string properties_file)
+void SSR::SSR_requester::append_unsigned(std::string& request, const unsigned int value)
 {
-  *output << "<source id=\"" << source_id << "\" properties_file=\"" << properties_file << "\"/>";
+  char text[SSR::number_format::max_unsigned_length];
+  request.append(text, SSR::number_format::write_unsigned(value, text));
 }
 
-void SSR::request::source_port(std::ostream* output, const int source_id, const std::string port)
+void SSR::SSR_requester::append_bool(std::string& request, const bool value)
 {
-  *output << "<source id=\"" << source_id << "\" port=\"" << port << "\"/>";
+  request.push_back(value ? '1' : '0');
 }
 
-void SSR::request::new_source(std::ostream* output, const std::string name, const std::string port, const float x_position, const float y_position)
+void SSR::SSR_requester::append_text(std::string& request, const char* text)
 {
-  *output << "<source new=\"true\" name=\"" << name << "\" port=\"" << port << "\"><position x=\"" << x_position << "\" y=\"" << y_position << "\"/></source>";
+  for (const char* character = text; *character != '\0'; character++) {
+
+      switch (*character) {
+
+        case '&':
+          append_fragment(request, "&amp;");
+          break;
+
+        case '<':
+          append_fragment(request, "&lt;");
+          break;
+
+        case '>':
+          append_fragment(request, "&gt;");
+          break;
+
+        case '"':
+          append_fragment(request, "&quot;");
+          break;
+
+        default:
+          request.push_back(*character);
+          break;
+
+      }
+
+  }
 }
@@ -12,25 +12,34 @@
  *
  * For more detailed information, please read the license.txt in the root directory.
  */
-
 //C++ Libs
 #include <string>
-#include <sstream>
-#include <functional>
+
+//Own Libs
+#include <src/utils/outbound_update.h>
 
 namespace SSR 
 {
 
   /**
    * With this class you can build XML requests for the SSR.
-   * The class provides a build method which does all the work. Please read the
-   * documentation of `build` for more detailed information how to build XML
-   * requests.
+   *
+   * A request is written into a string owned by the caller, which keeps its
+   * capacity between requests, so encoding does not allocate once the string
+   * has grown to the largest request. The markup around the values is made
+   * of pre-rendered fragments with a size known at compile time, only the
+   * ids, numbers and texts are formatted per request. Numbers are written by
+   * SSR::number_format, in the shortest form which reads back as the same
+   * float and independently of the locale the host has set.
+   *
+   * Use:
+   *
+   * requester.begin(request);
+   * requester.append(request, update);   // once per source
+   * requester.end(request);
    *
    * For more detailed information for SSR requests, please visit:
    * http://ssr.readthedocs.org
-   *
-   * @see build
    **/
   class SSR_requester
   {
@@ -48,190 +57,84 @@ namespace SSR
     ~SSR_requester();
 
     /**
-     * Defines the signature of the build function needed by the method build.
+     * Clears the transferred request, keeping its capacity, and writes the
+     * opening `<request>`.
      *
-     * @see      build           The method which calls this function type.
+     * @param        request     The string the request is written to.
      **/
-    typedef std::function<void(std::ostream* output)> Build_function;
+    void begin(std::string& request) const;
 
     /**
-     * With this Method you can build various SSR requests.
+     * Appends the source element of the transferred update to the request,
+     * either a new source element or one source element carrying all
+     * changed parameters, for example:
      *
-     * Use:
-     * build(std::bind(SSR::request::<function>, std::placeholders::_1, <value1>, ..., <valueN>))
+     * `<source new="true" name="name" port="port"><position x="x" y="y"/></source>`
      *
-     * The transfered function has to have a pointer to an ostream thats why
-     * there is the need for the placeholder.
-     * The method returns the build SSR request always beginning with <request>
-     * and ends with </request>:
+     * `<source id="source_id" volume="gain_in_db" mute="mute"><position x="x" y="y"/></source>`
      *
-     * `<request>INPUT</request>`
+     * Texts are escaped for XML attributes.
      *
-     * @param        fun         A function which has to have an ostream as
-     *                           argument.
+     * @param        request     The string the request is written to.
      *
-     * @return       the build SSR request.
-     **/
-    const std::string build(Build_function bf);
-
-  private:
-
-    /**
-     * The request string stream with which all requests are concatenated.
+     * @param        update      The outbound update which shall be sent to
+     *                           the SSR.
      **/
-    std::stringstream* request_ss;
-
-  };
-
-  namespace request
-  {
+    void append(std::string& request, const Outbound_update& update) const;
 
     /**
-     * This function writes the source position XML request statement into output
-     * as follows:
-     *
-     * `<source id="source_id"><position x="x" y="y"/></source>`
-     *
-     * For more detailed information please visit: http://ssr.readthedocs.org
+     * Writes the closing `</request>`.
      *
-     * @param        output          The stream in which the XML request is
-     *                               written.
-     * @param        source_id       The source ID.
-     * @param        x               The position on the X axis.
-     * @param        y               The position on the Y axis.
+     * @param        request     The string the request is written to.
      **/
-    void source_position(std::ostream* output, const float source_id, const float x, const float y);
+    void end(std::string& request) const;
 
     /**
-     * This function writes the source gain XML request statement into output
-     * as follows:
+     * Builds the complete SSR request for the transferred outbound update.
      *
-     * `<source id="source_id" volume="gain_in_db"/>`
+     * @param        request     The string the request is written to.
      *
-     * For more detailed information please visit: http://ssr.readthedocs.org
-     *
-     * @param        output              The stream in which the XML request is
-     *                                   written.
-     * @param        source_id           The source ID.
-     * @param        gain_in_db          The gain in dB which shall be assigned
-     *                                   to the source.
+     * @param        update      The outbound update which shall be sent to
+     *                           the SSR.
      **/
-    void source_gain(std::ostream* output, const float source_id, const float gain_in_db);
+    void build(std::string& request, const Outbound_update& update) const;
+
+  private:
 
     /**
-     * This function writes the source mute XML request statement into output
-     * as follows:
-     *
-     * `<source id="source_id" mute="mute"/>`
-     *
-     * For more detailed information please visit: http://ssr.readthedocs.org
-     *
-     * @param       output           The stream in which the XML request is
-     *                               written.
-     * @param       source_id        The source ID.
-     * @param       mute             True if the source shall be muted.
+     * Appends the element of a new source.
      **/
-    void source_mute(std::ostream* output, const int source_id, const bool mute);
+    static void append_new_source(std::string& request, const Outbound_update& update);
 
     /**
-     * This function writes the source fixed XML request statement into output
-     * as follows:
-     *
-     * `<source id="source_id"><position fixed="fixed"/></source>`
-     *
-     * For more detailed information please visit: http://ssr.readthedocs.org
-     *
-     * @param       output           The stream in which the XML request is
-     *                               written.
-     * @param       source_id        The source ID.
-     * @param       fixed            True if the source shall be fixed
+     * Appends the element of an existing source carrying all changed
+     * parameters.
      **/
-    void source_fixed(std::ostream* output, const int source_id, const bool fixed);
+    static void append_source_update(std::string& request, const Outbound_update& update);
 
     /**
-     * This function writes the source model XML request statement into output
-     * as follows:
-     *
-     * `<source id="source_id" model="model"/>`
-     *
-     * Possible models are: `"point"` or `"plane"`.
-     * For more detailed information please visit: http://ssr.readthedocs.org
-     *
-     * @param       output           The stream in which the XML request is
-     *                               written.
-     * @param       source_id        The source ID.
-     * @param       model            The model type of the source ("point" or
-     *                               "plane") which shall be assigned.
+     * Appends the shortest round trip representation of the transferred
+     * value.
      **/
-    void source_model(std::ostream* output, const int source_id, const std::string model);
+    static void append_float(std::string& request, const float value);
 
     /**
-     * This function writes the source name XML request statement into output
-     * as follows:
-     *
-     * `<source id="source_id" name="name"/>`
-     *
-     * For more detailed information please visit: http://ssr.readthedocs.org
-     *
-     * @param       output           The stream in which the XML request is
-     *                               written.
-     * @param       source_id        The source ID.
-     * @param       name             The name which shall be assigned to the
-     *                               source
+     * Appends the decimal representation of the transferred value.
      **/
-    void source_name(std::ostream* output, const int source_id, const std::string name);
+    static void append_unsigned(std::string& request, const unsigned int value);
 
     /**
-     * This function writes the properties file XML request statement into output
-     * as follows:
-     *
-     * `<source id="source_id" properties_file="properties_file"/>`
-     *
-     * For more detailed information please visit: http://ssr.readthedocs.org
-     *
-     * @param       output           The stream in which the XML request is
-     *                               written.
-     * @param       source_id        The source ID.
-     * @param       properties_file  The name of the properties file which the
-     *                               source shall use.
+     * Appends the transferred boolean as "1" or "0".
      **/
-    void source_properties_file(std::ostream* output, const int source_id, const std::string properties_file);
+    static void append_bool(std::string& request, const bool value);
 
     /**
-     * This function writes the port XML request statement into output
-     * as follows:
-     *
-     * `<source id="source_id" port="port"/></source>`
-     *
-     * For more detailed information please visit: http://ssr.readthedocs.org
-     *
-     * WARNING: Since this is only possible at the creation of the source, this
-     *          works only one time at the moment (Bug #1778)
-     *
-     * @param       output           The stream in which the XML request is
-     *                               written.
-     * @param       source_id        The source ID.
-     * @param       port             The port with which the source shall be
-     *                               connected with (Jackport).
+     * Appends the transferred null terminated text escaped for a XML
+     * attribute value.
      **/
-    void source_port(std::ostream* output, const int source_id, const std::string port) ;
+    static void append_text(std::string& request, const char* text);
 
-    /**
-     * This function writes the new source XML request statement into output as
-     * follows:
-     *
-     * `<source new="true" name="<name>" port="<port>"><position x="<x_position>" y="y_position"></source>"`
-     *
-     * @param           output          The stream in which the XML request is
-     *                                  written.
-     * @param           name            The new name of the source.
-     * @param           port            The Jackport on with which the source shall connect to.
-     * @param           x_position      The initial position on the x axis of the new source.
-     * @param           y_position      The initial position on the y axis of the new source.
-     */
-    void new_source(std::ostream* output, const std::string name, const std::string port, const float x_position, const float y_position);
-
-  }
+  };
 
 }
 
@@ -0,0 +1,45 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/startup_thread.h>
+
+//C++ Libs
+#include <utility>
+
+//============================================================================
+// PUBLIC
+
+SSR::Startup_thread::Startup_thread(std::function<void()> task)
+: juce::Thread("SSR Startup")
+, task(std::move(task))
+, done(false)
+{
+
+}
+
+SSR::Startup_thread::~Startup_thread()
+{
+  // The task can not be interrupted (the JACK registration blocks), so wait
+  // for it instead of killing the thread.
+  waitForThreadToExit(-1);
+}
+
+bool SSR::Startup_thread::is_done() const
+{
+  return done;
+}
+
+void SSR::Startup_thread::run()
+{
+  task();
+  done = true;
+}
@@ -0,0 +1,78 @@
+#ifndef STARTUP_THREAD_H
+#define STARTUP_THREAD_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <atomic>
+#include <functional>
+
+//JUCE Lib
+#include <JUCE/JuceHeader.h>
+
+namespace SSR
+{
+
+  /**
+   * This class runs the slow part of the plugin initialisation (loading the
+   * config, handing the connection to the network thread and registering at
+   * the JACK server) once in the background, so the constructor of the
+   * plugin returns to the host immediately.
+   */
+  class Startup_thread : public juce::Thread
+  {
+
+  public:
+
+    /**
+     * Constructor.
+     *
+     * @param     task            The initialisation which shall run in the
+     *                            background.
+     */
+    Startup_thread(std::function<void()> task);
+
+    /**
+     * Destructor waiting for the task to finish.
+     */
+    ~Startup_thread();
+
+    /**
+     * Returns true once the task has finished.
+     *
+     * @return true once the task has finished.
+     */
+    bool is_done() const;
+
+    /**
+     * Runs the task once.
+     */
+    void run() override;
+
+  private:
+
+    /**
+     * The initialisation task.
+     */
+    std::function<void()> task;
+
+    /**
+     * True once the task has finished.
+     */
+    std::atomic<bool> done;
+
+  };
+
+}
+
+#endif
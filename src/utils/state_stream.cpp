@@ -0,0 +1,84 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/state_stream.h>
+
+//C++ Libs
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+
+  void require(juce::InputStream& input, const juce::int64 bytes)
+  {
+    if (input.getNumBytesRemaining() < bytes) {
+        throw std::runtime_error("Plugin state is truncated!");
+    }
+  }
+
+}
+
+void SSR::state_stream::write_string(juce::OutputStream& output, const std::string& value)
+{
+  const std::size_t length = std::min<std::size_t>(value.size(), 0xffff);
+
+  output.writeShort(static_cast<short>(length));
+  output.write(value.data(), length);
+}
+
+std::string SSR::state_stream::read_string(juce::InputStream& input)
+{
+  require(input, 2);
+  const std::size_t length = static_cast<unsigned short>(input.readShort());
+
+  require(input, static_cast<juce::int64>(length));
+  std::string value(length, '\0');
+
+  if (length > 0) {
+      input.read(&value[0], static_cast<int>(length));
+  }
+
+  return value;
+}
+
+juce::uint32 SSR::state_stream::read_uint32(juce::InputStream& input)
+{
+  require(input, 4);
+  return static_cast<juce::uint32>(input.readInt());
+}
+
+float SSR::state_stream::read_float(juce::InputStream& input)
+{
+  require(input, 4);
+  return input.readFloat();
+}
+
+double SSR::state_stream::read_double(juce::InputStream& input)
+{
+  require(input, 8);
+  return input.readDouble();
+}
+
+bool SSR::state_stream::read_bool(juce::InputStream& input)
+{
+  require(input, 1);
+  return input.readBool();
+}
+
+juce::uint32 SSR::state_stream::read_count(juce::InputStream& input, const std::size_t element_size)
+{
+  const juce::uint32 count = read_uint32(input);
+  require(input, static_cast<juce::int64>(count) * static_cast<juce::int64>(element_size));
+
+  return count;
+}
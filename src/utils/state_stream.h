@@ -0,0 +1,117 @@
+#ifndef STATE_STREAM_H
+#define STATE_STREAM_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <string>
+
+//JUCE Lib
+#include <JUCE/JuceHeader.h>
+
+namespace SSR
+{
+
+  /**
+   * Reading and writing of the binary plugin state.
+   *
+   * The state chunk starts with the magic number and the version, followed
+   * by the sections of the scene, the parameter bank and the trajectories.
+   * All numbers are little endian (as written by juce::OutputStream),
+   * strings are a 16 bit length followed by UTF-8 bytes.
+   *
+   * The read functions check the remaining bytes first and throw a
+   * runtime_error if the state is truncated, so a damaged chunk is never
+   * read past its end.
+   */
+  namespace state_stream
+  {
+
+    /**
+     * "SSRS" as little endian number.
+     */
+    static const juce::uint32 magic = 0x53525353;
+
+    /**
+     * The version written by this build. Readers reject newer versions.
+     */
+    static const juce::uint32 version = 1;
+
+    /**
+     * Writes the transferred string, truncated to 65535 bytes.
+     *
+     * @param     output          The stream which shall be written to.
+     *
+     * @param     value           The string which shall be written.
+     */
+    void write_string(juce::OutputStream& output, const std::string& value);
+
+    /**
+     * Reads a string written by write_string.
+     *
+     * @param     input           The stream which shall be read from.
+     *
+     * @return    the string.
+     *
+     * @throws    runtime_error   If the state is truncated.
+     */
+    std::string read_string(juce::InputStream& input);
+
+    /**
+     * Reads an unsigned 32 bit number.
+     *
+     * @throws    runtime_error   If the state is truncated.
+     */
+    juce::uint32 read_uint32(juce::InputStream& input);
+
+    /**
+     * Reads a float.
+     *
+     * @throws    runtime_error   If the state is truncated.
+     */
+    float read_float(juce::InputStream& input);
+
+    /**
+     * Reads a double.
+     *
+     * @throws    runtime_error   If the state is truncated.
+     */
+    double read_double(juce::InputStream& input);
+
+    /**
+     * Reads a boolean.
+     *
+     * @throws    runtime_error   If the state is truncated.
+     */
+    bool read_bool(juce::InputStream& input);
+
+    /**
+     * Reads a count of elements of at least element_size bytes each and
+     * checks it against the remaining bytes, so a damaged count cannot
+     * trigger a huge allocation.
+     *
+     * @param     input           The stream which shall be read from.
+     *
+     * @param     element_size    The minimum size of one element in bytes.
+     *
+     * @return    the count.
+     *
+     * @throws    runtime_error   If the state is truncated.
+     */
+    juce::uint32 read_count(juce::InputStream& input, const std::size_t element_size);
+
+  }
+
+}
+
+#endif
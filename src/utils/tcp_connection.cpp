@@ -14,14 +14,19 @@
 
 //C++ Libs
 #include <string>
-#include <sstream>
-#include <array>
 #include <functional>
 
+#if JUCE_LINUX
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
 //Own Libs
 #include <src/utils/iconnection.h>
-#include <src/controller.h>
+#include <src/utils/frame_reader.h>
 #include <src/utils/logger.h>
+#include <src/utils/metrics.h>
 
 //JUCE Lib
 #include <JUCE/JuceHeader.h>
@@ -33,23 +38,13 @@ SSR::TCP_connection::TCP_connection(const std::string hostname, const int port,
 : hostname(hostname)
 , port(port)
 , timeout(timeout)
-, end_of_message(end_of_message)
-, buffer_index(0)
-, ss(new std::stringstream(std::string()))
-, new_message_available(false)
+, frame_reader(end_of_message)
 {
 
-  /**
-   * Initially fill the incoming_message_buffer with the EOT (end of transmission)
-   * character.
-   **/
-  std::fill(incoming_message_buffer.begin(), incoming_message_buffer.end(), 0x04);
 }
 
 SSR::TCP_connection::~TCP_connection()
 {
-  delete ss;
-
   /**
    * Dont have to check whether the streaming socket is allready closed this is
    * managed by the StreamingSocket class itself.
@@ -59,6 +54,8 @@ SSR::TCP_connection::~TCP_connection()
 
 bool SSR::TCP_connection::connect()
 {
+  frame_reader.clear();
+
   return ss_connection.connect(hostname, port, timeout);
 }
 
@@ -73,14 +70,16 @@ void SSR::TCP_connection::disconnect()
 
 bool SSR::TCP_connection::get_message(std::shared_ptr<std::string> new_message, int* wait_in_msec)
 {
-  read_message(wait_in_msec);
+  SSR::Frame frame;
+
+  bool new_message_available = get_frame(frame, wait_in_msec);
 
   if (new_message_available) {
-      *new_message = ss->str();
+      new_message->assign(frame.data, frame.size);
 
 #if DEBUG_TCP_IN
 
-      SSR::Logger::get_instance()->log(SSR::Logger::Level::INFO, "[TCP IN]: " + *new_message, true);
+      SSR::Logger::get_instance()->log(SSR::Logger::Level::info, "[TCP IN]: " + *new_message, true);
 
 #endif
 
@@ -89,6 +88,21 @@ bool SSR::TCP_connection::get_message(std::shared_ptr<std::string> new_message,
   return new_message_available;
 }
 
+bool SSR::TCP_connection::get_frame(SSR::Frame& frame, int* wait_in_msec)
+{
+  while (!frame_reader.next_frame(frame)) {
+
+      if (!load_buffer(wait_in_msec)) {
+          return false;
+      }
+
+  }
+
+  SSR::Metrics::get_instance().add(SSR::Metrics::messages_received);
+
+  return true;
+}
+
 bool SSR::TCP_connection::send_message(const std::shared_ptr<std::string> message_to_send, int wait_in_msec)
 {
   /**
@@ -102,11 +116,17 @@ bool SSR::TCP_connection::send_message(const std::shared_ptr<std::string> messag
 
 #if DEBUG_TCP_OUT
 
-      SSR::Logger::get_instance()->log(SSR::Logger::Level::INFO, "[TCP OUT]: " + *message_to_send, true);
+      SSR::Logger::get_instance()->log(SSR::Logger::Level::info, "[TCP OUT]: " + *message_to_send, true);
 
 #endif
 
-      ss_connection.write(message_to_send->c_str(), message_to_send->length() + 1);
+      const int bytes_written = ss_connection.write(message_to_send->c_str(), message_to_send->length() + 1);
+
+      if (bytes_written > 0) {
+          SSR::Metrics& metrics = SSR::Metrics::get_instance();
+          metrics.add(SSR::Metrics::messages_sent);
+          metrics.add(SSR::Metrics::bytes_sent, static_cast<unsigned long long>(bytes_written));
+      }
   }
 
   return (ec == 1);
@@ -117,66 +137,33 @@ bool SSR::TCP_connection::is_connected() const
   return ss_connection.isConnected();
 }
 
-//============================================================================
-// PRIVATE
-
-void SSR::TCP_connection::read_message(int* wait_in_msec)
+double SSR::TCP_connection::get_transport_round_trip_in_msec() const
 {
-  bool load_buffer_successful = true;
-  new_message_available = false;
-  int tmp_index = buffer_index;
+#if JUCE_LINUX
 
-  /**
-   * Clear the content of the string stream as described:
-   * m.str(std::string()) -> is technically more efficient,
-   * because you avoid invoking the "std::string" constructor that takes
-   * "const char*"
-   *
-   * http://stackoverflow.com/questions/20731/in-c-how-do-you-clear-a-stringstream-variable
-   **/
-  ss->str(std::string());
-
-  do {
-
-      if (tmp_index == incoming_message_buffer.size()) {
-          load_buffer_successful = load_buffer(wait_in_msec);
-          tmp_index = 0x00;
-      }
-
-      if (load_buffer_successful) {
-
-          while (tmp_index < incoming_message_buffer.size() && !new_message_available) {
-
-              if (incoming_message_buffer[tmp_index] != end_of_message && incoming_message_buffer[tmp_index] != 0x04) {
-                  (*ss) << incoming_message_buffer[tmp_index];
-                  tmp_index++;
-              } else {
-
-                  if (incoming_message_buffer[tmp_index] == 0x04) {
-                      tmp_index = incoming_message_buffer.size();
-                      new_message_available = false;
-                  } else {
-                      new_message_available = true;
-                      tmp_index++;
-                  }
-
-
-              }
+  if (!ss_connection.isConnected()) {
+      return -1.0;
+  }
 
-          }
+  struct tcp_info info;
+  socklen_t length = sizeof(info);
 
-      }
+  if (getsockopt(ss_connection.getRawSocketHandle(), IPPROTO_TCP, TCP_INFO, &info, &length) != 0) {
+      return -1.0;
+  }
 
-  } while (load_buffer_successful && !new_message_available);
+  return info.tcpi_rtt / 1000.0;
 
-  if (!new_message_available) {
-      tmp_index = incoming_message_buffer.size();
-  }
+#else
 
-  buffer_index = tmp_index;
+  return -1.0;
 
+#endif
 }
 
+//============================================================================
+// PRIVATE
+
 bool SSR::TCP_connection::load_buffer(int* wait_in_msec) {
 
   //wait until socket is ready, waits until time_out_in_msec, moer on SocketStream
@@ -185,20 +172,30 @@ bool SSR::TCP_connection::load_buffer(int* wait_in_msec) {
 
   if (ready_flag == 1) {
 
-      //Fill the array with 0x04 == end of transmission
-      std::fill(incoming_message_buffer.begin(), incoming_message_buffer.end(), 0x04);
+      std::size_t available = 0;
+      char* destination = frame_reader.prepare_write(available);
+
+      int bytes_read = ss_connection.read(destination, static_cast<int>(available), false);
+
+      if (bytes_read > 0) {
+          frame_reader.commit(static_cast<std::size_t>(bytes_read));
+          SSR::Metrics::get_instance().add(SSR::Metrics::bytes_received, static_cast<unsigned long long>(bytes_read));
+          return true;
+      }
 
-      int bytes_read = ss_connection.read(   	&incoming_message_buffer,
-                                             	incoming_message_buffer.size(),
-                                             	false);
+      //Ready for reading but nothing to read means the host closed the connection
+      SSR::Logger::get_instance()->log(SSR::Logger::Level::error, "TCP/IP connection closed by host", true);
+      ss_connection.close();
 
   } else {
 
     if (ready_flag == -1) {
-        SSR::Logger::get_instance()->log(SSR::Logger::Level::ERROR, "TCP/IP connection error occurred", true);
+        //Close the broken socket, the network thread then reconnects
+        SSR::Logger::get_instance()->log(SSR::Logger::Level::error, "TCP/IP connection error occurred", true);
+        ss_connection.close();
     }
 
   }
 
-  return (ready_flag == 1);
+  return false;
 }
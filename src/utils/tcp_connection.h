@@ -15,12 +15,11 @@
 
 //C++ Libs
 #include <string>
-#include <sstream>
-#include <array>
 #include <memory>
 
 //Own Libs
 #include <src/utils/iconnection.h>
+#include <src/utils/frame_reader.h>
 
 //JUCE Lib
 #include <JUCE/JuceHeader.h>
@@ -97,6 +96,23 @@ public:
 	**/
 	virtual bool get_message(std::shared_ptr<std::string> new_message, int* wait_in_msec);
 
+	/**
+	* This method gets the next complete message from the host as a view
+	* into the receive buffer, without copying it.
+	*
+	* @param        frame 		Will be set to the received message without
+	* 				the character representing the end of the
+	* 				message. Valid until the next call of
+	* 				get_frame or get_message.
+	*
+	* @param 	wait_in_msec 	The time in milliseconds waiting for a
+	*				message to come in.
+	*
+	* @return 			true if there is a new message, otherwise
+	*				false.
+	**/
+	virtual bool get_frame(SSR::Frame& frame, int* wait_in_msec);
+
 	/**
 	* This method sends the transfered message_to_send to the host.
 	*
@@ -124,23 +140,25 @@ public:
 	**/
 	virtual bool is_connected() const;
 
-private:
-
 	/**
-	* This method reads the incoming message.
-	* 
-	* @param 	wait_in_msec 	The time in milliseconds waiting for a
-	*				message to come in.
+	* This method returns the smoothed round trip time the TCP stack measured
+	* for this connection (TCP_INFO on Linux).
 	*
+	* @return       the round trip time in milliseconds, negative if it is not
+	*               connected or the platform does not tell.
 	**/
-	void read_message(int* wait_in_msec);
+	virtual double get_transport_round_trip_in_msec() const;
+
+private:
 
 	/**
-	* This methods loads the incoming_message_buffer with new messages coming
-	* from the host.
+	* This methods reads as many bytes as the socket has ready (with a single
+	* read) directly into the frame reader.
 	*
 	* @param 	wait_in_msec 	The time in milliseconds waiting for a
 	*                               message to come in.
+	*
+	* @return 			true if any bytes were read, false otherwise.
 	**/
 	bool load_buffer(int* wait_in_msec);
 
@@ -161,36 +179,16 @@ private:
 	 **/
 	int timeout;
 
-	/**
-	 * The character representing the end of a message of incoming messages.
-	 **/
-	char end_of_message;
-
-	/**
-	 * Stringstream for incoming messages handling.
-	 **/
-	std::stringstream* ss;
-
 	/**
 	 * JUCE StreamingSocket object which does all the basic socket work.
 	 **/
 	StreamingSocket ss_connection;
 
 	/**
-	 * Represents if there is a new message available from the host or not.
-	 **/
-	bool new_message_available;
-
-	/**
-	 * Index for the incoming_message_buffer which is needed to work with
-	 * it more efficient.
-	 **/
-	int buffer_index;
-
-	/**
-	 * The buffer which is used for the incoming messages limited to 128 chars.
+	 * Ring buffer splitting the incoming bytes into messages, separated by the
+	 * end of message character.
 	 **/
-	std::array<char, 128> incoming_message_buffer;
+	SSR::Frame_reader frame_reader;
 	
 };
 
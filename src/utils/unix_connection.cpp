@@ -0,0 +1,250 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/unix_connection.h>
+
+//C++ Libs
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+//POSIX
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+//Own Libs
+#include <src/utils/iconnection.h>
+#include <src/utils/frame_reader.h>
+#include <src/utils/logger.h>
+#include <src/utils/metrics.h>
+
+//============================================================================
+// PUBLIC
+
+SSR::Unix_connection::Unix_connection(const std::string socket_path, const int timeout, const char end_of_message)
+: socket_path(socket_path)
+, timeout(timeout)
+, socket_handle(-1)
+, frame_reader(end_of_message)
+{
+
+}
+
+SSR::Unix_connection::~Unix_connection()
+{
+  disconnect();
+}
+
+bool SSR::Unix_connection::connect()
+{
+  disconnect();
+  frame_reader.clear();
+
+  struct sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+
+  if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+      SSR::Logger::get_instance()->log(SSR::Logger::Level::error, "Invalid Unix socket path: " + socket_path, true);
+      return false;
+  }
+
+  std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+  socket_handle = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+
+  if (socket_handle < 0) {
+      return false;
+  }
+
+  if (::connect(socket_handle, reinterpret_cast<const struct sockaddr*>(&address), sizeof(address)) == 0) {
+      return true;
+  }
+
+  // A full backlog of the listener lets the connect wait, like a TCP
+  // handshake.
+  if ((errno == EINPROGRESS || errno == EAGAIN) && wait_until_ready(POLLOUT, timeout) == 1) {
+
+      int error = 0;
+      socklen_t length = sizeof(error);
+
+      if (getsockopt(socket_handle, SOL_SOCKET, SO_ERROR, &error, &length) == 0 && error == 0) {
+          return true;
+      }
+
+  }
+
+  disconnect();
+
+  return false;
+}
+
+void SSR::Unix_connection::disconnect()
+{
+  if (socket_handle >= 0) {
+      ::close(socket_handle);
+      socket_handle = -1;
+  }
+}
+
+bool SSR::Unix_connection::get_message(std::shared_ptr<std::string> new_message, int* wait_in_msec)
+{
+  SSR::Frame frame;
+
+  bool new_message_available = get_frame(frame, wait_in_msec);
+
+  if (new_message_available) {
+      new_message->assign(frame.data, frame.size);
+  }
+
+  return new_message_available;
+}
+
+bool SSR::Unix_connection::get_frame(SSR::Frame& frame, int* wait_in_msec)
+{
+  while (!frame_reader.next_frame(frame)) {
+
+      if (!load_buffer(wait_in_msec)) {
+          return false;
+      }
+
+  }
+
+  SSR::Metrics::get_instance().add(SSR::Metrics::messages_received);
+
+  return true;
+}
+
+bool SSR::Unix_connection::send_message(const std::shared_ptr<std::string> message_to_send, int wait_in_msec)
+{
+  if (socket_handle < 0) {
+      return false;
+  }
+
+  // The terminating null character is the end of message of the SSR.
+  const char* data = message_to_send->c_str();
+  std::size_t remaining = message_to_send->length() + 1;
+
+  while (remaining > 0) {
+
+      const int ready_flag = wait_until_ready(POLLOUT, wait_in_msec);
+
+      if (ready_flag != 1) {
+
+          if (ready_flag == -1) {
+              close_after_error("Unix socket error occurred");
+          }
+
+          return false;
+      }
+
+      const ssize_t bytes_written = ::send(socket_handle, data, remaining, MSG_NOSIGNAL);
+
+      if (bytes_written < 0) {
+
+          if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+              continue;
+          }
+
+          close_after_error("Unix socket closed by host");
+          return false;
+      }
+
+      data += bytes_written;
+      remaining -= static_cast<std::size_t>(bytes_written);
+  }
+
+  SSR::Metrics& metrics = SSR::Metrics::get_instance();
+  metrics.add(SSR::Metrics::messages_sent);
+  metrics.add(SSR::Metrics::bytes_sent, message_to_send->length() + 1);
+
+  return true;
+}
+
+bool SSR::Unix_connection::is_connected() const
+{
+  return socket_handle >= 0;
+}
+
+//============================================================================
+// PRIVATE
+
+bool SSR::Unix_connection::load_buffer(int* wait_in_msec)
+{
+  const int ready_flag = wait_until_ready(POLLIN, *wait_in_msec);
+
+  if (ready_flag == 1) {
+
+      std::size_t available = 0;
+      char* destination = frame_reader.prepare_write(available);
+
+      const ssize_t bytes_read = ::read(socket_handle, destination, available);
+
+      if (bytes_read > 0) {
+          frame_reader.commit(static_cast<std::size_t>(bytes_read));
+          SSR::Metrics::get_instance().add(SSR::Metrics::bytes_received, static_cast<unsigned long long>(bytes_read));
+          return true;
+      }
+
+      if (bytes_read < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+          return false;
+      }
+
+      //Ready for reading but nothing to read means the host closed the connection
+      close_after_error("Unix socket closed by host");
+
+  } else if (ready_flag == -1) {
+      //Close the broken socket, the network thread then reconnects
+      close_after_error("Unix socket error occurred");
+  }
+
+  return false;
+}
+
+int SSR::Unix_connection::wait_until_ready(const short events, const int wait_in_msec) const
+{
+  if (socket_handle < 0) {
+      return -1;
+  }
+
+  struct pollfd descriptor;
+  descriptor.fd = socket_handle;
+  descriptor.events = events;
+  descriptor.revents = 0;
+
+  const int result = ::poll(&descriptor, 1, wait_in_msec);
+
+  if (result < 0) {
+      return (errno == EINTR) ? 0 : -1;
+  }
+
+  if (result == 0) {
+      return 0;
+  }
+
+  // A hang up still lets the pending bytes be read, the following read then
+  // returns 0.
+  if (descriptor.revents & (POLLERR | POLLNVAL)) {
+      return -1;
+  }
+
+  return 1;
+}
+
+void SSR::Unix_connection::close_after_error(const char* reason)
+{
+  SSR::Logger::get_instance()->log(SSR::Logger::Level::error, reason, true);
+  disconnect();
+}
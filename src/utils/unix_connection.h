@@ -0,0 +1,187 @@
+#ifndef UNIX_CONNECTION_H
+#define UNIX_CONNECTION_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <string>
+#include <memory>
+
+//Own Libs
+#include <src/utils/iconnection.h>
+#include <src/utils/frame_reader.h>
+
+namespace SSR {
+
+/**
+* This class represents a client connection over a Unix domain socket (a
+* stream socket bound to a path in the file system).
+*
+* If the SSR runs on the same machine as the DAW, this connection skips the
+* TCP stack of the loopback device and with it Nagle's algorithm and delayed
+* acknowledgements. The SSR itself listens on TCP only, so the socket path is
+* usually provided by a local bridge such as socat (see the README).
+*
+* Messages are framed like on the TCP_connection: each one ends with the
+* end_of_message character.
+**/
+class Unix_connection : public SSR::IConnection
+{
+
+public:
+
+	/**
+	* This constructor needs the path of the socket, a timeout for the
+	* connect() method and the end_of_message char for incoming messages.
+	*
+	* @param        socket_path     The path of the socket in the file
+	*				system.
+	*
+	* @param 	timeout 	Timeout in milliseconds when trying to
+	* 				connect.
+	*
+	* @param 	end_of_message 	The char that represents the end of a
+	* 				message when receiving a message.
+	**/
+	Unix_connection(const std::string socket_path, const int timeout, const char end_of_message);
+
+	/**
+	* Deconstructor which also disconnects if not already done.
+	**/
+	virtual ~Unix_connection();
+
+	/**
+	* This method connects to the socket transfered by creating this object.
+	*
+	* @return 		true if the connection was succesfull, false otherwise.
+	**/
+	virtual bool connect();
+
+	/**
+	* This method closes the socket if it is open.
+	**/
+	virtual void disconnect();
+
+	/**
+	* This method gets a message which ends with the transfered parameter
+	* end_of_message by creating this object.
+	*
+	* @param        new_message 	The received message without the
+	* 				character representing the end of the
+	* 				message.
+	*
+	* @param 	wait_in_msec 	The time in milliseconds waiting for a
+	*				message to come in.
+	*
+	* @return 			true if there is a new message, otherwise
+	*				false.
+	**/
+	virtual bool get_message(std::shared_ptr<std::string> new_message, int* wait_in_msec);
+
+	/**
+	* This method gets the next complete message as a view into the receive
+	* buffer, without copying it.
+	*
+	* @param        frame 		Will be set to the received message without
+	* 				the character representing the end of the
+	* 				message. Valid until the next call of
+	* 				get_frame or get_message.
+	*
+	* @param 	wait_in_msec 	The time in milliseconds waiting for a
+	*				message to come in.
+	*
+	* @return 			true if there is a new message, otherwise
+	*				false.
+	**/
+	virtual bool get_frame(SSR::Frame& frame, int* wait_in_msec);
+
+	/**
+	* This method sends the transfered message_to_send including the
+	* terminating null character.
+	*
+	* @param 	message_to_send 	The message that will be sent.
+	*
+	* @param 	wait_in_msec 		The time in milliseconds waiting for the
+	* 					socket being ready to send.
+	*
+	* @return true if the whole message was sent, false otherwise.
+	**/
+	virtual bool send_message(const std::shared_ptr<std::string> message_to_send, int wait_in_msec);
+
+	/**
+	* This method returns true if the socket is open. Like on the
+	* TCP_connection, a closed peer is only noticed when reading or writing.
+	*
+	* @return       true if the socket is open, otherwise false.
+	**/
+	virtual bool is_connected() const;
+
+private:
+
+	/**
+	* This methods reads as many bytes as the socket has ready (with a single
+	* read) directly into the frame reader.
+	*
+	* @param 	wait_in_msec 	The time in milliseconds waiting for a
+	*                               message to come in.
+	*
+	* @return 			true if any bytes were read, false otherwise.
+	**/
+	bool load_buffer(int* wait_in_msec);
+
+	/**
+	* This method waits until the socket is ready for the transfered events.
+	*
+	* @param 	events 		The poll events to wait for.
+	*
+	* @param 	wait_in_msec 	The time in milliseconds to wait at most.
+	*
+	* @return 			1 if ready, 0 on timeout, -1 on error.
+	**/
+	int wait_until_ready(const short events, const int wait_in_msec) const;
+
+	/**
+	* This method closes the socket after an error.
+	*
+	* @param 	reason 		The text which is logged.
+	**/
+	void close_after_error(const char* reason);
+
+private:
+
+	/**
+	 * The path of the socket.
+	 **/
+	std::string socket_path;
+
+	/**
+	 * The timeout in milliseconds waiting for the connection to be accepted.
+	 **/
+	int timeout;
+
+	/**
+	 * The file descriptor of the socket, -1 if it is closed.
+	 **/
+	int socket_handle;
+
+	/**
+	 * Ring buffer splitting the incoming bytes into messages, separated by the
+	 * end of message character.
+	 **/
+	SSR::Frame_reader frame_reader;
+
+};
+
+}
+
+#endif
@@ -0,0 +1,200 @@
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+#include <src/utils/update_coalescer.h>
+
+//C++ Libs
+#include <string>
+#include <functional>
+
+//Own Libs
+#include <src/utils/update_specificator.h>
+
+//============================================================================
+// PUBLIC
+
+SSR::Update_coalescer::Update_coalescer()
+: added_updates(0)
+, flushed_elements(0)
+{
+
+}
+
+SSR::Update_coalescer::~Update_coalescer()
+{
+
+}
+
+void SSR::Update_coalescer::add(const Outbound_update& update)
+{
+  typedef SSR::Update_specificator specificator;
+
+  added_updates++;
+
+  if (update.changed.contains(specificator::new_source)) {
+      new_sources.push_back(update);
+      return;
+  }
+
+  std::unordered_map<unsigned int, std::size_t>::iterator found = entry_index.find(update.source_id);
+
+  if (found == entry_index.end()) {
+      found = entry_index.insert(std::make_pair(update.source_id, entries.size())).first;
+      entries.push_back(update);
+      entries.back().changed.clear();
+  }
+
+  Outbound_update& entry = entries[found->second];
+
+  // The entry waits since the oldest change merged into it.
+  if (entry.changed.empty()) {
+      dirty_entries.push_back(found->second);
+      entry.queued_in_msec = update.queued_in_msec;
+  }
+
+  entry.changed.add(update.changed);
+
+  if (update.changed.contains(specificator::position)) {
+      entry.x_position = update.x_position;
+      entry.y_position = update.y_position;
+  }
+
+  if (update.changed.contains(specificator::gain)) {
+      entry.gain_in_db = update.gain_in_db;
+  }
+
+  if (update.changed.contains(specificator::mute)) {
+      entry.mute = update.mute;
+  }
+
+  if (update.changed.contains(specificator::fixed)) {
+      entry.fixed = update.fixed;
+  }
+
+  if (update.changed.contains(specificator::model)) {
+      entry.model_point = update.model_point;
+  }
+
+  if (update.changed.contains(specificator::name)) {
+      entry.name = update.name;
+  }
+
+  if (update.changed.contains(specificator::port)) {
+      entry.port = update.port;
+  }
+
+  if (update.changed.contains(specificator::properties_file)) {
+      entry.properties_file = update.properties_file;
+  }
+}
+
+bool SSR::Update_coalescer::has_pending() const
+{
+  return !dirty_entries.empty() || !new_sources.empty();
+}
+
+bool SSR::Update_coalescer::flush(const SSR::SSR_requester& requester, std::string& request)
+{
+  if (!has_pending()) {
+      return false;
+  }
+
+  requester.begin(request);
+  write_elements(requester, request);
+  requester.end(request);
+
+  return true;
+}
+
+void SSR::Update_coalescer::for_each_pending(const std::function<void(const Outbound_update&)>& visit) const
+{
+  for (const Outbound_update& update : new_sources) {
+      visit(update);
+  }
+
+  for (std::size_t index : dirty_entries) {
+      visit(entries[index]);
+  }
+}
+
+std::size_t SSR::Update_coalescer::discard_in_sync(const std::function<SSR::Update_specificator(const Outbound_update&)>& in_sync)
+{
+  std::size_t discarded = 0;
+  std::size_t kept = 0;
+
+  for (std::size_t index : dirty_entries) {
+
+      Outbound_update& entry = entries[index];
+      const SSR::Update_specificator fields = in_sync(entry);
+
+      for (int field = 0; field < SSR::Update_specificator::specificator_count; field++) {
+
+          const SSR::Update_specificator::Specificators specificator = static_cast<SSR::Update_specificator::Specificators>(field);
+
+          if (fields.contains(specificator) && entry.changed.contains(specificator)) {
+              entry.changed.remove(specificator);
+              discarded++;
+          }
+
+      }
+
+      if (!entry.changed.empty()) {
+          dirty_entries[kept++] = index;
+      }
+
+  }
+
+  dirty_entries.resize(kept);
+
+  return discarded;
+}
+
+SSR::Update_specificator SSR::Update_coalescer::get_pending(const unsigned int source_id) const
+{
+  std::unordered_map<unsigned int, std::size_t>::const_iterator found = entry_index.find(source_id);
+
+  if (found == entry_index.end()) {
+      return SSR::Update_specificator();
+  }
+
+  return entries[found->second].changed;
+}
+
+unsigned long SSR::Update_coalescer::get_added_updates() const
+{
+  return added_updates;
+}
+
+unsigned long SSR::Update_coalescer::get_flushed_elements() const
+{
+  return flushed_elements;
+}
+
+//============================================================================
+// PRIVATE
+
+void SSR::Update_coalescer::write_elements(const SSR::SSR_requester& requester, std::string& request)
+{
+  for (const Outbound_update& update : new_sources) {
+      requester.append(request, update);
+  }
+
+  for (std::size_t index : dirty_entries) {
+      requester.append(request, entries[index]);
+      entries[index].changed.clear();
+  }
+
+  flushed_elements += new_sources.size() + dirty_entries.size();
+
+  new_sources.clear();
+  dirty_entries.clear();
+}
@@ -0,0 +1,176 @@
+#ifndef UPDATE_COALESCER_H
+#define UPDATE_COALESCER_H
+
+/**
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+ *
+ * Copyright © 2015
+ * Quality and Usability Lab
+ * Berlin Institute of Technology
+ * http://www.qu.tu-berlin.de
+ *
+ * For more detailed information, please read the license.txt in the root directory.
+ */
+
+//C++ Libs
+#include <functional>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+//Own Libs
+#include <src/utils/outbound_update.h>
+#include <src/utils/ssr_requester.h>
+
+namespace SSR
+{
+
+  /**
+   * This class merges outbound updates until they are flushed.
+   *
+   * Per source it keeps the latest value of every changed field together with
+   * a dirty set (the Update_specificator) naming those fields. A flush renders
+   * one SSR request containing one source element per dirty source which
+   * carries all its changed parameters, so for example the X and Y automation
+   * lanes of one tick end up in a single position element.
+   *
+   * New source requests are not merged, they are sent in the order they were
+   * added.
+   *
+   * The class is not thread safe, it is used by the network thread only.
+   */
+  class Update_coalescer
+  {
+
+  public:
+
+    /**
+     * Constructor.
+     */
+    Update_coalescer();
+
+    /**
+     * Destructor.
+     */
+    ~Update_coalescer();
+
+    /**
+     * Merges the transferred update into the pending changes of its source.
+     *
+     * @param     update          The update which shall be merged.
+     */
+    void add(const Outbound_update& update);
+
+    /**
+     * Returns true if there are pending changes.
+     *
+     * @return true if there are pending changes.
+     */
+    bool has_pending() const;
+
+    /**
+     * Builds one SSR request containing all pending changes and clears them.
+     *
+     * @param     requester       The requester building the request.
+     *
+     * @param     request         The string the request shall be written to.
+     *
+     * @return    true if there were pending changes and request was set,
+     *            false otherwise.
+     */
+    bool flush(const SSR::SSR_requester& requester, std::string& request);
+
+    /**
+     * Calls the transferred function for every pending new source and every
+     * pending merged update, in the order a flush would send them.
+     *
+     * @param     visit           The function called per pending update.
+     */
+    void for_each_pending(const std::function<void(const Outbound_update&)>& visit) const;
+
+    /**
+     * Removes the pending fields which the SSR already has, for example after
+     * a reconnect when the SSR has sent its scene again. New sources are
+     * always kept.
+     *
+     * @param     in_sync         Returns the fields of the transferred
+     *                            pending update which need not be sent.
+     *
+     * @return    the number of removed fields.
+     */
+    std::size_t discard_in_sync(const std::function<SSR::Update_specificator(const Outbound_update&)>& in_sync);
+
+    /**
+     * Returns the pending fields of the transferred source.
+     *
+     * @param     source_id       The id of the source.
+     *
+     * @return    the fields which will be sent with the next flush, empty if
+     *            the source has no pending changes.
+     */
+    SSR::Update_specificator get_pending(const unsigned int source_id) const;
+
+    /**
+     * Returns the number of updates added so far.
+     *
+     * @return the number of updates added so far.
+     */
+    unsigned long get_added_updates() const;
+
+    /**
+     * Returns the number of source elements flushed so far.
+     *
+     * @return the number of source elements flushed so far.
+     */
+    unsigned long get_flushed_elements() const;
+
+  private:
+
+    /**
+     * Appends the source elements of all pending changes to the request.
+     *
+     * @param     requester       The requester encoding the elements.
+     *
+     * @param     request         The request the elements are appended to.
+     */
+    void write_elements(const SSR::SSR_requester& requester, std::string& request);
+
+  private:
+
+    /**
+     * The merged changes, one entry per source that ever changed.
+     */
+    std::vector<Outbound_update> entries;
+
+    /**
+     * Maps a source id to its index in entries.
+     */
+    std::unordered_map<unsigned int, std::size_t> entry_index;
+
+    /**
+     * Indices of the entries with pending changes in the order they became
+     * dirty.
+     */
+    std::vector<std::size_t> dirty_entries;
+
+    /**
+     * Pending new source requests.
+     */
+    std::vector<Outbound_update> new_sources;
+
+    /**
+     * Number of updates added.
+     */
+    unsigned long added_updates;
+
+    /**
+     * Number of source elements flushed.
+     */
+    unsigned long flushed_elements;
+
+  };
+
+}
+
+#endif
@@ -12,18 +12,42 @@
 
 #include <src/utils/update_specificator.h>
 
+SSR::Update_specificator::Update_specificator()
+{
+
+}
+
 SSR::Update_specificator::Update_specificator(Specificators specificator)
-: specificator(specificator)
 {
+  specificators.set(specificator);
+}
+
+void SSR::Update_specificator::add(Specificators specificator)
+{
+  specificators.set(specificator);
+}
 
+void SSR::Update_specificator::remove(Specificators specificator)
+{
+  specificators.reset(specificator);
 }
 
-SSR::Update_specificator::~Update_specificator()
+void SSR::Update_specificator::add(const Update_specificator& other)
 {
+  specificators |= other.specificators;
+}
 
+bool SSR::Update_specificator::contains(Specificators specificator) const
+{
+  return specificators.test(specificator);
+}
+
+bool SSR::Update_specificator::empty() const
+{
+  return specificators.none();
 }
 
-SSR::Update_specificator::Specificators SSR::Update_specificator::get_spec() const
+void SSR::Update_specificator::clear()
 {
-  return specificator;
+  specificators.reset();
 }
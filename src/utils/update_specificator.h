@@ -13,11 +13,16 @@
  * For more detailed information, please read the license.txt in the root directory.
  */
 
+//C++ Libs
+#include <bitset>
+
 namespace SSR
 {
 
   /**
-   * This class helps to specify which parameter has to be updated by the SSR.
+   * This class helps to specify which parameters have to be updated by the
+   * SSR. It is a set of specificators, so several parameters of one source
+   * can be specified by one object.
    */
   class Update_specificator
   {
@@ -46,33 +51,70 @@ namespace SSR
       properties_file,
       port,
       name,
-      new_source
+      new_source,
+      specificator_count
     };
 
     /**
-     * Constructor setting the member specificator to the transferred
-     * specificator.
+     * Constructor creating an empty set of specificators.
+     */
+    Update_specificator();
+
+    /**
+     * Constructor creating a set containing the transferred specificator.
+     *
+     * @param     specificator    The specificator the set shall contain.
      */
     Update_specificator(Specificators specificator);
 
     /**
-     * Destructor.
+     * Adds the transferred specificator to this set.
+     *
+     * @param     specificator    The specificator which shall be added.
+     */
+    void add(Specificators specificator);
+
+    /**
+     * Adds all specificators of the transferred set to this set.
+     *
+     * @param     other           The set which shall be merged into this one.
+     */
+    void add(const Update_specificator& other);
+
+    /**
+     * Removes the transferred specificator from this set.
+     *
+     * @param     specificator    The specificator which shall be removed.
      */
-    ~Update_specificator();
+    void remove(Specificators specificator);
 
     /**
-     * Returns the specificator which has be set during construction.
+     * Returns true if this set contains the transferred specificator.
      *
-     * @see Specificators
+     * @param     specificator    The specificator to look for.
+     *
+     * @return true if this set contains the transferred specificator.
+     */
+    bool contains(Specificators specificator) const;
+
+    /**
+     * Returns true if this set does not contain any specificator.
+     *
+     * @return true if this set does not contain any specificator.
+     */
+    bool empty() const;
+
+    /**
+     * Removes all specificators from this set.
      */
-    Specificators get_spec() const;
+    void clear();
 
   private:
 
     /**
-     * The specificator.
+     * One bit per specificator.
      */
-    Specificators specificator;
+    std::bitset<specificator_count> specificators;
 
   };
 